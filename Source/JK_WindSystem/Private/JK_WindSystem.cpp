@@ -2,6 +2,7 @@
 
 #include "JK_WindSystem.h"
 #include "Interfaces/IPluginManager.h"
+#include "WindWorkerPool.h"
 #define LOCTEXT_NAMESPACE "FJK_WindSystemModule"
 
 void FJK_WindSystemModule::StartupModule()
@@ -15,6 +16,7 @@ void FJK_WindSystemModule::ShutdownModule()
 {
 	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
 	// we call this function before unloading the module.
+	FWindWorkerPool::Get().Shutdown();
 }
 
 #undef LOCTEXT_NAMESPACE
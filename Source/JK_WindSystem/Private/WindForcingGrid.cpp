@@ -0,0 +1,126 @@
+#include "WindForcingGrid.h"
+
+void FWindForcingGrid::Initialize(const FVector& InOrigin, const FIntVector& InDimensions, const FVector& InCellSpacing)
+{
+    Origin = InOrigin;
+    Dimensions = FIntVector(FMath::Max(InDimensions.X, 0), FMath::Max(InDimensions.Y, 0), FMath::Max(InDimensions.Z, 0));
+    CellSpacing = InCellSpacing.ComponentMax(FVector(UE_KINDA_SMALL_NUMBER));
+
+    const int32 NumNodes = Dimensions.X * Dimensions.Y * Dimensions.Z;
+    if (Velocity.Num() == NumNodes)
+    {
+        Reset();
+        return;
+    }
+
+    Velocity.SetNumZeroed(NumNodes);
+    ClearDirty();
+}
+
+void FWindForcingGrid::Reset()
+{
+    // Only the written range can be non-zero
+    for (int32 Z = DirtyMin.Z; Z <= DirtyMax.Z; Z++)
+    {
+        for (int32 Y = DirtyMin.Y; Y <= DirtyMax.Y; Y++)
+        {
+            FMemory::Memzero(&Velocity[GetIndex(DirtyMin.X, Y, Z)], (DirtyMax.X - DirtyMin.X + 1) * sizeof(FVector));
+        }
+    }
+    ClearDirty();
+}
+
+bool FWindForcingGrid::GetNodeRange(const FBox& Bounds, FIntVector& OutMin, FIntVector& OutMax) const
+{
+    if (!IsValid() || !Bounds.IsValid)
+    {
+        return false;
+    }
+
+    const FVector GridMin = (Bounds.Min - Origin) / CellSpacing;
+    const FVector GridMax = (Bounds.Max - Origin) / CellSpacing;
+    for (int32 Axis = 0; Axis < 3; Axis++)
+    {
+        OutMin[Axis] = FMath::Max(FMath::FloorToInt32(GridMin[Axis]), 0);
+        OutMax[Axis] = FMath::Min(FMath::CeilToInt32(GridMax[Axis]), Dimensions[Axis] - 1);
+        if (OutMin[Axis] > OutMax[Axis])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void FWindForcingGrid::AddNode(int32 X, int32 Y, int32 Z, const FVector& Value)
+{
+    Velocity[GetIndex(X, Y, Z)] += Value;
+    MarkDirty(X, Y, Z);
+}
+
+void FWindForcingGrid::SplatTrilinear(const FVector& WorldPosition, const FVector& Value)
+{
+    const FVector GridPosition = (WorldPosition - Origin) / CellSpacing;
+    const int32 X0 = FMath::FloorToInt32(GridPosition.X);
+    const int32 Y0 = FMath::FloorToInt32(GridPosition.Y);
+    const int32 Z0 = FMath::FloorToInt32(GridPosition.Z);
+    const FVector Fraction = GridPosition - FVector(X0, Y0, Z0);
+
+    for (int32 Corner = 0; Corner < 8; Corner++)
+    {
+        const int32 DX = Corner & 1;
+        const int32 DY = (Corner >> 1) & 1;
+        const int32 DZ = (Corner >> 2) & 1;
+        const int32 X = X0 + DX;
+        const int32 Y = Y0 + DY;
+        const int32 Z = Z0 + DZ;
+        if (X < 0 || Y < 0 || Z < 0 || X >= Dimensions.X || Y >= Dimensions.Y || Z >= Dimensions.Z)
+        {
+            continue;
+        }
+
+        const double Weight =
+            (DX ? Fraction.X : 1.0 - Fraction.X) *
+            (DY ? Fraction.Y : 1.0 - Fraction.Y) *
+            (DZ ? Fraction.Z : 1.0 - Fraction.Z);
+        if (Weight > 0.0)
+        {
+            AddNode(X, Y, Z, Value * Weight);
+        }
+    }
+}
+
+void FWindForcingGrid::Accumulate(const FWindForcingGrid& Other)
+{
+    if (Other.IsEmpty() || Other.Dimensions != Dimensions)
+    {
+        return;
+    }
+
+    for (int32 Z = Other.DirtyMin.Z; Z <= Other.DirtyMax.Z; Z++)
+    {
+        for (int32 Y = Other.DirtyMin.Y; Y <= Other.DirtyMax.Y; Y++)
+        {
+            const int32 Begin = GetIndex(Other.DirtyMin.X, Y, Z);
+            const int32 End = GetIndex(Other.DirtyMax.X, Y, Z);
+            for (int32 Index = Begin; Index <= End; Index++)
+            {
+                Velocity[Index] += Other.Velocity[Index];
+            }
+        }
+    }
+
+    MarkDirty(Other.DirtyMin.X, Other.DirtyMin.Y, Other.DirtyMin.Z);
+    MarkDirty(Other.DirtyMax.X, Other.DirtyMax.Y, Other.DirtyMax.Z);
+}
+
+void FWindForcingGrid::MarkDirty(int32 X, int32 Y, int32 Z)
+{
+    DirtyMin = FIntVector(FMath::Min(DirtyMin.X, X), FMath::Min(DirtyMin.Y, Y), FMath::Min(DirtyMin.Z, Z));
+    DirtyMax = FIntVector(FMath::Max(DirtyMax.X, X), FMath::Max(DirtyMax.Y, Y), FMath::Max(DirtyMax.Z, Z));
+}
+
+void FWindForcingGrid::ClearDirty()
+{
+    DirtyMin = FIntVector(MAX_int32);
+    DirtyMax = FIntVector(MIN_int32);
+}
@@ -12,3 +12,111 @@ FVector UWindSimulationFunctionLibrary::GetWindVelocityAtLocation(const UObject*
     }
     return FVector::ZeroVector;
 }
+
+void UWindSimulationFunctionLibrary::GetWindVelocitiesAtLocations(const UObject* WorldContextObject, const TArray<FVector>& WorldLocations, TArray<FVector>& OutVelocities)
+{
+    OutVelocities.SetNumUninitialized(WorldLocations.Num());
+    if (UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull))
+    {
+        if (UWindSimulationSubsystem* WindSubsystem = World->GetSubsystem<UWindSimulationSubsystem>())
+        {
+            WindSubsystem->GetWindVelocitiesAtLocations(WorldLocations, OutVelocities);
+            return;
+        }
+    }
+
+    for (FVector& Velocity : OutVelocities)
+    {
+        Velocity = FVector::ZeroVector;
+    }
+}
+
+FVector UWindSimulationFunctionLibrary::GetWindVelocityAtLocationLod(const UObject* WorldContextObject, const FVector& WorldLocation, float Footprint)
+{
+    if (UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull))
+    {
+        if (UWindSimulationSubsystem* WindSubsystem = World->GetSubsystem<UWindSimulationSubsystem>())
+        {
+            return WindSubsystem->GetWindVelocityAtLocationLod(WorldLocation, Footprint);
+        }
+    }
+    return FVector::ZeroVector;
+}
+
+FVector UWindSimulationFunctionLibrary::GetAverageWindInBox(const UObject* WorldContextObject, const FBox& Box)
+{
+    if (UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull))
+    {
+        if (UWindSimulationSubsystem* WindSubsystem = World->GetSubsystem<UWindSimulationSubsystem>())
+        {
+            return WindSubsystem->GetAverageWindInBox(Box);
+        }
+    }
+    return FVector::ZeroVector;
+}
+
+FWindVelocityDerivatives UWindSimulationFunctionLibrary::GetWindDerivativesAtLocation(const UObject* WorldContextObject, const FVector& WorldLocation)
+{
+    if (UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull))
+    {
+        if (UWindSimulationSubsystem* WindSubsystem = World->GetSubsystem<UWindSimulationSubsystem>())
+        {
+            return WindSubsystem->GetWindDerivativesAtLocation(WorldLocation);
+        }
+    }
+    return FWindVelocityDerivatives();
+}
+
+void UWindSimulationFunctionLibrary::TraceWindStreamlines(const UObject* WorldContextObject, const TArray<FVector>& Seeds, const FWindTraceSettings& Settings, TArray<FWindTracePolyline>& OutPolylines)
+{
+    const int32 NumPoints = Settings.GetNumPoints();
+    TArray<FVector> Points;
+    Points.SetNumUninitialized(Seeds.Num() * NumPoints);
+    for (int32 Index = 0; Index < Points.Num(); Index++)
+    {
+        Points[Index] = Seeds[Index / NumPoints];
+    }
+
+    if (UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull))
+    {
+        if (UWindSimulationSubsystem* WindSubsystem = World->GetSubsystem<UWindSimulationSubsystem>())
+        {
+            WindSubsystem->TraceWindStreamlines(Seeds, Settings, Points);
+        }
+    }
+    FWindStreamlineTracer::ToPolylines(Points, NumPoints, OutPolylines);
+}
+
+FWindQueryHandle UWindSimulationFunctionLibrary::RegisterWindQuery(const UObject* WorldContextObject, const USceneComponent* Component)
+{
+    if (UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull))
+    {
+        if (UWindSimulationSubsystem* WindSubsystem = World->GetSubsystem<UWindSimulationSubsystem>())
+        {
+            return WindSubsystem->RegisterWindQuery(Component);
+        }
+    }
+    return FWindQueryHandle();
+}
+
+void UWindSimulationFunctionLibrary::UnregisterWindQuery(const UObject* WorldContextObject, FWindQueryHandle& Handle)
+{
+    if (UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull))
+    {
+        if (UWindSimulationSubsystem* WindSubsystem = World->GetSubsystem<UWindSimulationSubsystem>())
+        {
+            WindSubsystem->UnregisterWindQuery(Handle);
+            return;
+        }
+    }
+    Handle.Invalidate();
+}
+
+FVector UWindSimulationFunctionLibrary::GetQueriedWindVelocity(const FWindQueryHandle& Handle)
+{
+    if (const UWindSimulationSubsystem* WindSubsystem = Handle.Subsystem.Get())
+    {
+        return WindSubsystem->GetQueriedWindVelocity(Handle);
+    }
+    return FVector::ZeroVector;
+}
@@ -0,0 +1,98 @@
+#include "WindInjectionQueue.h"
+#include "WindForcingGrid.h"
+
+FWindInjectionQueue::FWindInjectionQueue()
+    : Head(nullptr)
+{
+}
+
+FWindInjectionQueue::~FWindInjectionQueue()
+{
+    FNode* Node = Head.exchange(nullptr, std::memory_order_acquire);
+    while (Node)
+    {
+        FNode* Next = Node->Next;
+        delete Node;
+        Node = Next;
+    }
+}
+
+void FWindInjectionQueue::Push(const FVector& Location, const FVector& Velocity)
+{
+    FNode* Node = new FNode();
+    Node->Injection.Location = Location;
+    Node->Injection.Velocity = Velocity;
+    PushNode(Node);
+}
+
+void FWindInjectionQueue::Push(TSharedPtr<const FWindForcingGrid> Field)
+{
+    FNode* Node = new FNode();
+    Node->Field = MoveTemp(Field);
+    PushNode(Node);
+}
+
+void FWindInjectionQueue::PushBatch(TArray<FWindInjection> Injections)
+{
+    if (Injections.Num() == 0)
+    {
+        return;
+    }
+
+    FNode* Node = new FNode();
+    Node->Batch = MoveTemp(Injections);
+    PushNode(Node);
+}
+
+void FWindInjectionQueue::PushNode(FNode* Node)
+{
+    // The consumer only ever takes the whole list, so nodes are never popped individually and
+    // this push cannot suffer from ABA
+    FNode* Expected = Head.load(std::memory_order_relaxed);
+    do
+    {
+        Node->Next = Expected;
+    }
+    while (!Head.compare_exchange_weak(Expected, Node, std::memory_order_release, std::memory_order_relaxed));
+}
+
+void FWindInjectionQueue::Drain(TArray<FWindInjection>& OutInjections, TArray<TSharedPtr<const FWindForcingGrid>>& OutFields)
+{
+    FNode* Node = Head.exchange(nullptr, std::memory_order_acquire);
+    if (!Node)
+    {
+        return;
+    }
+
+    // The list is newest first; reverse it in place so injections come out in push order
+    FNode* Reversed = nullptr;
+    int32 NumInjections = 0;
+    while (Node)
+    {
+        FNode* Next = Node->Next;
+        Node->Next = Reversed;
+        Reversed = Node;
+        Node = Next;
+        NumInjections += FMath::Max(Reversed->Batch.Num(), 1);
+    }
+
+    OutInjections.Reserve(OutInjections.Num() + NumInjections);
+    while (Reversed)
+    {
+        FNode* Next = Reversed->Next;
+        if (Reversed->Field.IsValid())
+        {
+            OutFields.Add(MoveTemp(Reversed->Field));
+        }
+        else if (Reversed->Batch.Num() > 0)
+        {
+            OutInjections.Append(Reversed->Batch);
+        }
+        else
+        {
+            OutInjections.Add(Reversed->Injection);
+        }
+        delete Reversed;
+        Reversed = Next;
+    }
+}
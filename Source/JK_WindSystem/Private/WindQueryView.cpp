@@ -0,0 +1,248 @@
+#include "WindQueryView.h"
+#include "Async/ParallelFor.h"
+#include "HAL/PlatformTime.h"
+#include "WindZoneMask.h"
+
+namespace WindQueryConstants
+{
+    // Batches at least this large are split across task graph workers in chunks of QueryChunkSize
+    const int32 MinParallelQueries = 4096;
+    const int32 QueryChunkSize = 1024;
+}
+
+namespace WindQuery
+{
+    // Runs Body over [Begin, End) ranges covering NumQueries, split across task graph workers for
+    // large batches
+    void ForEachChunk(int32 NumQueries, TFunctionRef<void(int32, int32)> Body)
+    {
+        if (NumQueries < WindQueryConstants::MinParallelQueries)
+        {
+            Body(0, NumQueries);
+            return;
+        }
+
+        const int32 NumChunks = FMath::DivideAndRoundUp(NumQueries, WindQueryConstants::QueryChunkSize);
+        ParallelFor(NumChunks, [NumQueries, Body](int32 Chunk)
+        {
+            const int32 Begin = Chunk * WindQueryConstants::QueryChunkSize;
+            Body(Begin, FMath::Min(Begin + WindQueryConstants::QueryChunkSize, NumQueries));
+        });
+    }
+
+    template<typename T>
+    void Fill(TArrayView<T> Out, int32 Num, const T& Value)
+    {
+        for (int32 Index = 0; Index < Num; Index++)
+        {
+            Out[Index] = Value;
+        }
+    }
+}
+
+FVector FWindQueryTurbulence::Sample(const FWindSnapshot& Snapshot, const FVector& GridPosition, float Time) const
+{
+    if (!IsEnabled())
+    {
+        return FVector::ZeroVector;
+    }
+
+    const float Energy = Snapshot.GetTurbulenceEnergy(GridPosition);
+    if (Energy <= 0.0f)
+    {
+        return FVector::ZeroVector;
+    }
+
+    // Flutter scales with the local resolved speed, reaching Strength at GlobalWindStrength
+    const float ReferenceSpeed = FMath::Max(GlobalWindStrength, 1.0f);
+    const float Amplitude = Strength * FMath::Sqrt(2.0f * Energy) / ReferenceSpeed;
+
+    // Scroll the noise with the global wind so the detail drifts downwind instead of standing still
+    const FVector Drift = GlobalWindDirection.GetSafeNormal() * GlobalWindStrength * Time / Snapshot.CellSpacing.X;
+    const FVector TilePosition = (GridPosition - Drift) * Frequency;
+
+    return Field->Sample(TilePosition) * Amplitude;
+}
+
+FWindQueryView::FWindQueryView(TRefCountPtr<FWindSnapshot> InSnapshot, const FWindQueryTurbulence& InTurbulence, EWindTemporalSampling InTemporalSampling)
+    : Snapshot(MoveTemp(InSnapshot))
+    , Turbulence(InTurbulence)
+    , TemporalSampling(InTemporalSampling)
+{
+}
+
+float FWindQueryView::GetTemporalAlpha() const
+{
+    return Snapshot->GetTemporalAlpha(TemporalSampling, FPlatformTime::Seconds());
+}
+
+FVector FWindQueryView::GetWindVelocityAtLocation(const FVector& Location) const
+{
+    if (!Snapshot.IsValid())
+    {
+        return FVector::ZeroVector;
+    }
+
+    const float Alpha = GetTemporalAlpha();
+    const FVector GridPos = (Location - Snapshot->Origin) / Snapshot->CellSpacing;
+
+    const FVector Velocity = Snapshot->SampleBlendedVelocity(Location, Alpha) + Turbulence.Sample(*Snapshot, GridPos, Snapshot->GetBlendedSimulationTime(Alpha));
+    return ApplyZones(Location, Velocity);
+}
+
+FVector FWindQueryView::ApplyZones(const FVector& Location, const FVector& Velocity) const
+{
+    const FWindZoneMask* Mask = Snapshot->ZoneMask.Get();
+    const int32 Cell = Mask ? Mask->GetCellAt(Location) : INDEX_NONE;
+    if (Cell != INDEX_NONE)
+    {
+        return Mask->ApplyToCell(Cell, Velocity);
+    }
+    return OuterZones.IsValid() ? OuterZones->ApplyZones(Location, Velocity) : Velocity;
+}
+
+bool FWindQueryView::HasZones() const
+{
+    return Snapshot->ZoneMask.IsValid() || OuterZones.IsValid();
+}
+
+void FWindQueryView::GetWindVelocitiesAtLocations(TConstArrayView<FVector> Locations, TArrayView<FVector> OutVelocities) const
+{
+    check(OutVelocities.Num() >= Locations.Num());
+    SampleWindVelocities(Locations, OutVelocities, 0.0f);
+}
+
+FVector FWindQueryView::GetWindVelocityAtLocationLod(const FVector& Location, float Footprint) const
+{
+    FVector Velocity;
+    GetWindVelocitiesAtLocationsLod(MakeArrayView(&Location, 1), Footprint, MakeArrayView(&Velocity, 1));
+    return Velocity;
+}
+
+void FWindQueryView::GetWindVelocitiesAtLocationsLod(TConstArrayView<FVector> Locations, float Footprint, TArrayView<FVector> OutVelocities) const
+{
+    check(OutVelocities.Num() >= Locations.Num());
+    SampleWindVelocities(Locations, OutVelocities, Snapshot.IsValid() ? Snapshot->GetLodForFootprint(Footprint) : 0.0f);
+}
+
+FVector FWindQueryView::GetAverageWindInBox(const FBox& Box) const
+{
+    if (!Snapshot.IsValid())
+    {
+        return FVector::ZeroVector;
+    }
+    return Snapshot->GetBlendedAverageVelocity(Box, GetTemporalAlpha());
+}
+
+FWindVelocityDerivatives FWindQueryView::GetWindDerivativesAtLocation(const FVector& Location) const
+{
+    FWindVelocityDerivatives Derivatives;
+    GetWindDerivativesAtLocations(MakeArrayView(&Location, 1), MakeArrayView(&Derivatives, 1));
+    return Derivatives;
+}
+
+void FWindQueryView::GetWindDerivativesAtLocations(TConstArrayView<FVector> Locations, TArrayView<FWindVelocityDerivatives> OutDerivatives) const
+{
+    check(OutDerivatives.Num() >= Locations.Num());
+    if (!Snapshot.IsValid())
+    {
+        WindQuery::Fill(OutDerivatives, Locations.Num(), FWindVelocityDerivatives());
+        return;
+    }
+
+    const float Alpha = GetTemporalAlpha();
+    WindQuery::ForEachChunk(Locations.Num(), [&](int32 Begin, int32 End)
+    {
+        Snapshot->SampleBlendedDerivatives(Locations.Slice(Begin, End - Begin), OutDerivatives.Slice(Begin, End - Begin), Alpha);
+
+        // A zone's effect on a velocity is linear, so the derivatives go through it too
+        if (HasZones())
+        {
+            for (int32 Index = Begin; Index < End; Index++)
+            {
+                const FVector& Location = Locations[Index];
+                FWindVelocityDerivatives& Derivatives = OutDerivatives[Index];
+                const FVector AlongX = ApplyZones(Location, Derivatives.GetDerivative(0));
+                const FVector AlongY = ApplyZones(Location, Derivatives.GetDerivative(1));
+                const FVector AlongZ = ApplyZones(Location, Derivatives.GetDerivative(2));
+                Derivatives.Velocity = ApplyZones(Location, Derivatives.Velocity);
+                Derivatives.SetDerivatives(AlongX, AlongY, AlongZ, Snapshot->CellSpacing);
+            }
+        }
+    });
+}
+
+void FWindQueryView::TraceWindStreamlines(TConstArrayView<FVector> Seeds, const FWindTraceSettings& Settings, TArrayView<FVector> OutPoints) const
+{
+    check(OutPoints.Num() >= Seeds.Num() * Settings.GetNumPoints());
+
+    // Every stage of every seed reads the same snapshot and temporal blend
+    const float Alpha = Snapshot.IsValid() ? GetTemporalAlpha() : 1.0f;
+    const FWindSnapshot* Field = Snapshot.GetReference();
+
+    FWindStreamlineTracer::Trace(Seeds, Settings, [this, Field, Alpha](TConstArrayView<FVector> Positions, TArrayView<FVector> OutVelocities)
+    {
+        if (!Field)
+        {
+            WindQuery::Fill(OutVelocities, Positions.Num(), FVector::ZeroVector);
+            return;
+        }
+
+        Field->SampleBlendedVelocities(Positions, OutVelocities, Alpha);
+        if (HasZones())
+        {
+            for (int32 Index = 0; Index < Positions.Num(); Index++)
+            {
+                OutVelocities[Index] = ApplyZones(Positions[Index], OutVelocities[Index]);
+            }
+        }
+    }, OutPoints);
+}
+
+void FWindQueryView::SampleWindVelocities(TConstArrayView<FVector> Locations, TArrayView<FVector> OutVelocities, float Lod) const
+{
+    if (!Snapshot.IsValid())
+    {
+        WindQuery::Fill(OutVelocities, Locations.Num(), FVector::ZeroVector);
+        return;
+    }
+
+    const FWindSnapshot& Field = *Snapshot;
+    const float Alpha = GetTemporalAlpha();
+    const float Time = Field.GetBlendedSimulationTime(Alpha);
+
+    // Turbulence is detail below one cell, so it fades out over the first mip level
+    const float TurbulenceScale = FMath::Max(1.0f - Lod, 0.0f);
+    const bool bTurbulence = TurbulenceScale > 0.0f && Turbulence.IsEnabled();
+
+    auto SampleChunk = [&](int32 Begin, int32 End)
+    {
+        if (Lod > 0.0f)
+        {
+            Field.SampleBlendedVelocitiesLod(Locations.Slice(Begin, End - Begin), OutVelocities.Slice(Begin, End - Begin), Lod, Alpha);
+        }
+        else
+        {
+            Field.SampleBlendedVelocities(Locations.Slice(Begin, End - Begin), OutVelocities.Slice(Begin, End - Begin), Alpha);
+        }
+        if (bTurbulence)
+        {
+            for (int32 Index = Begin; Index < End; Index++)
+            {
+                const FVector GridPos = (Locations[Index] - Field.Origin) / Field.CellSpacing;
+                OutVelocities[Index] += Turbulence.Sample(Field, GridPos, Time) * TurbulenceScale;
+            }
+        }
+
+        if (!HasZones())
+        {
+            return;
+        }
+        for (int32 Index = Begin; Index < End; Index++)
+        {
+            OutVelocities[Index] = ApplyZones(Locations[Index], OutVelocities[Index]);
+        }
+    };
+
+    WindQuery::ForEachChunk(Locations.Num(), SampleChunk);
+}
@@ -0,0 +1,345 @@
+#include "WindSimulationScheduler.h"
+#include "WindSystemSettings.h"
+#include "WindSystemLog.h"
+#include "WindWorkerPool.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/ScopeLock.h"
+
+namespace WindScheduler
+{
+    // Steps a single Advance may run to catch up. Anything beyond is dropped so a long hitch cannot
+    // snowball into ever longer frames.
+    const int32 MaxCatchUpSteps = 4;
+}
+
+FWindSimulationScheduler::FWindSimulationScheduler()
+    : Mode(EWindSchedulerMode::GameThread)
+    , FixedStep(1.0f / 60.0f)
+    , Accumulator(0.0)
+    , PoolDomain(INDEX_NONE)
+    , PoolPriority(0)
+    , PoolCpuBudget(0.0f)
+    , bPaused(false)
+    , NumBackgroundSteps(0)
+    , SliceBudgetSeconds(0.002)
+    , FramesPerSlicedStep(4)
+    , bSlicedStepInFlight(false)
+    , SlicedStepFrames(0)
+    , SlicedStepStartTime(0.0)
+    , SlicedStepWorkTime(0.0)
+{
+    ResetStats();
+}
+
+FWindSimulationScheduler::~FWindSimulationScheduler()
+{
+    Shutdown();
+}
+
+void FWindSimulationScheduler::Configure(EWindSchedulerMode InMode, float InFixedStep, TFunction<void(float)> InStepFunction)
+{
+    Shutdown();
+
+    Mode = InMode;
+    FixedStep = FMath::Max(InFixedStep, KINDA_SMALL_NUMBER);
+    StepFunction = MoveTemp(InStepFunction);
+    Accumulator = 0.0;
+    bSlicedStepInFlight = false;
+    ResetStats();
+}
+
+void FWindSimulationScheduler::ConfigureTimeSlicing(FWindSlicedStepFunctions InSlicedStep, float InBudgetMs, int32 InFramesPerStep)
+{
+    SlicedStep = MoveTemp(InSlicedStep);
+    SliceBudgetSeconds = FMath::Max(InBudgetMs, 0.0f) / 1000.0;
+    FramesPerSlicedStep = FMath::Max(InFramesPerStep, 1);
+    bSlicedStepInFlight = false;
+}
+
+void FWindSimulationScheduler::ConfigurePipeline(TFunction<void()> InSealInputs)
+{
+    SealInputs = MoveTemp(InSealInputs);
+}
+
+void FWindSimulationScheduler::ConfigurePool(int32 InPriority, float InCpuBudget)
+{
+    PoolPriority = InPriority;
+    PoolCpuBudget = FMath::Max(InCpuBudget, 0.0f);
+}
+
+float FWindSimulationScheduler::GetStepProgress() const
+{
+    return bSlicedStepInFlight && SlicedStep.GetProgress ? SlicedStep.GetProgress() : 1.0f;
+}
+
+void FWindSimulationScheduler::Start()
+{
+    if (Mode == EWindSchedulerMode::DedicatedThread || Mode == EWindSchedulerMode::TaskGraph || Mode == EWindSchedulerMode::Pipelined)
+    {
+        JoinPool();
+    }
+}
+
+void FWindSimulationScheduler::JoinPool()
+{
+    if (PoolDomain != INDEX_NONE)
+    {
+        return;
+    }
+
+    // Background modes run their batches on the pool too, so its thread count caps every mode
+    FWindPoolDomainDesc Desc;
+    Desc.FixedStep = FixedStep;
+    Desc.Priority = PoolPriority;
+    Desc.CpuBudget = PoolCpuBudget;
+    Desc.bOnDemand = Mode != EWindSchedulerMode::DedicatedThread;
+    if (Desc.bOnDemand)
+    {
+        Desc.StepFunction = [this]() { ExecuteBackgroundSteps(); };
+    }
+    else
+    {
+        Desc.StepFunction = [this]() { ExecuteStep(); };
+    }
+    Desc.OnDroppedSteps = [this](int32 Count) { AddDroppedSteps(Count); };
+    PoolDomain = FWindWorkerPool::Get().AddDomain(MoveTemp(Desc));
+
+    if (bPaused)
+    {
+        FWindWorkerPool::Get().SetDomainPaused(PoolDomain, true);
+    }
+}
+
+void FWindSimulationScheduler::Shutdown()
+{
+    if (PoolDomain != INDEX_NONE)
+    {
+        FWindWorkerPool::Get().RemoveDomain(PoolDomain);
+        PoolDomain = INDEX_NONE;
+    }
+
+    // Once the domain is gone nothing can run the batch any more
+    if (bBackgroundStepInFlight.exchange(false))
+    {
+        AddDroppedSteps(NumBackgroundSteps);
+    }
+}
+
+void FWindSimulationScheduler::Advance(float DeltaTime, bool bInPaused)
+{
+    if (PoolDomain != INDEX_NONE && bPaused != bInPaused)
+    {
+        FWindWorkerPool::Get().SetDomainPaused(PoolDomain, bInPaused);
+    }
+    bPaused = bInPaused;
+
+    if (bInPaused)
+    {
+        // Paused time is neither simulated later nor counted as jitter
+        FScopeLock Lock(&StatsLock);
+        LastStepStartTime = 0.0;
+        return;
+    }
+
+    // The worker pool keeps its own clock and only needs the pause state
+    if (Mode == EWindSchedulerMode::DedicatedThread && PoolDomain != INDEX_NONE)
+    {
+        return;
+    }
+
+    Accumulator += FMath::Max(DeltaTime, 0.0f);
+
+    if (Mode == EWindSchedulerMode::TimeSliced && SlicedStep.BeginStep && SlicedStep.StepSlice)
+    {
+        AdvanceTimeSliced();
+        return;
+    }
+
+    if (Mode == EWindSchedulerMode::TaskGraph || Mode == EWindSchedulerMode::Pipelined)
+    {
+        AdvanceBackground();
+        return;
+    }
+
+    const double StartTime = FPlatformTime::Seconds();
+    const int32 NumDue = ConsumeDueSteps();
+    for (int32 Index = 0; Index < NumDue; Index++)
+    {
+        ExecuteStep();
+    }
+    RecordAdvance(FPlatformTime::Seconds() - StartTime);
+}
+
+void FWindSimulationScheduler::AdvanceBackground()
+{
+    // Keep accumulating while the previous batch is in flight; its steps are picked up next frame
+    if (bBackgroundStepInFlight.load())
+    {
+        return;
+    }
+
+    const double StartTime = FPlatformTime::Seconds();
+    const int32 NumDue = ConsumeDueSteps();
+    if (NumDue == 0)
+    {
+        return;
+    }
+
+    // Everything gathered up to here belongs to this batch; what the game thread gathers while it
+    // runs goes to the next one
+    if (Mode == EWindSchedulerMode::Pipelined && SealInputs)
+    {
+        SealInputs();
+    }
+
+    JoinPool();
+    NumBackgroundSteps = NumDue;
+    bBackgroundStepInFlight = true;
+    FWindWorkerPool::Get().RequestStep(PoolDomain);
+    RecordAdvance(FPlatformTime::Seconds() - StartTime);
+}
+
+void FWindSimulationScheduler::ExecuteBackgroundSteps()
+{
+    for (int32 Index = 0; Index < NumBackgroundSteps; Index++)
+    {
+        ExecuteStep();
+    }
+    bBackgroundStepInFlight = false;
+}
+
+void FWindSimulationScheduler::AdvanceTimeSliced()
+{
+    const double FrameStartTime = FPlatformTime::Seconds();
+
+    if (!bSlicedStepInFlight && Accumulator >= FixedStep)
+    {
+        // Only one step can be in flight, so any backlog beyond the catch-up limit is dropped
+        const int32 NumBacklog = FMath::FloorToInt32(Accumulator / FixedStep) - 1;
+        if (NumBacklog >= WindScheduler::MaxCatchUpSteps)
+        {
+            AddDroppedSteps(NumBacklog);
+            Accumulator -= NumBacklog * static_cast<double>(FixedStep);
+        }
+        Accumulator -= FixedStep;
+
+        SlicedStep.BeginStep(FixedStep);
+        bSlicedStepInFlight = true;
+        SlicedStepFrames = 0;
+        SlicedStepStartTime = FrameStartTime;
+        SlicedStepWorkTime = 0.0;
+    }
+
+    if (!bSlicedStepInFlight)
+    {
+        return;
+    }
+
+    // Run slices until the frame budget is spent, but never fall behind finishing the step within
+    // FramesPerSlicedStep frames
+    SlicedStepFrames++;
+    const float TargetProgress = FMath::Min(static_cast<float>(SlicedStepFrames) / FramesPerSlicedStep, 1.0f);
+    bool bComplete = false;
+    do
+    {
+        bComplete = SlicedStep.StepSlice();
+    }
+    while (!bComplete && (FPlatformTime::Seconds() - FrameStartTime < SliceBudgetSeconds || (SlicedStep.GetProgress && SlicedStep.GetProgress() < TargetProgress)));
+
+    const double FrameWorkTime = FPlatformTime::Seconds() - FrameStartTime;
+    SlicedStepWorkTime += FrameWorkTime;
+    RecordAdvance(FrameWorkTime);
+
+    if (bComplete)
+    {
+        bSlicedStepInFlight = false;
+        RecordStep(SlicedStepStartTime, SlicedStepWorkTime);
+    }
+}
+
+int32 FWindSimulationScheduler::ConsumeDueSteps()
+{
+    int32 NumDue = FMath::FloorToInt32(Accumulator / FixedStep);
+    Accumulator -= NumDue * static_cast<double>(FixedStep);
+
+    if (NumDue > WindScheduler::MaxCatchUpSteps)
+    {
+        AddDroppedSteps(NumDue - WindScheduler::MaxCatchUpSteps);
+        NumDue = WindScheduler::MaxCatchUpSteps;
+    }
+    return NumDue;
+}
+
+void FWindSimulationScheduler::ExecuteStep()
+{
+    const double StartTime = FPlatformTime::Seconds();
+    if (StepFunction)
+    {
+        StepFunction(FixedStep);
+    }
+    RecordStep(StartTime, FPlatformTime::Seconds() - StartTime);
+}
+
+void FWindSimulationScheduler::RecordStep(double StartTime, double WorkTime)
+{
+    FScopeLock Lock(&StatsLock);
+    if (LastStepStartTime > 0.0)
+    {
+        const double Interval = StartTime - LastStepStartTime;
+        const double Deviation = Interval - FixedStep;
+        TotalInterval += Interval;
+        TotalSquaredDeviation += Deviation * Deviation;
+        MaxDeviation = FMath::Max(MaxDeviation, FMath::Abs(Deviation));
+        NumIntervals++;
+    }
+    LastStepStartTime = StartTime;
+    TotalStepTime += WorkTime;
+    NumSteps++;
+}
+
+void FWindSimulationScheduler::RecordAdvance(double AdvanceTime)
+{
+    FScopeLock Lock(&StatsLock);
+    MaxAdvanceTime = FMath::Max(MaxAdvanceTime, AdvanceTime);
+}
+
+void FWindSimulationScheduler::AddDroppedSteps(int32 Count)
+{
+    FScopeLock Lock(&StatsLock);
+    NumDroppedSteps += Count;
+}
+
+FWindSchedulerStats FWindSimulationScheduler::GetStats() const
+{
+    FScopeLock Lock(&StatsLock);
+
+    FWindSchedulerStats Stats;
+    Stats.NumSteps = NumSteps;
+    Stats.NumDroppedSteps = NumDroppedSteps;
+    if (NumSteps > 0)
+    {
+        Stats.AverageStepMs = TotalStepTime / NumSteps * 1000.0;
+    }
+    if (NumIntervals > 0)
+    {
+        Stats.AverageIntervalMs = TotalInterval / NumIntervals * 1000.0;
+        Stats.JitterMs = FMath::Sqrt(TotalSquaredDeviation / NumIntervals) * 1000.0;
+        Stats.MaxJitterMs = MaxDeviation * 1000.0;
+    }
+    Stats.MaxAdvanceMs = MaxAdvanceTime * 1000.0;
+    return Stats;
+}
+
+void FWindSimulationScheduler::ResetStats()
+{
+    FScopeLock Lock(&StatsLock);
+    LastStepStartTime = 0.0;
+    TotalStepTime = 0.0;
+    TotalInterval = 0.0;
+    TotalSquaredDeviation = 0.0;
+    MaxDeviation = 0.0;
+    NumIntervals = 0;
+    NumSteps = 0;
+    NumDroppedSteps = 0;
+    MaxAdvanceTime = 0.0;
+}
@@ -0,0 +1,675 @@
+#include "WindSnapshot.h"
+#include "WindSystemSettings.h"
+#include "WindVelocityDerivatives.h"
+#include "Misc/ScopeLock.h"
+#include "Math/VectorRegister.h"
+#include "WindTileGraph.h"
+
+namespace WindSnapshotConstants
+{
+    // Extrapolation stops one step past the latest state rather than running away during a hitch
+    const float MaxExtrapolationAlpha = 2.0f;
+    // Mip levels and summed volumes smaller than this are built on the calling thread
+    const int32 MinParallelNodes = 4096;
+}
+
+namespace WindSnapshotSampling
+{
+    // Trilinear sampling of one field with everything that only depends on the snapshot hoisted
+    // out of the per-point loop. Matches SampleField, including clamping to the edge nodes.
+    struct FBatchSampler
+    {
+        const FVector* Data;
+        VectorRegister4Double Origin;
+        VectorRegister4Double InvSpacing;
+        VectorRegister4Double MaxCoord;
+        FIntVector MaxNode;
+        int32 StrideY;
+        int32 StrideZ;
+
+        FBatchSampler(const TArray<FVector>& Field, const FVector& InOrigin, const FIntVector& Dimensions, const FVector& CellSpacing)
+            : Data(Field.GetData())
+            , Origin(VectorLoadFloat3_W0(&InOrigin.X))
+            , InvSpacing(MakeVectorRegisterDouble(1.0 / CellSpacing.X, 1.0 / CellSpacing.Y, 1.0 / CellSpacing.Z, 0.0))
+            , MaxCoord(MakeVectorRegisterDouble(Dimensions.X - 1.0, Dimensions.Y - 1.0, Dimensions.Z - 1.0, 0.0))
+            , MaxNode(Dimensions.X - 1, Dimensions.Y - 1, Dimensions.Z - 1)
+            , StrideY(Dimensions.X)
+            , StrideZ(Dimensions.X * Dimensions.Y)
+        {
+        }
+
+        FORCEINLINE VectorRegister4Double Sample(const FVector& WorldPosition) const
+        {
+            VectorRegister4Double Grid = VectorMultiply(VectorSubtract(VectorLoadFloat3_W0(&WorldPosition.X), Origin), InvSpacing);
+            Grid = VectorMin(VectorMax(Grid, VectorZeroDouble()), MaxCoord);
+
+            alignas(32) double Coord[4];
+            VectorStoreAligned(Grid, Coord);
+
+            // Non-negative after the clamp, so truncation is the floor
+            const int32 X0 = static_cast<int32>(Coord[0]);
+            const int32 Y0 = static_cast<int32>(Coord[1]);
+            const int32 Z0 = static_cast<int32>(Coord[2]);
+            const int32 DX = X0 < MaxNode.X ? 1 : 0;
+            const int32 DY = Y0 < MaxNode.Y ? StrideY : 0;
+            const int32 DZ = Z0 < MaxNode.Z ? StrideZ : 0;
+
+            const VectorRegister4Double Fraction = VectorSubtract(Grid, MakeVectorRegisterDouble(static_cast<double>(X0), static_cast<double>(Y0), static_cast<double>(Z0), 0.0));
+            const VectorRegister4Double Sx = VectorReplicate(Fraction, 0);
+            const VectorRegister4Double Sy = VectorReplicate(Fraction, 1);
+            const VectorRegister4Double Sz = VectorReplicate(Fraction, 2);
+
+            const FVector* Base = Data + X0 + Y0 * StrideY + Z0 * StrideZ;
+            auto Lerp = [](const VectorRegister4Double& A, const VectorRegister4Double& B, const VectorRegister4Double& T)
+            {
+                return VectorMultiplyAdd(VectorSubtract(B, A), T, A);
+            };
+
+            const VectorRegister4Double Lower = Lerp(
+                Lerp(VectorLoadFloat3_W0(&Base[0].X), VectorLoadFloat3_W0(&Base[DX].X), Sx),
+                Lerp(VectorLoadFloat3_W0(&Base[DY].X), VectorLoadFloat3_W0(&Base[DY + DX].X), Sx),
+                Sy);
+            const VectorRegister4Double Upper = Lerp(
+                Lerp(VectorLoadFloat3_W0(&Base[DZ].X), VectorLoadFloat3_W0(&Base[DZ + DX].X), Sx),
+                Lerp(VectorLoadFloat3_W0(&Base[DZ + DY].X), VectorLoadFloat3_W0(&Base[DZ + DY + DX].X), Sx),
+                Sy);
+            return Lerp(Lower, Upper, Sz);
+        }
+    };
+
+    // Velocity and its derivative along each world axis from one trilinear stencil. The stencil is
+    // the cell holding the position, so the derivatives stay one-sided rather than zero on the
+    // last node of an axis.
+    struct FGradientSample
+    {
+        FVector Velocity;
+        FVector Derivatives[3];
+    };
+
+    FGradientSample SampleGradient(const TArray<FVector>& Field, const FVector& Origin, const FIntVector& Dimensions, const FVector& CellSpacing, const FVector& WorldPosition)
+    {
+        const FVector Grid = (WorldPosition - Origin) / CellSpacing;
+        int32 Base[3];
+        double Fraction[3];
+        int32 Step[3];
+        for (int32 Axis = 0; Axis < 3; Axis++)
+        {
+            const double Coordinate = FMath::Clamp(Grid[Axis], 0.0, Dimensions[Axis] - 1.0);
+            Base[Axis] = FMath::Clamp(FMath::FloorToInt(Coordinate), 0, FMath::Max(Dimensions[Axis] - 2, 0));
+            Fraction[Axis] = Coordinate - Base[Axis];
+            Step[Axis] = Dimensions[Axis] > 1 ? 1 : 0;
+        }
+
+        const int32 DX = Step[0];
+        const int32 DY = Step[1] * Dimensions.X;
+        const int32 DZ = Step[2] * Dimensions.X * Dimensions.Y;
+        const FVector* C = Field.GetData() + Base[0] + Base[1] * Dimensions.X + Base[2] * Dimensions.X * Dimensions.Y;
+
+        // Interpolate along X, then Y, then Z, keeping the differences each stage needs
+        const FVector X00 = FMath::Lerp(C[0], C[DX], Fraction[0]);
+        const FVector X10 = FMath::Lerp(C[DY], C[DY + DX], Fraction[0]);
+        const FVector X01 = FMath::Lerp(C[DZ], C[DZ + DX], Fraction[0]);
+        const FVector X11 = FMath::Lerp(C[DZ + DY], C[DZ + DY + DX], Fraction[0]);
+        const FVector Y0 = FMath::Lerp(X00, X10, Fraction[1]);
+        const FVector Y1 = FMath::Lerp(X01, X11, Fraction[1]);
+
+        const FVector AlongX = FMath::Lerp(
+            FMath::Lerp(C[DX] - C[0], C[DY + DX] - C[DY], Fraction[1]),
+            FMath::Lerp(C[DZ + DX] - C[DZ], C[DZ + DY + DX] - C[DZ + DY], Fraction[1]),
+            Fraction[2]);
+        const FVector AlongY = FMath::Lerp(X10 - X00, X11 - X01, Fraction[2]);
+        const FVector AlongZ = Y1 - Y0;
+
+        FGradientSample Sample;
+        Sample.Velocity = FMath::Lerp(Y0, Y1, Fraction[2]);
+        Sample.Derivatives[0] = AlongX / CellSpacing.X;
+        Sample.Derivatives[1] = AlongY / CellSpacing.Y;
+        Sample.Derivatives[2] = AlongZ / CellSpacing.Z;
+        return Sample;
+    }
+
+    // Sampler for one mip level of the current or previous step. Level 0 is the full grid.
+    FBatchSampler MakeLevelSampler(const FWindSnapshot& Snapshot, int32 Level, bool bPrevious)
+    {
+        // Same layout, so the previous step's pyramid has the same levels
+        const FWindSnapshot& Step = bPrevious ? *Snapshot.GetPrevious() : Snapshot;
+        if (Level == 0)
+        {
+            return FBatchSampler(Step.Velocity, Step.Origin, Snapshot.Dimensions, Snapshot.CellSpacing);
+        }
+
+        const FWindMipLevel& Mip = Step.MipLevels[Level - 1];
+        return FBatchSampler(Mip.Velocity, Step.Origin + Mip.Offset, Mip.Dimensions, Mip.CellSpacing);
+    }
+}
+
+FVector FWindSnapshot::SampleVelocity(const FVector& LocalPosition) const
+{
+    return IsValid() ? SampleField(Velocity, LocalPosition) : FVector::ZeroVector;
+}
+
+float FWindSnapshot::GetTemporalAlpha(EWindTemporalSampling Sampling, double Now) const
+{
+    if (Sampling == EWindTemporalSampling::Latest || !HasPrevious() || PublishInterval <= 0.0)
+    {
+        return 1.0f;
+    }
+
+    const float Elapsed = static_cast<float>((Now - PublishTime) / PublishInterval);
+    if (Sampling == EWindTemporalSampling::Extrapolate)
+    {
+        return FMath::Clamp(1.0f + Elapsed, 1.0f, WindSnapshotConstants::MaxExtrapolationAlpha);
+    }
+    return FMath::Clamp(Elapsed, 0.0f, 1.0f);
+}
+
+FVector FWindSnapshot::SampleBlendedVelocity(const FVector& WorldPosition, float Alpha) const
+{
+    if (!IsValid())
+    {
+        return FVector::ZeroVector;
+    }
+
+    const FVector Current = SampleField(Velocity, WorldPosition - Origin);
+    if (Alpha == 1.0f || !HasPrevious())
+    {
+        return Current;
+    }
+
+    const FVector PreviousSample = SampleField(Previous->Velocity, WorldPosition - Previous->Origin);
+    return PreviousSample + (Current - PreviousSample) * Alpha;
+}
+
+void FWindSnapshot::SampleBlendedVelocities(TConstArrayView<FVector> WorldPositions, TArrayView<FVector> OutVelocities, float Alpha) const
+{
+    check(OutVelocities.Num() >= WorldPositions.Num());
+    if (!IsValid())
+    {
+        for (int32 Index = 0; Index < WorldPositions.Num(); Index++)
+        {
+            OutVelocities[Index] = FVector::ZeroVector;
+        }
+        return;
+    }
+
+    const WindSnapshotSampling::FBatchSampler Current(Velocity, Origin, Dimensions, CellSpacing);
+    if (Alpha == 1.0f || !HasPrevious())
+    {
+        for (int32 Index = 0; Index < WorldPositions.Num(); Index++)
+        {
+            VectorStoreFloat3(Current.Sample(WorldPositions[Index]), &OutVelocities[Index].X);
+        }
+        return;
+    }
+
+    const WindSnapshotSampling::FBatchSampler PreviousStep(Previous->Velocity, Previous->Origin, Dimensions, CellSpacing);
+    const VectorRegister4Double AlphaVector = VectorSetFloat1(static_cast<double>(Alpha));
+    for (int32 Index = 0; Index < WorldPositions.Num(); Index++)
+    {
+        const VectorRegister4Double PreviousSample = PreviousStep.Sample(WorldPositions[Index]);
+        const VectorRegister4Double CurrentSample = Current.Sample(WorldPositions[Index]);
+        VectorStoreFloat3(VectorMultiplyAdd(VectorSubtract(CurrentSample, PreviousSample), AlphaVector, PreviousSample), &OutVelocities[Index].X);
+    }
+}
+
+float FWindSnapshot::GetBlendedSimulationTime(float Alpha) const
+{
+    return HasPrevious() ? Previous->SimulationTime + (SimulationTime - Previous->SimulationTime) * Alpha : SimulationTime;
+}
+
+void FWindSnapshot::BuildMipLevels(int32 MaxWorkers)
+{
+    if (!IsValid())
+    {
+        MipLevels.Reset();
+        return;
+    }
+
+    int32 NumLevels = 0;
+    for (FIntVector LevelDimensions = Dimensions; LevelDimensions.GetMax() > 1; NumLevels++)
+    {
+        LevelDimensions = FIntVector((LevelDimensions.X + 1) / 2, (LevelDimensions.Y + 1) / 2, (LevelDimensions.Z + 1) / 2);
+    }
+    MipLevels.SetNum(NumLevels);
+
+    for (int32 Level = 0; Level < NumLevels; Level++)
+    {
+        const bool bFromGrid = Level == 0;
+        const TArray<FVector>& Source = bFromGrid ? Velocity : MipLevels[Level - 1].Velocity;
+        const FIntVector SourceDimensions = bFromGrid ? Dimensions : MipLevels[Level - 1].Dimensions;
+        const FVector SourceOffset = bFromGrid ? FVector::ZeroVector : MipLevels[Level - 1].Offset;
+        const FVector SourceSpacing = bFromGrid ? CellSpacing : MipLevels[Level - 1].CellSpacing;
+
+        FWindMipLevel& Mip = MipLevels[Level];
+        Mip.Dimensions = FIntVector((SourceDimensions.X + 1) / 2, (SourceDimensions.Y + 1) / 2, (SourceDimensions.Z + 1) / 2);
+        for (int32 Axis = 0; Axis < 3; Axis++)
+        {
+            // An axis already down to one node keeps its position and spacing
+            const bool bHalved = SourceDimensions[Axis] > 1;
+            Mip.Offset[Axis] = SourceOffset[Axis] + (bHalved ? 0.5 * SourceSpacing[Axis] : 0.0);
+            Mip.CellSpacing[Axis] = SourceSpacing[Axis] * (bHalved ? 2.0 : 1.0);
+        }
+        Mip.Velocity.SetNumUninitialized(Mip.Dimensions.X * Mip.Dimensions.Y * Mip.Dimensions.Z);
+
+        // Box filter over the 2x2x2 source nodes, repeating the last node on odd edges
+        const int32 StrideY = SourceDimensions.X;
+        const int32 StrideZ = SourceDimensions.X * SourceDimensions.Y;
+        const FIntVector LevelDimensions = Mip.Dimensions;
+        TArray<FVector>& Destination = Mip.Velocity;
+        const int32 LevelWorkers = Destination.Num() < WindSnapshotConstants::MinParallelNodes ? 1 : MaxWorkers;
+        FWindTileGraph::ParallelForWorkers(LevelDimensions.Z, LevelWorkers, [&](int32 Z)
+        {
+            const int32 Z0 = 2 * Z * StrideZ;
+            const int32 Z1 = FMath::Min(2 * Z + 1, SourceDimensions.Z - 1) * StrideZ;
+            for (int32 Y = 0; Y < LevelDimensions.Y; Y++)
+            {
+                const int32 Y0 = 2 * Y * StrideY;
+                const int32 Y1 = FMath::Min(2 * Y + 1, SourceDimensions.Y - 1) * StrideY;
+                FVector* Row = &Destination[(Z * LevelDimensions.Y + Y) * LevelDimensions.X];
+                for (int32 X = 0; X < LevelDimensions.X; X++)
+                {
+                    const int32 X0 = 2 * X;
+                    const int32 X1 = FMath::Min(2 * X + 1, SourceDimensions.X - 1);
+                    Row[X] = (Source[X0 + Y0 + Z0] + Source[X1 + Y0 + Z0] + Source[X0 + Y1 + Z0] + Source[X1 + Y1 + Z0]
+                        + Source[X0 + Y0 + Z1] + Source[X1 + Y0 + Z1] + Source[X0 + Y1 + Z1] + Source[X1 + Y1 + Z1]) * 0.125;
+                }
+            }
+        });
+    }
+}
+
+FWindVelocityDerivatives FWindSnapshot::SampleBlendedDerivatives(const FVector& WorldPosition, float Alpha) const
+{
+    FWindVelocityDerivatives Result;
+    SampleBlendedDerivatives(MakeArrayView(&WorldPosition, 1), MakeArrayView(&Result, 1), Alpha);
+    return Result;
+}
+
+void FWindSnapshot::SampleBlendedDerivatives(TConstArrayView<FVector> WorldPositions, TArrayView<FWindVelocityDerivatives> OutDerivatives, float Alpha) const
+{
+    check(OutDerivatives.Num() >= WorldPositions.Num());
+    if (!IsValid())
+    {
+        for (int32 Index = 0; Index < WorldPositions.Num(); Index++)
+        {
+            OutDerivatives[Index] = FWindVelocityDerivatives();
+        }
+        return;
+    }
+
+    using namespace WindSnapshotSampling;
+    const bool bBlendSteps = Alpha != 1.0f && HasPrevious();
+    for (int32 Index = 0; Index < WorldPositions.Num(); Index++)
+    {
+        FGradientSample Sample = SampleGradient(Velocity, Origin, Dimensions, CellSpacing, WorldPositions[Index]);
+        if (bBlendSteps)
+        {
+            // Derivatives are linear in the field, so blending them matches differentiating the blend
+            const FGradientSample PreviousSample = SampleGradient(Previous->Velocity, Previous->Origin, Dimensions, CellSpacing, WorldPositions[Index]);
+            Sample.Velocity = FMath::Lerp(PreviousSample.Velocity, Sample.Velocity, static_cast<double>(Alpha));
+            for (int32 Axis = 0; Axis < 3; Axis++)
+            {
+                Sample.Derivatives[Axis] = FMath::Lerp(PreviousSample.Derivatives[Axis], Sample.Derivatives[Axis], static_cast<double>(Alpha));
+            }
+        }
+
+        FWindVelocityDerivatives& Result = OutDerivatives[Index];
+        Result.Velocity = Sample.Velocity;
+        Result.SetDerivatives(Sample.Derivatives[0], Sample.Derivatives[1], Sample.Derivatives[2], CellSpacing);
+    }
+}
+
+void FWindSnapshot::BuildVelocitySums(int32 MaxWorkers)
+{
+    if (!IsValid())
+    {
+        VelocitySums.Reset();
+        return;
+    }
+
+    const int32 SizeX = Dimensions.X + 1;
+    const int32 SizeY = Dimensions.Y + 1;
+    const int32 PlaneSize = SizeX * SizeY;
+    VelocitySums.SetNumUninitialized(PlaneSize * (Dimensions.Z + 1));
+    const int32 NumWorkers = Velocity.Num() < WindSnapshotConstants::MinParallelNodes ? 1 : MaxWorkers;
+
+    FVector* Sums = VelocitySums.GetData();
+    for (int32 Index = 0; Index < PlaneSize; Index++)
+    {
+        Sums[Index] = FVector::ZeroVector;
+    }
+
+    // 2D summed area of each slice on its own
+    FWindTileGraph::ParallelForWorkers(Dimensions.Z, NumWorkers, [&](int32 Z)
+    {
+        FVector* Plane = Sums + (Z + 1) * PlaneSize;
+        for (int32 X = 0; X < SizeX; X++)
+        {
+            Plane[X] = FVector::ZeroVector;
+        }
+
+        const FVector* Source = &Velocity[GetIndex(0, 0, Z)];
+        for (int32 Y = 0; Y < Dimensions.Y; Y++)
+        {
+            const FVector* Above = Plane + Y * SizeX;
+            FVector* Row = Plane + (Y + 1) * SizeX;
+            FVector RowSum = FVector::ZeroVector;
+            Row[0] = FVector::ZeroVector;
+            for (int32 X = 0; X < Dimensions.X; X++)
+            {
+                RowSum += Source[Y * Dimensions.X + X];
+                Row[X + 1] = Above[X + 1] + RowSum;
+            }
+        }
+    });
+
+    // Then accumulate the slices along Z, each row independently
+    FWindTileGraph::ParallelForWorkers(Dimensions.Y, NumWorkers, [&](int32 Y)
+    {
+        for (int32 Z = 2; Z <= Dimensions.Z; Z++)
+        {
+            const FVector* Below = Sums + (Z - 1) * PlaneSize + (Y + 1) * SizeX;
+            FVector* Row = Sums + Z * PlaneSize + (Y + 1) * SizeX;
+            for (int32 X = 1; X < SizeX; X++)
+            {
+                Row[X] += Below[X];
+            }
+        }
+    });
+}
+
+FVector FWindSnapshot::GetBlendedAverageVelocity(const FBox& WorldBox, float Alpha) const
+{
+    if (!IsValid() || !HasVelocitySums() || !WorldBox.IsValid)
+    {
+        return FVector::ZeroVector;
+    }
+
+    const int32 SizeX = Dimensions.X + 1;
+    const int32 PlaneSize = SizeX * (Dimensions.Y + 1);
+
+    auto Average = [this, &WorldBox, SizeX, PlaneSize](const TArray<FVector>& Sums, const FVector& FieldOrigin)
+    {
+        // Node N owns the cell from N - 0.5 to N + 0.5, so boundary K sits at K - 0.5 in grid units
+        const FVector Min = (WorldBox.Min - FieldOrigin) / CellSpacing + 0.5;
+        const FVector Max = (WorldBox.Max - FieldOrigin) / CellSpacing + 0.5;
+        int32 Begin[3];
+        int32 End[3];
+        for (int32 Axis = 0; Axis < 3; Axis++)
+        {
+            Begin[Axis] = FMath::Clamp(FMath::RoundToInt(Min[Axis]), 0, Dimensions[Axis]);
+            End[Axis] = FMath::Clamp(FMath::RoundToInt(Max[Axis]), 0, Dimensions[Axis]);
+            if (End[Axis] <= Begin[Axis])
+            {
+                // Smaller than a cell: the cell holding the centre of the box
+                Begin[Axis] = FMath::Clamp(FMath::FloorToInt(0.5 * (Min[Axis] + Max[Axis])), 0, Dimensions[Axis] - 1);
+                End[Axis] = Begin[Axis] + 1;
+            }
+        }
+
+        auto Fetch = [&Sums, SizeX, PlaneSize](int32 X, int32 Y, int32 Z) { return Sums[X + Y * SizeX + Z * PlaneSize]; };
+        const FVector Sum =
+            Fetch(End[0], End[1], End[2]) - Fetch(Begin[0], End[1], End[2]) - Fetch(End[0], Begin[1], End[2]) - Fetch(End[0], End[1], Begin[2])
+            + Fetch(Begin[0], Begin[1], End[2]) + Fetch(Begin[0], End[1], Begin[2]) + Fetch(End[0], Begin[1], Begin[2]) - Fetch(Begin[0], Begin[1], Begin[2]);
+        return Sum / static_cast<double>((End[0] - Begin[0]) * (End[1] - Begin[1]) * (End[2] - Begin[2]));
+    };
+
+    const FVector Current = Average(VelocitySums, Origin);
+    if (Alpha == 1.0f || !HasPrevious() || Previous->VelocitySums.Num() != VelocitySums.Num())
+    {
+        return Current;
+    }
+
+    const FVector PreviousAverage = Average(Previous->VelocitySums, Previous->Origin);
+    return PreviousAverage + (Current - PreviousAverage) * Alpha;
+}
+
+float FWindSnapshot::GetLodForFootprint(float Footprint) const
+{
+    const double Spacing = CellSpacing.GetMax();
+    if (!IsValid() || Spacing <= 0.0 || Footprint <= Spacing)
+    {
+        return 0.0f;
+    }
+    return FMath::Min(static_cast<float>(FMath::Log2(Footprint / Spacing)), GetNumMipLevels() - 1.0f);
+}
+
+FVector FWindSnapshot::SampleBlendedVelocityLod(const FVector& WorldPosition, float Lod, float Alpha) const
+{
+    FVector Result;
+    SampleBlendedVelocitiesLod(MakeArrayView(&WorldPosition, 1), MakeArrayView(&Result, 1), Lod, Alpha);
+    return Result;
+}
+
+void FWindSnapshot::SampleBlendedVelocitiesLod(TConstArrayView<FVector> WorldPositions, TArrayView<FVector> OutVelocities, float Lod, float Alpha) const
+{
+    check(OutVelocities.Num() >= WorldPositions.Num());
+    if (!IsValid())
+    {
+        for (int32 Index = 0; Index < WorldPositions.Num(); Index++)
+        {
+            OutVelocities[Index] = FVector::ZeroVector;
+        }
+        return;
+    }
+
+    const float ClampedLod = FMath::Clamp(Lod, 0.0f, GetNumMipLevels() - 1.0f);
+    const int32 FineLevel = FMath::FloorToInt(ClampedLod);
+    const int32 CoarseLevel = FMath::Min(FineLevel + 1, GetNumMipLevels() - 1);
+    const double LevelFraction = ClampedLod - FineLevel;
+    const bool bBlendLevels = LevelFraction > 0.0 && CoarseLevel != FineLevel;
+    const bool bBlendSteps = Alpha != 1.0f && HasPrevious() && Previous->MipLevels.Num() == MipLevels.Num();
+
+    using namespace WindSnapshotSampling;
+    const FBatchSampler Fine = MakeLevelSampler(*this, FineLevel, false);
+    const FBatchSampler Coarse = MakeLevelSampler(*this, CoarseLevel, false);
+    const FBatchSampler PreviousFine = MakeLevelSampler(*this, FineLevel, bBlendSteps);
+    const FBatchSampler PreviousCoarse = MakeLevelSampler(*this, CoarseLevel, bBlendSteps);
+    const VectorRegister4Double AlphaVector = VectorSetFloat1(static_cast<double>(Alpha));
+    const VectorRegister4Double LevelVector = VectorSetFloat1(LevelFraction);
+
+    auto SampleLevel = [bBlendSteps, &AlphaVector](const FBatchSampler& Current, const FBatchSampler& PreviousLevel, const FVector& Position)
+    {
+        const VectorRegister4Double CurrentSample = Current.Sample(Position);
+        if (!bBlendSteps)
+        {
+            return CurrentSample;
+        }
+        const VectorRegister4Double PreviousSample = PreviousLevel.Sample(Position);
+        return VectorMultiplyAdd(VectorSubtract(CurrentSample, PreviousSample), AlphaVector, PreviousSample);
+    };
+
+    for (int32 Index = 0; Index < WorldPositions.Num(); Index++)
+    {
+        const FVector& Position = WorldPositions[Index];
+        VectorRegister4Double Sample = SampleLevel(Fine, PreviousFine, Position);
+        if (bBlendLevels)
+        {
+            const VectorRegister4Double CoarseSample = SampleLevel(Coarse, PreviousCoarse, Position);
+            Sample = VectorMultiplyAdd(VectorSubtract(CoarseSample, Sample), LevelVector, Sample);
+        }
+        VectorStoreFloat3(Sample, &OutVelocities[Index].X);
+    }
+}
+
+FVector FWindSnapshot::SampleField(const TArray<FVector>& Field, const FVector& LocalPosition) const
+{
+
+    const FVector GridPosition = LocalPosition / CellSpacing;
+    const float GX = FMath::Clamp(static_cast<float>(GridPosition.X), 0.0f, Dimensions.X - 1.0f);
+    const float GY = FMath::Clamp(static_cast<float>(GridPosition.Y), 0.0f, Dimensions.Y - 1.0f);
+    const float GZ = FMath::Clamp(static_cast<float>(GridPosition.Z), 0.0f, Dimensions.Z - 1.0f);
+
+    const int32 X0 = FMath::FloorToInt(GX);
+    const int32 Y0 = FMath::FloorToInt(GY);
+    const int32 Z0 = FMath::FloorToInt(GZ);
+    const int32 X1 = FMath::Min(X0 + 1, Dimensions.X - 1);
+    const int32 Y1 = FMath::Min(Y0 + 1, Dimensions.Y - 1);
+    const int32 Z1 = FMath::Min(Z0 + 1, Dimensions.Z - 1);
+
+    const float Sx = GX - X0;
+    const float Sy = GY - Y0;
+    const float Sz = GZ - Z0;
+
+    return FMath::Lerp(
+        FMath::Lerp(
+            FMath::Lerp(Field[GetIndex(X0, Y0, Z0)], Field[GetIndex(X1, Y0, Z0)], Sx),
+            FMath::Lerp(Field[GetIndex(X0, Y1, Z0)], Field[GetIndex(X1, Y1, Z0)], Sx),
+            Sy),
+        FMath::Lerp(
+            FMath::Lerp(Field[GetIndex(X0, Y0, Z1)], Field[GetIndex(X1, Y0, Z1)], Sx),
+            FMath::Lerp(Field[GetIndex(X0, Y1, Z1)], Field[GetIndex(X1, Y1, Z1)], Sx),
+            Sy),
+        Sz);
+}
+
+float FWindSnapshot::GetTurbulenceEnergy(const FVector& GridPosition) const
+{
+    if (TurbulenceEnergy.Num() != Velocity.Num() || !IsValid())
+    {
+        return 0.0f;
+    }
+
+    const int32 X = FMath::Clamp(FMath::RoundToInt(GridPosition.X), 0, Dimensions.X - 1);
+    const int32 Y = FMath::Clamp(FMath::RoundToInt(GridPosition.Y), 0, Dimensions.Y - 1);
+    const int32 Z = FMath::Clamp(FMath::RoundToInt(GridPosition.Z), 0, Dimensions.Z - 1);
+    return TurbulenceEnergy[GetIndex(X, Y, Z)];
+}
+
+FWindSnapshotChannel::FWindSnapshotChannel()
+    : Current(nullptr)
+    , NumAcquiring(0)
+{
+}
+
+FWindSnapshotChannel::~FWindSnapshotChannel()
+{
+    // Readers hold their own references, so only ours are dropped here
+    Reset();
+
+    FScopeLock Lock(&WriterLock);
+    for (FWindSnapshot* Snapshot : Retired)
+    {
+        Snapshot->Release();
+    }
+    Retired.Reset();
+    for (FWindSnapshot* Snapshot : Recycled)
+    {
+        Snapshot->Release();
+    }
+    Recycled.Reset();
+}
+
+TRefCountPtr<FWindSnapshot> FWindSnapshotChannel::Acquire() const
+{
+    // The counter marks the window in which the pointer is loaded but not yet referenced; the
+    // writer will not release a retired snapshot while any reader is inside it
+    NumAcquiring.fetch_add(1, std::memory_order_seq_cst);
+    TRefCountPtr<FWindSnapshot> Snapshot(Current.load(std::memory_order_seq_cst));
+    NumAcquiring.fetch_sub(1, std::memory_order_release);
+    return Snapshot;
+}
+
+TRefCountPtr<FWindSnapshot> FWindSnapshotChannel::BeginWrite()
+{
+    FScopeLock Lock(&WriterLock);
+    CollectRetired();
+
+    if (Recycled.Num() > 0)
+    {
+        // Transfer the list's reference to the returned pointer
+        FWindSnapshot* Snapshot = Recycled.Pop();
+        TRefCountPtr<FWindSnapshot> Result(Snapshot);
+        Snapshot->Release();
+        return Result;
+    }
+
+    return TRefCountPtr<FWindSnapshot>(new FWindSnapshot());
+}
+
+void FWindSnapshotChannel::Publish(TRefCountPtr<FWindSnapshot> Snapshot)
+{
+    FScopeLock Lock(&WriterLock);
+
+    FWindSnapshot* NewSnapshot = Snapshot.GetReference();
+    if (NewSnapshot)
+    {
+        NewSnapshot->AddRef();
+    }
+
+    Retire(Current.exchange(NewSnapshot, std::memory_order_seq_cst));
+    CollectRetired();
+}
+
+void FWindSnapshotChannel::Reset()
+{
+    FScopeLock Lock(&WriterLock);
+    Retire(Current.exchange(nullptr, std::memory_order_seq_cst));
+    CollectRetired();
+}
+
+void FWindSnapshotChannel::Retire(FWindSnapshot* Snapshot)
+{
+    if (Snapshot)
+    {
+        Retired.Add(Snapshot);
+    }
+}
+
+void FWindSnapshotChannel::CollectRetired()
+{
+    // Any reader that starts after this check loads the new pointer, so every retired snapshot
+    // is past its grace period
+    if (Retired.Num() == 0 || NumAcquiring.load(std::memory_order_seq_cst) != 0)
+    {
+        return;
+    }
+
+    // Newest first, so dropping one snapshot's Previous can free the older one in the same pass
+    for (int32 Index = Retired.Num() - 1; Index >= 0; Index--)
+    {
+        FWindSnapshot* Snapshot = Retired[Index];
+
+        // Besides our reference, only newer snapshots blending against it may hold it. Any other
+        // reference is a reader, who may still blend against its Previous.
+        const int32 NumSuccessors = CountSuccessors(Snapshot);
+        if (Snapshot->GetRefCount() != 1 + NumSuccessors)
+        {
+            continue;
+        }
+        Snapshot->Previous.SafeRelease();
+        if (NumSuccessors > 0)
+        {
+            continue;
+        }
+
+        // One spare is enough for the rotation
+        Retired.RemoveAt(Index);
+        if (Recycled.Num() == 0)
+        {
+            Recycled.Add(Snapshot);
+        }
+        else
+        {
+            Snapshot->Release();
+        }
+    }
+}
+
+int32 FWindSnapshotChannel::CountSuccessors(const FWindSnapshot* Snapshot) const
+{
+    int32 NumSuccessors = 0;
+    const FWindSnapshot* Published = Current.load(std::memory_order_relaxed);
+    if (Published && Published->GetPrevious() == Snapshot)
+    {
+        NumSuccessors++;
+    }
+    for (const FWindSnapshot* Other : Retired)
+    {
+        if (Other->GetPrevious() == Snapshot)
+        {
+            NumSuccessors++;
+        }
+    }
+    return NumSuccessors;
+}
@@ -0,0 +1,80 @@
+#include "WindSolverBackend.h"
+#include "WindSystemSettings.h"
+#include "WindStableFluidsSolver.h"
+#include "WindLatticeBoltzmannSolver.h"
+#include "WindLayeredSolver.h"
+
+TSharedPtr<IWindSolverBackend> WindSolverBackend::Create(EWindSolverBackend Backend)
+{
+    switch (Backend)
+    {
+    case EWindSolverBackend::LatticeBoltzmann:
+        return MakeShared<FWindLatticeBoltzmannSolver>();
+    case EWindSolverBackend::Layered:
+        return MakeShared<FWindLayeredSolver>();
+    case EWindSolverBackend::StableFluids:
+    default:
+        return MakeShared<FWindStableFluidsSolver>();
+    }
+}
+
+void IWindSolverBackend::BeginStep(float DeltaTime)
+{
+    PendingStepTime = DeltaTime;
+    bStepPending = true;
+}
+
+bool IWindSolverBackend::StepSlice()
+{
+    if (bStepPending)
+    {
+        bStepPending = false;
+        Step(PendingStepTime);
+    }
+    return true;
+}
+
+float IWindSolverBackend::GetStepProgress() const
+{
+    return bStepPending ? 0.0f : 1.0f;
+}
+
+void WindSolverBackend::Resample(const IWindSolverBackend& Source, IWindSolverBackend& Target)
+{
+    const FIntVector Dimensions = Target.GetDimensions();
+    const FVector Spacing = Target.GetCellSpacing();
+
+    for (int32 Z = 0; Z < Dimensions.Z; Z++)
+    {
+        for (int32 Y = 0; Y < Dimensions.Y; Y++)
+        {
+            for (int32 X = 0; X < Dimensions.X; X++)
+            {
+                const FVector LocalPosition = FVector(X, Y, Z) * Spacing;
+                const FVector Velocity = Source.SampleVelocity(LocalPosition);
+                if (!Velocity.IsZero())
+                {
+                    Target.AddVelocity(LocalPosition, Velocity);
+                }
+            }
+        }
+    }
+}
+
+void WindSolverBackend::GetSpongeBlend(const FWindSolverConfig& Config, float DeltaTime, TArray<float>& OutBlend)
+{
+    OutBlend.Reset();
+    if (Config.SpongeWidth <= 0 || Config.SpongeStrength <= 0.0f)
+    {
+        return;
+    }
+
+    OutBlend.SetNumUninitialized(Config.SpongeWidth);
+    for (int32 Distance = 0; Distance < Config.SpongeWidth; Distance++)
+    {
+        // Quadratic ramp avoids a sharp impedance jump at the inner edge of the layer, which would
+        // itself reflect waves
+        const float Ramp = static_cast<float>(Config.SpongeWidth - Distance) / Config.SpongeWidth;
+        OutBlend[Distance] = 1.0f - FMath::Exp(-Config.SpongeStrength * Ramp * Ramp * DeltaTime);
+    }
+}
@@ -1,6 +1,13 @@
 #include "WindSourceComponent.h"
 #include "WindSubsystem.h"
 #include "WindSystemCommon.h"
+#include "WindForcingGrid.h"
+
+namespace WindSourceConstants
+{
+    // Refinement per axis for generators smaller than a cell, so at most 64 samples per cell
+    const int32 MaxSubdivisions = 4;
+}
 
 UWindGeneratorComponent::UWindGeneratorComponent()
 {
@@ -33,27 +40,77 @@ void UWindGeneratorComponent::TickComponent(float DeltaTime, ELevelTick TickType
     // The actual update is now handled by the subsystem
 }
 
-void UWindGeneratorComponent::UpdateWindSimulation(float DeltaTime, UWindSimulationSubsystem* Subsystem)
+bool UWindGeneratorComponent::ConsumeUpdate(float DeltaTime)
 {
     TimeSinceLastUpdate += DeltaTime;
-    if (TimeSinceLastUpdate >= UpdateFrequency)
+    if (TimeSinceLastUpdate < UpdateFrequency)
+    {
+        return false;
+    }
+    TimeSinceLastUpdate = 0.0f;
+    return true;
+}
+
+FBox UWindGeneratorComponent::GetWindBounds() const
+{
+    return FBox::BuildAABB(GetComponentLocation(), FVector(Radius));
+}
+
+void UWindGeneratorComponent::RasterizeWind(FWindForcingGrid& Forcing) const
+{
+    FIntVector NodeMin;
+    FIntVector NodeMax;
+    if (!Forcing.GetNodeRange(GetWindBounds(), NodeMin, NodeMax))
+    {
+        return;
+    }
+
+    // One sample per node is enough for shapes spanning a few cells. Smaller shapes could fall
+    // between nodes entirely, so the lattice is refined and each sample splatted to its nodes.
+    const float MinSpacing = static_cast<float>(Forcing.GetCellSpacing().GetMin());
+    const int32 Subdivisions = Radius > 0.0f
+        ? FMath::Clamp(FMath::CeilToInt(2.0f * MinSpacing / Radius), 1, WindSourceConstants::MaxSubdivisions)
+        : WindSourceConstants::MaxSubdivisions;
+
+    if (Subdivisions == 1)
     {
-        const int32 SampleCount = 200; // Increased sample count for more consistent results
-        for (int32 i = 0; i < SampleCount; ++i)
+        for (int32 Z = NodeMin.Z; Z <= NodeMax.Z; Z++)
         {
-            float RandomRadius = FMath::Sqrt(FMath::FRand()) * Radius; // This distribution favors samples near the edge
-            FVector RandomDirection = FMath::VRand();
-            FVector SampleLocation = GetComponentLocation() + RandomDirection * RandomRadius;
-            FVector WindVelocity = GetWindVelocityAtLocation(SampleLocation);
+            for (int32 Y = NodeMin.Y; Y <= NodeMax.Y; Y++)
+            {
+                for (int32 X = NodeMin.X; X <= NodeMax.X; X++)
+                {
+                    const FVector WindVelocity = GetWindVelocityAtLocation(Forcing.GetNodePosition(X, Y, Z));
+                    if (!WindVelocity.IsZero())
+                    {
+                        Forcing.AddNode(X, Y, Z, WindVelocity);
+                    }
+                }
+            }
+        }
+        return;
+    }
 
-            // Ensure the wind velocity is not zero
-            if (!WindVelocity.IsNearlyZero())
+    // Each node receives the same total weight as on the unrefined lattice
+    const float SampleWeight = 1.0f / (Subdivisions * Subdivisions * Subdivisions);
+    const FVector SampleSpacing = Forcing.GetCellSpacing() / Subdivisions;
+    const FVector Start = Forcing.GetNodePosition(NodeMin.X, NodeMin.Y, NodeMin.Z);
+    const FIntVector NumSamples = (NodeMax - NodeMin) * Subdivisions + FIntVector(1);
+
+    for (int32 Z = 0; Z < NumSamples.Z; Z++)
+    {
+        for (int32 Y = 0; Y < NumSamples.Y; Y++)
+        {
+            for (int32 X = 0; X < NumSamples.X; X++)
             {
-                WINDSYSTEM_LOG(Verbose, TEXT("%s: Adding wind at location %s with velocity %s"), *GetName(), *SampleLocation.ToString(), *WindVelocity.ToString());
-                Subsystem->AddWindAtLocation(SampleLocation, WindVelocity);
+                const FVector SampleLocation = Start + FVector(X, Y, Z) * SampleSpacing;
+                const FVector WindVelocity = GetWindVelocityAtLocation(SampleLocation);
+                if (!WindVelocity.IsZero())
+                {
+                    Forcing.SplatTrilinear(SampleLocation, WindVelocity * SampleWeight);
+                }
             }
         }
-        TimeSinceLastUpdate = 0.0f;
     }
 }
 
@@ -149,4 +206,9 @@ FVector USplineWindGeneratorComponent::GetWindVelocityAtLocation(const FVector&
     FVector SplineTangent = WindSpline->GetTangentAtSplineInputKey(SplineInput, ESplineCoordinateSpace::World).GetSafeNormal();
     float StrengthAtDistance = Strength * GetFalloff(ClosestDistance);
     return SplineTangent * StrengthAtDistance;
+}
+
+FBox USplineWindGeneratorComponent::GetWindBounds() const
+{
+    return WindSpline->CalcBounds(WindSpline->GetComponentTransform()).GetBox().ExpandBy(Radius);
 }
\ No newline at end of file
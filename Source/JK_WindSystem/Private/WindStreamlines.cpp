@@ -0,0 +1,102 @@
+#include "WindStreamlines.h"
+#include "Async/ParallelFor.h"
+
+namespace WindStreamlineConstants
+{
+    // Seeds advanced together, sized so a chunk's positions and stage velocities stay in cache
+    const int32 SeedChunkSize = 256;
+    // Traces with fewer velocity fetches than this run on the calling thread
+    const int32 MinParallelFetches = 8192;
+}
+
+void FWindStreamlineTracer::Trace(TConstArrayView<FVector> Seeds, const FWindTraceSettings& Settings, FSampler Sampler, TArrayView<FVector> OutPoints)
+{
+    using namespace WindStreamlineConstants;
+
+    const int32 NumPoints = Settings.GetNumPoints();
+    check(OutPoints.Num() >= Seeds.Num() * NumPoints);
+
+    const double Dt = FMath::Max(Settings.StepTime, 0.0f);
+    const bool bRK4 = Settings.Integrator == EWindTraceIntegrator::RK4;
+    const int32 NumChunks = FMath::DivideAndRoundUp(Seeds.Num(), SeedChunkSize);
+    const int32 NumFetches = Seeds.Num() * (NumPoints - 1) * (bRK4 ? 4 : 2);
+
+    ParallelFor(NumChunks, [&](int32 Chunk)
+    {
+        const int32 Begin = Chunk * SeedChunkSize;
+        const int32 Count = FMath::Min(SeedChunkSize, Seeds.Num() - Begin);
+
+        TArray<FVector> Positions(Seeds.GetData() + Begin, Count);
+        TArray<FVector> Stage;
+        TArray<FVector> Velocity;
+        TArray<FVector> Sum;
+        Stage.SetNumUninitialized(Count);
+        Velocity.SetNumUninitialized(Count);
+        Sum.SetNumUninitialized(Count);
+
+        for (int32 Index = 0; Index < Count; Index++)
+        {
+            OutPoints[(Begin + Index) * NumPoints] = Positions[Index];
+        }
+
+        for (int32 Step = 1; Step < NumPoints; Step++)
+        {
+            // k1 at the current positions
+            Sampler(Positions, Velocity);
+            if (bRK4)
+            {
+                // Sum collects k1 + 2 k2 + 2 k3 + k4, each stage sampled at the previous one's offset
+                for (int32 Index = 0; Index < Count; Index++)
+                {
+                    Sum[Index] = Velocity[Index];
+                    Stage[Index] = Positions[Index] + Velocity[Index] * (0.5 * Dt);
+                }
+                Sampler(Stage, Velocity);
+                for (int32 Index = 0; Index < Count; Index++)
+                {
+                    Sum[Index] += Velocity[Index] * 2.0;
+                    Stage[Index] = Positions[Index] + Velocity[Index] * (0.5 * Dt);
+                }
+                Sampler(Stage, Velocity);
+                for (int32 Index = 0; Index < Count; Index++)
+                {
+                    Sum[Index] += Velocity[Index] * 2.0;
+                    Stage[Index] = Positions[Index] + Velocity[Index] * Dt;
+                }
+                Sampler(Stage, Velocity);
+                for (int32 Index = 0; Index < Count; Index++)
+                {
+                    Positions[Index] += (Sum[Index] + Velocity[Index]) * (Dt / 6.0);
+                }
+            }
+            else
+            {
+                // Midpoint: step the whole way with the velocity half a step ahead
+                for (int32 Index = 0; Index < Count; Index++)
+                {
+                    Stage[Index] = Positions[Index] + Velocity[Index] * (0.5 * Dt);
+                }
+                Sampler(Stage, Velocity);
+                for (int32 Index = 0; Index < Count; Index++)
+                {
+                    Positions[Index] += Velocity[Index] * Dt;
+                }
+            }
+
+            for (int32 Index = 0; Index < Count; Index++)
+            {
+                OutPoints[(Begin + Index) * NumPoints + Step] = Positions[Index];
+            }
+        }
+    }, NumFetches < MinParallelFetches ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+}
+
+void FWindStreamlineTracer::ToPolylines(TConstArrayView<FVector> Points, int32 NumPointsPerSeed, TArray<FWindTracePolyline>& OutPolylines)
+{
+    const int32 NumSeeds = NumPointsPerSeed > 0 ? Points.Num() / NumPointsPerSeed : 0;
+    OutPolylines.SetNum(NumSeeds);
+    for (int32 Seed = 0; Seed < NumSeeds; Seed++)
+    {
+        OutPolylines[Seed].Points = TArray<FVector>(Points.GetData() + Seed * NumPointsPerSeed, NumPointsPerSeed);
+    }
+}
@@ -3,6 +3,17 @@
 #include "Engine/World.h"
 #include "EngineUtils.h"
 #include "WindZoneVolumeComponent.h"
+#include "WindForcingGrid.h"
+#include "WindZoneMask.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Tasks/Task.h"
+#include "Misc/ScopeRWLock.h"
+
+namespace WindSubsystemConstants
+{
+    // Below this many generators per worker the launch costs more than the evaluation saves
+    const int32 MinGeneratorsPerWorker = 4;
+}
 
 UWindSimulationSubsystem::UWindSimulationSubsystem()
     : WindSystemActor(nullptr)
@@ -23,6 +34,7 @@ void UWindSimulationSubsystem::Deinitialize()
     FTSTicker::GetCoreTicker().RemoveTicker(TickHandle);
 
     DestroyWindSystemActor();
+    PublishQueryView();
 
     Super::Deinitialize();
 }
@@ -40,17 +52,31 @@ bool UWindSimulationSubsystem::Tick(float DeltaTime)
 {
     EnsureWindSystemActorInitialized();
 
+    const UWorld* World = GetWorld();
+    const bool bPaused = World && World->IsPaused();
+
     if (WindSystemActor && WindSystemActor->WindSimulationComponent)
     {
-        
         if (WindGridCenter)
         {
             WindSystemActor->WindSimulationComponent->UpdateGridCenter(WindGridCenter->GetActorLocation());
         }
-        WindSystemActor->WindSimulationComponent->SimulationStep(DeltaTime);
+        WindSystemActor->WindSimulationComponent->AdvanceSimulation(DeltaTime, bPaused);
     }
 
-    UpdateWindGenerators(DeltaTime);
+    // Against the layout of the latest snapshot, so the mask lines up with the grid it applies to
+    UpdateZoneMask();
+
+    // After the advance, so queries see any step it published
+    ResolveWindQueries();
+    PublishQueryView();
+
+    // Background modes are still solving the step launched above while the generators gather
+    // the inputs of the next one
+    if (!bPaused)
+    {
+        UpdateWindGenerators(DeltaTime);
+    }
 
     return true;
 }
@@ -59,14 +85,273 @@ FVector UWindSimulationSubsystem::GetWindVelocityAtLocation(const FVector& World
 {
     if (WindSystemActor && WindSystemActor->WindSimulationComponent)
     {
-        FVector WindVelocity = WindSystemActor->WindSimulationComponent->GetWindVelocityAtLocation(WorldLocation);
-        for (const UWindZoneVolumeComponent* Modifier : WindZones)
+        return ApplyWindZones(WorldLocation, WindSystemActor->WindSimulationComponent->GetWindVelocityAtLocation(WorldLocation));
+    }
+    return FVector::ZeroVector;
+}
+
+FVector UWindSimulationSubsystem::GetWindVelocityAtLocationLod(const FVector& WorldLocation, float Footprint) const
+{
+    if (WindSystemActor && WindSystemActor->WindSimulationComponent)
+    {
+        return ApplyWindZones(WorldLocation, WindSystemActor->WindSimulationComponent->GetWindVelocityAtLocationLod(WorldLocation, Footprint));
+    }
+    return FVector::ZeroVector;
+}
+
+FVector UWindSimulationSubsystem::GetAverageWindInBox(const FBox& Box) const
+{
+    if (WindSystemActor && WindSystemActor->WindSimulationComponent)
+    {
+        return WindSystemActor->WindSimulationComponent->GetAverageWindInBox(Box);
+    }
+    return FVector::ZeroVector;
+}
+
+FWindVelocityDerivatives UWindSimulationSubsystem::GetWindDerivativesAtLocation(const FVector& WorldLocation) const
+{
+    if (WindSystemActor && WindSystemActor->WindSimulationComponent)
+    {
+        return WindSystemActor->WindSimulationComponent->GetWindDerivativesAtLocation(WorldLocation);
+    }
+    return FWindVelocityDerivatives();
+}
+
+void UWindSimulationSubsystem::GetWindDerivativesAtLocations(TConstArrayView<FVector> Locations, TArrayView<FWindVelocityDerivatives> OutDerivatives) const
+{
+    check(OutDerivatives.Num() >= Locations.Num());
+    if (WindSystemActor && WindSystemActor->WindSimulationComponent)
+    {
+        WindSystemActor->WindSimulationComponent->GetWindDerivativesAtLocations(Locations, OutDerivatives);
+        return;
+    }
+
+    for (int32 Index = 0; Index < Locations.Num(); Index++)
+    {
+        OutDerivatives[Index] = FWindVelocityDerivatives();
+    }
+}
+
+void UWindSimulationSubsystem::TraceWindStreamlines(TConstArrayView<FVector> Seeds, const FWindTraceSettings& Settings, TArrayView<FVector> OutPoints) const
+{
+    check(OutPoints.Num() >= Seeds.Num() * Settings.GetNumPoints());
+    if (WindSystemActor && WindSystemActor->WindSimulationComponent)
+    {
+        WindSystemActor->WindSimulationComponent->TraceWindStreamlines(Seeds, Settings, OutPoints);
+        return;
+    }
+
+    // No wind: every seed stays where it is
+    const int32 NumPoints = Settings.GetNumPoints();
+    for (int32 Index = 0; Index < Seeds.Num() * NumPoints; Index++)
+    {
+        OutPoints[Index] = Seeds[Index / NumPoints];
+    }
+}
+
+FVector UWindSimulationSubsystem::ApplyWindZones(const FVector& WorldLocation, FVector WindVelocity) const
+{
+    // Inside the grid the simulation has already applied the zones through its mask
+    const TRefCountPtr<FWindSnapshot> Snapshot = WindSystemActor->WindSimulationComponent->GetSnapshot();
+    if (Snapshot.IsValid() && Snapshot->ZoneMask.IsValid() && Snapshot->ZoneMask->GetCellAt(WorldLocation) != INDEX_NONE)
+    {
+        return WindVelocity;
+    }
+
+    TArray<int32, TInlineAllocator<16>> Candidates;
+    ZoneIndex.Query(WorldLocation, Candidates);
+    for (const int32 ZoneId : Candidates)
+    {
+        WindVelocity = WindZones[ZoneId]->ModifyWindVelocity(WindVelocity, WorldLocation);
+    }
+    return WindVelocity;
+}
+
+FWindQueryView UWindSimulationSubsystem::GetQueryView() const
+{
+    FReadScopeLock Lock(QueryViewLock);
+    return QueryView;
+}
+
+void UWindSimulationSubsystem::PublishQueryView()
+{
+    // Everything read from UObjects is copied out here, on the game thread
+    FWindQueryView View;
+    if (WindSystemActor && WindSystemActor->WindSimulationComponent)
+    {
+        View = WindSystemActor->WindSimulationComponent->MakeQueryView();
+        View.SetOuterZones(ZoneMask);
+    }
+
+    FWriteScopeLock Lock(QueryViewLock);
+    QueryView = MoveTemp(View);
+}
+
+FWindQueryHandle UWindSimulationSubsystem::RegisterWindQuery(TFunction<FVector()> LocationProvider)
+{
+    const FWindQueryHandle Handle = AllocateWindQuery();
+    QuerySlots[Handle.Index].LocationProvider = MoveTemp(LocationProvider);
+    return Handle;
+}
+
+FWindQueryHandle UWindSimulationSubsystem::RegisterWindQuery(const USceneComponent* Component)
+{
+    const FWindQueryHandle Handle = AllocateWindQuery();
+    QuerySlots[Handle.Index].Component = Component;
+    if (Component)
+    {
+        QueryLocations[Handle.Index] = Component->GetComponentLocation();
+    }
+    return Handle;
+}
+
+void UWindSimulationSubsystem::UnregisterWindQuery(FWindQueryHandle& Handle)
+{
+    if (IsWindQueryValid(Handle))
+    {
+        FWindQuerySlot& Slot = QuerySlots[Handle.Index];
+        Slot.LocationProvider.Reset();
+        Slot.Component.Reset();
+        Slot.bActive = false;
+        QueryResults[Handle.Index] = FVector::ZeroVector;
+        FreeQuerySlots.Add(Handle.Index);
+    }
+    Handle.Invalidate();
+}
+
+FWindQueryHandle UWindSimulationSubsystem::AllocateWindQuery()
+{
+    int32 Index;
+    if (FreeQuerySlots.Num() > 0)
+    {
+        Index = FreeQuerySlots.Pop();
+    }
+    else
+    {
+        Index = QuerySlots.AddDefaulted();
+        QueryLocations.Add(FVector::ZeroVector);
+        QueryResults.Add(FVector::ZeroVector);
+    }
+
+    FWindQuerySlot& Slot = QuerySlots[Index];
+    Slot.bActive = true;
+    Slot.Serial++;
+
+    FWindQueryHandle Handle;
+    Handle.Index = Index;
+    Handle.Serial = Slot.Serial;
+    Handle.Subsystem = this;
+    return Handle;
+}
+
+void UWindSimulationSubsystem::ResolveWindQueries()
+{
+    if (GetNumWindQueries() == 0)
+    {
+        return;
+    }
+
+    // Free slots keep their last location; resolving them costs less than compacting around them
+    for (int32 Index = 0; Index < QuerySlots.Num(); Index++)
+    {
+        FWindQuerySlot& Slot = QuerySlots[Index];
+        if (!Slot.bActive)
         {
-            WindVelocity = Modifier->ModifyWindVelocity(WindVelocity, WorldLocation);
+            continue;
+        }
+        if (Slot.LocationProvider)
+        {
+            // Moved out of the slot while it runs: a provider may register or unregister queries,
+            // which can reallocate the slots or reset this one under it
+            const uint32 Serial = Slot.Serial;
+            TFunction<FVector()> Provider = MoveTemp(Slot.LocationProvider);
+            const FVector Location = Provider();
+            QueryLocations[Index] = Location;
+
+            FWindQuerySlot& Resolved = QuerySlots[Index];
+            if (Resolved.bActive && Resolved.Serial == Serial)
+            {
+                Resolved.LocationProvider = MoveTemp(Provider);
+            }
+        }
+        else if (const USceneComponent* Component = Slot.Component.Get())
+        {
+            QueryLocations[Index] = Component->GetComponentLocation();
         }
-        return WindVelocity;
     }
-    return FVector::ZeroVector;
+
+    GetWindVelocitiesAtLocations(QueryLocations, QueryResults);
+
+    for (int32 Index = 0; Index < QuerySlots.Num(); Index++)
+    {
+        const FWindQuerySlot& Slot = QuerySlots[Index];
+        if (!Slot.bActive || (!Slot.LocationProvider && !Slot.Component.IsValid()))
+        {
+            QueryResults[Index] = FVector::ZeroVector;
+        }
+    }
+}
+
+void UWindSimulationSubsystem::GetWindVelocitiesAtLocations(TConstArrayView<FVector> Locations, TArrayView<FVector> OutVelocities) const
+{
+    check(OutVelocities.Num() >= Locations.Num());
+    if (!WindSystemActor || !WindSystemActor->WindSimulationComponent)
+    {
+        for (int32 Index = 0; Index < Locations.Num(); Index++)
+        {
+            OutVelocities[Index] = FVector::ZeroVector;
+        }
+        return;
+    }
+
+    WindSystemActor->WindSimulationComponent->GetWindVelocitiesAtLocations(Locations, OutVelocities);
+    ApplyWindZones(Locations, OutVelocities);
+}
+
+void UWindSimulationSubsystem::GetWindVelocitiesAtLocationsLod(TConstArrayView<FVector> Locations, float Footprint, TArrayView<FVector> OutVelocities) const
+{
+    check(OutVelocities.Num() >= Locations.Num());
+    if (!WindSystemActor || !WindSystemActor->WindSimulationComponent)
+    {
+        for (int32 Index = 0; Index < Locations.Num(); Index++)
+        {
+            OutVelocities[Index] = FVector::ZeroVector;
+        }
+        return;
+    }
+
+    WindSystemActor->WindSimulationComponent->GetWindVelocitiesAtLocationsLod(Locations, Footprint, OutVelocities);
+    ApplyWindZones(Locations, OutVelocities);
+}
+
+void UWindSimulationSubsystem::ApplyWindZones(TConstArrayView<FVector> Locations, TArrayView<FVector> OutVelocities) const
+{
+    // Points inside the grid had the zones applied through the simulation's mask. The rest go
+    // cell by cell, then zone by zone over the points of the cell, which applies the zones to each
+    // point in the same order as the single-point query.
+    const TRefCountPtr<FWindSnapshot> Snapshot = WindSystemActor->WindSimulationComponent->GetSnapshot();
+    const FWindZoneMask* Mask = Snapshot.IsValid() ? Snapshot->ZoneMask.Get() : nullptr;
+    TArray<int32> Uncovered;
+    ZoneIndex.ForEachCell(Locations, [this, Locations, OutVelocities, Mask, &Uncovered](TConstArrayView<int32> PointIndices, TConstArrayView<int32> CandidateIds)
+    {
+        if (Mask)
+        {
+            Uncovered.Reset();
+            for (const int32 PointIndex : PointIndices)
+            {
+                if (Mask->GetCellAt(Locations[PointIndex]) == INDEX_NONE)
+                {
+                    Uncovered.Add(PointIndex);
+                }
+            }
+            PointIndices = Uncovered;
+        }
+
+        for (const int32 ZoneId : CandidateIds)
+        {
+            WindZones[ZoneId]->ModifyWindVelocities(PointIndices, Locations, OutVelocities);
+        }
+    });
 }
 
 void UWindSimulationSubsystem::AddWindAtLocation(const FVector& Location, const FVector& WindVelocity)
@@ -77,16 +362,26 @@ void UWindSimulationSubsystem::AddWindAtLocation(const FVector& Location, const
     }
 }
 
+void UWindSimulationSubsystem::AddWindAtLocations(TArray<FWindInjection> Injections)
+{
+    if (WindSystemActor && WindSystemActor->WindSimulationComponent)
+    {
+        WindSystemActor->WindSimulationComponent->AddWindAtLocations(MoveTemp(Injections));
+    }
+}
+
 void UWindSimulationSubsystem::RegisterWindGenerator(UWindGeneratorComponent* WindGenerator)
 {
     FScopeLock Lock(&GeneratorsLock);
-    WindGenerators.AddUnique(WindGenerator);
+    PendingGeneratorRemovals.Remove(WindGenerator);
+    PendingGeneratorAdds.AddUnique(WindGenerator);
 }
 
 void UWindSimulationSubsystem::UnregisterWindGenerator(UWindGeneratorComponent* WindGenerator)
 {
     FScopeLock Lock(&GeneratorsLock);
-    WindGenerators.Remove(WindGenerator);
+    PendingGeneratorAdds.Remove(WindGenerator);
+    PendingGeneratorRemovals.AddUnique(WindGenerator);
 }
 
 void UWindSimulationSubsystem::RegisterWindGridCenter(AActor* GridCenter)
@@ -113,23 +408,168 @@ FVector UWindSimulationSubsystem::GetGridCenter() const
 
 void UWindSimulationSubsystem::RegisterWindZone(UWindZoneVolumeComponent* Modifier)
 {
-    WindZones.AddUnique(Modifier);
+    if (Modifier && !WindZones.Contains(Modifier))
+    {
+        ZoneIndex.Update(WindZones.Add(Modifier), Modifier->GetZoneBounds());
+        bZoneMaskDirty = true;
+    }
 }
 
 void UWindSimulationSubsystem::UnregisterWindZone(UWindZoneVolumeComponent* Modifier)
 {
-    WindZones.Remove(Modifier);
+    // Ids after the removed zone shift down. Zones come and go rarely enough to rebuild.
+    if (WindZones.Remove(Modifier) > 0)
+    {
+        RebuildZoneIndex();
+        bZoneMaskDirty = true;
+    }
 }
 
-void UWindSimulationSubsystem::UpdateWindGenerators(float DeltaTime)
+void UWindSimulationSubsystem::UpdateWindZone(UWindZoneVolumeComponent* Modifier)
+{
+    const int32 ZoneId = WindZones.Find(Modifier);
+    if (ZoneId != INDEX_NONE)
+    {
+        ZoneIndex.Update(ZoneId, Modifier->GetZoneBounds());
+        bZoneMaskDirty = true;
+    }
+}
+
+void UWindSimulationSubsystem::UpdateZoneMask()
+{
+    UWindSimulationComponent* Simulation = WindSystemActor ? WindSystemActor->WindSimulationComponent : nullptr;
+    const TRefCountPtr<FWindSnapshot> Snapshot = Simulation ? Simulation->GetSnapshot() : TRefCountPtr<FWindSnapshot>();
+    if (!Snapshot.IsValid() || !Snapshot->IsValid())
+    {
+        return;
+    }
+
+    const bool bAligned = ZoneMask.IsValid() && ZoneMask->IsAlignedWith(Snapshot->Origin, Snapshot->Dimensions, Snapshot->CellSpacing);
+    if (!bZoneMaskDirty && (bAligned || !ZoneMask.IsValid()))
+    {
+        return;
+    }
+    bZoneMaskDirty = false;
+
+    if (WindZones.Num() == 0)
+    {
+        ZoneMask.Reset();
+        Simulation->SetZoneMask(nullptr);
+        return;
+    }
+
+    // A new mask every time: the simulation and published snapshots may still hold the old one
+    TSharedPtr<FWindZoneMask> Mask = MakeShared<FWindZoneMask>();
+    Mask->Initialize(Snapshot->Origin, Snapshot->Dimensions, Snapshot->CellSpacing);
+    for (const UWindZoneVolumeComponent* Zone : WindZones)
+    {
+        Mask->AddZone(Zone->GetComponentTransform(), Zone->GetUnscaledBoxExtent(), Zone->GetZoneModifier());
+    }
+    Mask->Finalize();
+    ZoneMask = Mask;
+    Simulation->SetZoneMask(Mask);
+}
+
+void UWindSimulationSubsystem::RebuildZoneIndex()
+{
+    ZoneIndex.Reset();
+    for (int32 ZoneId = 0; ZoneId < WindZones.Num(); ZoneId++)
+    {
+        ZoneIndex.Update(ZoneId, WindZones[ZoneId]->GetZoneBounds());
+    }
+}
+
+void UWindSimulationSubsystem::ApplyGeneratorChanges()
 {
     FScopeLock Lock(&GeneratorsLock);
+    for (UWindGeneratorComponent* WindGenerator : PendingGeneratorRemovals)
+    {
+        WindGenerators.Remove(WindGenerator);
+    }
+    for (UWindGeneratorComponent* WindGenerator : PendingGeneratorAdds)
+    {
+        WindGenerators.AddUnique(WindGenerator);
+    }
+    PendingGeneratorRemovals.Reset();
+    PendingGeneratorAdds.Reset();
+}
+
+void UWindSimulationSubsystem::UpdateWindGenerators(float DeltaTime)
+{
+    ApplyGeneratorChanges();
+
+    if (!WindSystemActor || !WindSystemActor->WindSimulationComponent)
+    {
+        return;
+    }
+
+    UWindSimulationComponent* Simulation = WindSystemActor->WindSimulationComponent;
+    const TRefCountPtr<FWindSnapshot> Snapshot = Simulation->GetSnapshot();
+    if (!Snapshot.IsValid() || !Snapshot->IsValid())
+    {
+        return;
+    }
+
+    DueGenerators.Reset();
     for (UWindGeneratorComponent* WindGenerator : WindGenerators)
     {
-        if (WindGenerator && WindGenerator->IsActive())
+        if (WindGenerator && WindGenerator->IsActive() && WindGenerator->ConsumeUpdate(DeltaTime))
+        {
+            DueGenerators.Add(WindGenerator);
+        }
+    }
+    if (DueGenerators.Num() == 0)
+    {
+        return;
+    }
+
+    // The simulation may still hold the last batch if it has not stepped since
+    if (!GeneratorForcing.IsValid() || !GeneratorForcing.IsUnique())
+    {
+        GeneratorForcing = MakeShared<FWindForcingGrid>();
+    }
+    GeneratorForcing->Initialize(Snapshot->Origin, Snapshot->Dimensions, Snapshot->CellSpacing);
+
+    const int32 MaxWorkers = GetDefault<UWindSystemSettings>()->GeneratorWorkers;
+    const int32 AvailableWorkers = MaxWorkers > 0 ? MaxWorkers : FTaskGraphInterface::Get().GetNumWorkerThreads() + 1;
+    const int32 NumWorkers = FMath::Clamp(FMath::DivideAndRoundUp(DueGenerators.Num(), WindSubsystemConstants::MinGeneratorsPerWorker), 1, AvailableWorkers);
+
+    WorkerForcing.SetNum(NumWorkers - 1);
+    for (FWindForcingGrid& Forcing : WorkerForcing)
+    {
+        Forcing.Initialize(Snapshot->Origin, Snapshot->Dimensions, Snapshot->CellSpacing);
+    }
+
+    // Fixed contiguous runs rather than work stealing, so every generator lands in the same
+    // buffer each update and the reduced forcing does not depend on scheduling
+    auto RasterizeRun = [this, NumWorkers](int32 Worker)
+    {
+        FWindForcingGrid& Forcing = Worker == 0 ? *GeneratorForcing : WorkerForcing[Worker - 1];
+        const int32 Begin = DueGenerators.Num() * Worker / NumWorkers;
+        const int32 End = DueGenerators.Num() * (Worker + 1) / NumWorkers;
+        for (int32 Index = Begin; Index < End; Index++)
         {
-            WindGenerator->UpdateWindSimulation(DeltaTime, this);
+            DueGenerators[Index]->RasterizeWind(Forcing);
         }
+    };
+
+    TArray<UE::Tasks::FTask> Workers;
+    for (int32 Worker = 1; Worker < NumWorkers; Worker++)
+    {
+        Workers.Add(UE::Tasks::Launch(UE_SOURCE_LOCATION, [&RasterizeRun, Worker]() { RasterizeRun(Worker); }));
+    }
+    RasterizeRun(0);
+    UE::Tasks::Wait(Workers);
+
+    // Each buffer only adds back the box its generators touched
+    for (const FWindForcingGrid& Forcing : WorkerForcing)
+    {
+        GeneratorForcing->Accumulate(Forcing);
+    }
+
+    if (!GeneratorForcing->IsEmpty())
+    {
+        Simulation->AddWindField(GeneratorForcing);
     }
 }
 
@@ -1,36 +1,20 @@
 #include "WindSystemComponent.h"
-#include "Async/ParallelFor.h"
+#include "WindTileGraph.h"
 #include "Math/UnrealMathSSE.h"
 #include "WindSystemCommon.h"
+#include "WindSystemDataAsset.h"
 #include "Misc/ScopeLock.h"
+#include "HAL/PlatformTime.h"
+#include "WindForcingGrid.h"
+#include "WindZoneMask.h"
+#include "WindVelocityDerivatives.h"
+#include "WindStreamlines.h"
 
-FWindGrid::FWindGrid(int32 Size, float InCellSize)
-    : GridSize(Size), CellSize(InCellSize)
+namespace WindTurbulenceConstants
 {
-    Grid.SetNumZeroed(Size * Size * Size);
-}
-
-FORCEINLINE FVector FWindGrid::GetCell(int32 X, int32 Y, int32 Z) const
-{
-    return IsValidIndex(X, Y, Z) ? Grid[GetIndex(X, Y, Z)] : FVector::ZeroVector;
-}
-
-FORCEINLINE void FWindGrid::SetCell(int32 X, int32 Y, int32 Z, const FVector& Value)
-{
-    if (IsValidIndex(X, Y, Z))
-    {
-        Grid[GetIndex(X, Y, Z)] = Value;
-    }
-}
-
-FORCEINLINE int32 FWindGrid::GetIndex(int32 X, int32 Y, int32 Z) const
-{
-    return X + Y * GridSize + Z * GridSize * GridSize;
-}
-
-FORCEINLINE bool FWindGrid::IsValidIndex(int32 X, int32 Y, int32 Z) const
-{
-    return X >= 0 && X < GridSize && Y >= 0 && Y < GridSize && Z >= 0 && Z < GridSize;
+    const int32 NoiseResolution = 32;
+    const int32 NoiseLatticePeriod = 8;
+    const int32 NoiseSeed = 1337;
 }
 
 UWindSimulationComponent::UWindSimulationComponent()
@@ -40,6 +24,10 @@ UWindSimulationComponent::UWindSimulationComponent()
     CellSize = GetSettings()->CellSize; // Default value
     Viscosity = GetSettings()->Viscosity;
     SimulationFrequency = GetSettings()->SimulationFrequency;
+    SolverBackend = GetSettings()->SolverBackend;
+    TemporalSampling = GetSettings()->TemporalSampling;
+    WindSettingsAsset = nullptr;
+    SimulationTime = 0.0f;
     bAutoActivate = true;
 }
 
@@ -47,26 +35,15 @@ void UWindSimulationComponent::BeginPlay()
 {
     Super::BeginPlay();
     InitializeGrid();
-
-    SimulationWorker = new FWindSimulationWorker(this);
-    SimulationThread = FRunnableThread::Create(SimulationWorker, TEXT("WindSimulationThread"));
+    InitializeScheduler();
+    Scheduler->Start();
 }
 
 void UWindSimulationComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-    if (SimulationWorker)
+    if (Scheduler)
     {
-        SimulationWorker->Stop();
-        
-        if (SimulationThread)
-        {
-            SimulationThread->WaitForCompletion();
-            delete SimulationThread;
-            SimulationThread = nullptr;
-        }
-        
-        delete SimulationWorker;
-        SimulationWorker = nullptr;
+        Scheduler->Shutdown();
     }
 
     Super::EndPlay(EndPlayReason);
@@ -74,8 +51,9 @@ void UWindSimulationComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 
 void UWindSimulationComponent::UpdateGridCenter(const FVector& NewCenter)
 {
-    PreviousGridCenter = GridCenter;
-    GridCenter = NewCenter;
+    FScopeLock Lock(&InputLock);
+    GatherFrame.bHasGridCenter = true;
+    GatherFrame.GridCenter = NewCenter;
 }
 
 float UWindSimulationComponent::GetMaxAllowedWindVelocity() const
@@ -96,23 +74,115 @@ void UWindSimulationComponent::TickComponent(float DeltaTime, ELevelTick TickTyp
 
 void UWindSimulationComponent::InitializeGrid()
 {
-    if (WindGrid)
+    if (Solver)
     {
         WINDSYSTEM_LOG(Warning, TEXT("WindGrid is already initialized. Skipping initialization."));
         return;
     }
 
-    WindGrid = MakeShared<FWindGrid>(GridSize, CellSize);
-    TempGrid = MakeShared<FWindGrid>(GridSize, CellSize);
+    Solver = WindSolverBackend::Create(SolverBackend);
+    Solver->Initialize(MakeSolverConfig());
+
+    if (!WindSettingsAsset)
+    {
+        WindSettingsAsset = GetSettings()->WindSettingsAsset.LoadSynchronous();
+    }
+
+    TSharedPtr<FWindTurbulenceField> Field = MakeShared<FWindTurbulenceField>();
+    Field->Initialize(WindTurbulenceConstants::NoiseResolution, WindTurbulenceConstants::NoiseLatticePeriod, WindTurbulenceConstants::NoiseSeed);
+    TurbulenceField = Field;
+    SimulationTime = 0.0f;
+    PublishSnapshot();
 
-    // Initialize with zero values (already done in FWindGrid constructor)
-    WINDSYSTEM_LOG(Log, TEXT("Wind Simulation Grid Initialized: %d cells"), GridSize * GridSize * GridSize);
+    const FIntVector Dimensions = Solver->GetDimensions();
+    WINDSYSTEM_LOG(Log, TEXT("Wind Simulation Grid Initialized: %s backend, %d cells"), Solver->GetName(), Dimensions.X * Dimensions.Y * Dimensions.Z);
+}
+
+void UWindSimulationComponent::InitializeScheduler()
+{
+    if (Scheduler)
+    {
+        return;
+    }
+
+    const UWindSystemSettings* Settings = GetSettings();
+
+    Scheduler = MakeUnique<FWindSimulationScheduler>();
+    Scheduler->Configure(Settings->SchedulerMode, 1.0f / SimulationFrequency, [this](float StepTime)
+    {
+        SimulationStep(StepTime);
+    });
+
+    FWindSlicedStepFunctions SlicedStep;
+    SlicedStep.BeginStep = [this](float StepTime) { BeginSimulationStep(StepTime); };
+    SlicedStep.StepSlice = [this]() { return StepSimulationSlice(); };
+    SlicedStep.GetProgress = [this]() { return Solver.IsValid() ? Solver->GetStepProgress() : 1.0f; };
+    Scheduler->ConfigureTimeSlicing(MoveTemp(SlicedStep), Settings->TimeSliceBudgetMs, Settings->TimeSliceFramesPerStep);
+    Scheduler->ConfigurePipeline([this]() { SealInputFrame(); });
+    Scheduler->ConfigurePool(SimulationPriority, SimulationCpuBudget);
+}
+
+void UWindSimulationComponent::AdvanceSimulation(float DeltaTime, bool bPaused)
+{
+    InitializeScheduler();
+    Scheduler->Advance(DeltaTime, bPaused);
+}
+
+FWindSchedulerStats UWindSimulationComponent::GetSchedulerStats() const
+{
+    return Scheduler ? Scheduler->GetStats() : FWindSchedulerStats();
+}
+
+EWindSchedulerMode UWindSimulationComponent::GetSchedulerMode() const
+{
+    return Scheduler ? Scheduler->GetMode() : GetSettings()->SchedulerMode;
+}
+
+float UWindSimulationComponent::GetSimulationStepProgress() const
+{
+    return Scheduler ? Scheduler->GetStepProgress() : 1.0f;
+}
+
+FWindSolverConfig UWindSimulationComponent::MakeSolverConfig() const
+{
+    const UWindSystemSettings* Settings = GetSettings();
+
+    FWindSolverConfig Config;
+    Config.GridSize = GridSize;
+    Config.CellSize = CellSize;
+    Config.Viscosity = Viscosity;
+    Config.TimeStep = 1.0f / SimulationFrequency;
+    Config.MaxVelocity = GetMaxAllowedWindVelocity();
+    Config.NumBands = Settings->LayeredBandCount;
+    Config.BandHeight = Settings->LayeredBandHeight;
+    Config.VerticalExchange = Settings->LayeredVerticalExchange;
+    Config.SpongeWidth = Settings->SpongeLayerWidth;
+    Config.SpongeStrength = Settings->SpongeLayerStrength;
+    Config.bOpenBoundaries = Settings->bInflowOutflowBoundaries;
+    Config.TileSize = Settings->SolverTileSize;
+    Config.MaxTileWorkers = Settings->SolverTileWorkers;
+
+    // The layered backend spans a much larger area with its own horizontal resolution
+    if (SolverBackend == EWindSolverBackend::Layered)
+    {
+        Config.GridSize = Settings->LayeredGridResolution;
+        Config.CellSize = Settings->LayeredCellSize;
+    }
+
+    return Config;
+}
+
+FVector UWindSimulationComponent::GetAmbientWind() const
+{
+    const UWindSettingsDataAsset* Settings = WindSettingsAsset;
+    return Settings ? Settings->GlobalWindDirection.GetSafeNormal() * Settings->GlobalWindStrength : FVector::ZeroVector;
 }
 
 void UWindSimulationComponent::InitializeForTesting()
 {
     // Call the private InitializeGrid method
     InitializeGrid();
+    InitializeScheduler();
 
     // Perform any other initialization normally done in BeginPlay
     StartSimulation();
@@ -122,9 +192,26 @@ void UWindSimulationComponent::InitializeForTesting()
     WINDSYSTEM_LOG(Log, TEXT("Wind Simulation Component initialized for testing"));
 }
 
-void UWindSimulationComponent::SwapGrids()
+void UWindSimulationComponent::ResizeGrid(int32 NewGridSize, float NewCellSize)
 {
-    Swap(WindGrid, TempGrid);
+    FScopeLock Lock(&SimulationLock);
+    if (!IsGridInitialized())
+    {
+        WINDSYSTEM_LOG_ERROR(TEXT("WindGrid is not initialized"));
+        return;
+    }
+
+    if (NewGridSize < 3 || NewCellSize <= 0.0f)
+    {
+        WINDSYSTEM_LOG_ERROR(TEXT("Invalid grid resize: %d cells of %f"), NewGridSize, NewCellSize);
+        return;
+    }
+
+    GridSize = NewGridSize;
+    CellSize = NewCellSize;
+    Solver->Resize(NewGridSize, NewCellSize);
+    UpdateSolverZoneMask();
+    PublishSnapshot();
 }
 
 void UWindSimulationComponent::SimulationStep(float DeltaTime)
@@ -137,415 +224,457 @@ void UWindSimulationComponent::SimulationStep(float DeltaTime)
         return;
     }
 
-    HandleGridMovement();
-    // Use TempGrid for intermediate calculations
-    Diffuse(TempGrid, WindGrid, Viscosity, DeltaTime);
-    Project(TempGrid, MakeShared<FWindGrid>(WindGrid->GetSize(), WindGrid->GetCellSize()), MakeShared<FWindGrid>(WindGrid->GetSize(), WindGrid->GetCellSize()));
-    Advect(WindGrid, TempGrid, TempGrid, DeltaTime);
-    Project(WindGrid, MakeShared<FWindGrid>(WindGrid->GetSize(), WindGrid->GetCellSize()), MakeShared<FWindGrid>(WindGrid->GetSize(), WindGrid->GetCellSize()));
+    // Pipelined mode seals once per batch on the game thread, so only the batch's first step has
+    // inputs; the rest run on the cleared frame rather than reaching into the one being gathered
+    const bool bPipelined = Scheduler && Scheduler->GetMode() == EWindSchedulerMode::Pipelined;
+    if (!bInputFrameSealed && !bPipelined)
+    {
+        SealInputFrame();
+    }
+    ApplyInputFrame();
+
+    Solver->SetAmbientWind(GetAmbientWind());
+    Solver->Step(DeltaTime);
 
-    ApplySIMDOperations(WindGrid, DeltaTime);
+    SimulationTime += DeltaTime;
+    PublishSnapshot();
 
     // BroadcastWindUpdates();
 }
 
-void UWindSimulationComponent::HandleGridMovement()
+void UWindSimulationComponent::BeginSimulationStep(float DeltaTime)
 {
-        // Handle grid movement
-    FVector GridMovement = GridCenter - PreviousGridCenter;
-    if (!GridMovement.IsNearlyZero())
-    {
-        FVector GridMovementCells = GridMovement / CellSize;
-        int32 ShiftX = FMath::FloorToInt(GridMovementCells.X);
-        int32 ShiftY = FMath::FloorToInt(GridMovementCells.Y);
-        int32 ShiftZ = FMath::FloorToInt(GridMovementCells.Z);
-
-        TSharedPtr<FWindGrid> NewGrid = MakeShared<FWindGrid>(WindGrid->GetSize(), WindGrid->GetCellSize());
-        
-        for (int32 x = 0; x < WindGrid->GetSize(); ++x)
-        {
-            for (int32 y = 0; y < WindGrid->GetSize(); ++y)
-            {
-                for (int32 z = 0; z < WindGrid->GetSize(); ++z)
-                {
-                    int32 OldX = x - ShiftX;
-                    int32 OldY = y - ShiftY;
-                    int32 OldZ = z - ShiftZ;
+    FScopeLock Lock(&SimulationLock);
 
-                    if (WindGrid->IsValidIndex(OldX, OldY, OldZ))
-                    {
-                        NewGrid->SetCell(x, y, z, WindGrid->GetCell(OldX, OldY, OldZ));
-                    }
-                    else
-                    {
-                        NewGrid->SetCell(x, y, z, FVector::ZeroVector);
-                    }
-                }
-            }
-        }
+    if (!IsGridInitialized())
+    {
+        WINDSYSTEM_LOG_WARNING(TEXT("WindGrid is not initialized"));
+        return;
+    }
 
-        WindGrid = NewGrid;
+    if (!bInputFrameSealed)
+    {
+        SealInputFrame();
     }
+    ApplyInputFrame();
+
+    Solver->SetAmbientWind(GetAmbientWind());
+    Solver->BeginStep(DeltaTime);
+    SlicedStepTime = DeltaTime;
+    bSlicedStepInProgress = true;
 }
-void UWindSimulationComponent::Diffuse(TSharedPtr<FWindGrid> Dst, const TSharedPtr<FWindGrid> Src, float Diff, float Dt)
+
+bool UWindSimulationComponent::StepSimulationSlice()
 {
-    float a = Dt * Diff * (Src->GetSize() - 2) * (Src->GetSize() - 2);
-    int32 Size = Src->GetSize();
+    FScopeLock Lock(&SimulationLock);
 
-    ParallelFor(Size, [&](int32 K)
-        {
-            for (int32 J = 1; J < Size - 1; J++)
-            {
-                for (int32 I = 1; I < Size - 1; I++)
-                {
-                    FVector NewValue = (Src->GetCell(I, J, K) +
-                        a * (Src->GetCell(I - 1, J, K) + Src->GetCell(I + 1, J, K) +
-                            Src->GetCell(I, J - 1, K) + Src->GetCell(I, J + 1, K) +
-                            Src->GetCell(I, J, K - 1) + Src->GetCell(I, J, K + 1))) / (1 + 6 * a);
-                    Dst->SetCell(I, J, K, NewValue);
-                }
-            }
-        });
+    if (!bSlicedStepInProgress)
+    {
+        return true;
+    }
 
-    SetBoundary(Dst);
-}
+    if (IsGridInitialized() && !Solver->StepSlice())
+    {
+        return false;
+    }
 
-void UWindSimulationComponent::Project(TSharedPtr<FWindGrid> Velocity, TSharedPtr<FWindGrid> P, TSharedPtr<FWindGrid> Div)
-{
-    int32 Size = Velocity->GetSize();
-    double H = 1.0 / (Size - 2);
+    bSlicedStepInProgress = false;
+    if (!IsGridInitialized())
+    {
+        return true;
+    }
 
-    ParallelFor(Size, [&](int32 K)
-        {
-            for (int32 J = 1; J < Size - 1; J++)
-            {
-                for (int32 I = 1; I < Size - 1; I++)
-                {
-                    double DivValue = -0.5 * H * (
-                        Velocity->GetCell(I + 1, J, K).X - Velocity->GetCell(I - 1, J, K).X +
-                        Velocity->GetCell(I, J + 1, K).Y - Velocity->GetCell(I, J - 1, K).Y +
-                        Velocity->GetCell(I, J, K + 1).Z - Velocity->GetCell(I, J, K - 1).Z
-                        );
-                    Div->SetCell(I, J, K, FVector(DivValue));
-                    P->SetCell(I, J, K, FVector::ZeroVector);
-                }
-            }
-        });
+    SimulationTime += SlicedStepTime;
+    PublishSnapshot();
+    return true;
+}
 
-    SetBoundary(Div);
-    SetBoundary(P);
+void UWindSimulationComponent::SealInputFrame()
+{
+    FScopeLock Lock(&InputLock);
 
-    for (int32 K = 0; K < 20; K++)
+    // A sealed frame no step has consumed yet is left alone; gathering simply continues
+    if (bInputFrameSealed)
     {
-        ParallelFor(Size, [&](int32 K)
-            {
-                for (int32 J = 1; J < Size - 1; J++)
-                {
-                    for (int32 I = 1; I < Size - 1; I++)
-                    {
-                        double PValue = (Div->GetCell(I, J, K).X +
-                            P->GetCell(I - 1, J, K).X + P->GetCell(I + 1, J, K).X +
-                            P->GetCell(I, J - 1, K).X + P->GetCell(I, J + 1, K).X +
-                            P->GetCell(I, J, K - 1).X + P->GetCell(I, J, K + 1).X) / 6.0;
-                        P->SetCell(I, J, K, FVector(PValue));
-                    }
-                }
-            });
-        SetBoundary(P);
+        return;
     }
 
-    ParallelFor(Size, [&](int32 K)
-        {
-            for (int32 J = 1; J < Size - 1; J++)
-            {
-                for (int32 I = 1; I < Size - 1; I++)
-                {
-                    FVector Vel = Velocity->GetCell(I, J, K);
-                    Vel.X -= 0.5 * (P->GetCell(I + 1, J, K).X - P->GetCell(I - 1, J, K).X) / H;
-                    Vel.Y -= 0.5 * (P->GetCell(I, J + 1, K).X - P->GetCell(I, J - 1, K).X) / H;
-                    Vel.Z -= 0.5 * (P->GetCell(I, J, K + 1).X - P->GetCell(I, J, K - 1).X) / H;
-                    Velocity->SetCell(I, J, K, Vel);
-                }
-            }
-        });
+    InjectionQueue.Drain(GatherFrame.Injections, GatherFrame.Fields);
 
-    SetBoundary(Velocity);
+    // The consumed frame comes back empty and keeps its storage for the next round of gathering
+    Swap(GatherFrame, SolveFrame);
+    GatherFrame.Reset();
+    bInputFrameSealed = true;
 }
 
-void UWindSimulationComponent::SetBoundary(TSharedPtr<FWindGrid> Field)
+void UWindSimulationComponent::ApplyInputFrame()
 {
-    int32 Size = Field->GetSize();
-
-    ParallelFor(Size, [&](int32 I)
+    PreviousGridCenter = GridCenter;
+    if (SolveFrame.bHasGridCenter)
     {
-        for (int32 J = 1; J < Size - 1; J++)
-        {
-            Field->SetCell(I, J, 0, Field->GetCell(I, J, 1));
-            Field->SetCell(I, J, Size - 1, Field->GetCell(I, J, Size - 2));
-        }
-    });
+        // Snapped to whole cells, so every move shifts the solver, the forcing and the zone mask
+        // by exact cell offsets and a mask voxelized before the move can still be lined up
+        const FVector CellSpacing = Solver->GetCellSpacing();
+        GridCenter = FVector(
+            FMath::RoundToDouble(SolveFrame.GridCenter.X / CellSpacing.X) * CellSpacing.X,
+            FMath::RoundToDouble(SolveFrame.GridCenter.Y / CellSpacing.Y) * CellSpacing.Y,
+            FMath::RoundToDouble(SolveFrame.GridCenter.Z / CellSpacing.Z) * CellSpacing.Z);
+    }
+    HandleGridMovement();
 
-    ParallelFor(Size, [&](int32 K)
+    if (SolveFrame.bHasZoneMask)
     {
-        for (int32 I = 1; I < Size - 1; I++)
-        {
-            Field->SetCell(I, 0, K, Field->GetCell(I, 1, K));
-            Field->SetCell(I, Size - 1, K, Field->GetCell(I, Size - 2, K));
-        }
-    });
+        ZoneMask = SolveFrame.ZoneMask;
+    }
+    UpdateSolverZoneMask();
 
-    ParallelFor(Size, [&](int32 J)
+    int32 NumOutside = 0;
+    for (const FWindObstacleEdit& Edit : SolveFrame.ObstacleEdits)
     {
-        for (int32 K = 1; K < Size - 1; K++)
+        if (!Solver->SetSolid(Edit.Location - GridCenter, Edit.bIsObstacle))
         {
-            Field->SetCell(0, J, K, Field->GetCell(1, J, K));
-            Field->SetCell(Size - 1, J, K, Field->GetCell(Size - 2, J, K));
+            NumOutside++;
         }
-    });
+    }
+    if (NumOutside > 0)
+    {
+        WINDSYSTEM_LOG_WARNING(TEXT("%d obstacles were set outside the grid bounds"), NumOutside);
+    }
+
+    ApplyQueuedWind();
 
-    // Set corner values
-    Field->SetCell(0, 0, 0, (Field->GetCell(1, 0, 0) + Field->GetCell(0, 1, 0) + Field->GetCell(0, 0, 1)) / 3.0f);
-    Field->SetCell(0, Size - 1, 0, (Field->GetCell(1, Size - 1, 0) + Field->GetCell(0, Size - 2, 0) + Field->GetCell(0, Size - 1, 1)) / 3.0f);
-    Field->SetCell(0, 0, Size - 1, (Field->GetCell(1, 0, Size - 1) + Field->GetCell(0, 1, Size - 1) + Field->GetCell(0, 0, Size - 2)) / 3.0f);
-    Field->SetCell(0, Size - 1, Size - 1, (Field->GetCell(1, Size - 1, Size - 1) + Field->GetCell(0, Size - 2, Size - 1) + Field->GetCell(0, Size - 1, Size - 2)) / 3.0f);
-    Field->SetCell(Size - 1, 0, 0, (Field->GetCell(Size - 2, 0, 0) + Field->GetCell(Size - 1, 1, 0) + Field->GetCell(Size - 1, 0, 1)) / 3.0f);
-    Field->SetCell(Size - 1, Size - 1, 0, (Field->GetCell(Size - 2, Size - 1, 0) + Field->GetCell(Size - 1, Size - 2, 0) + Field->GetCell(Size - 1, Size - 1, 1)) / 3.0f);
-    Field->SetCell(Size - 1, 0, Size - 1, (Field->GetCell(Size - 2, 0, Size - 1) + Field->GetCell(Size - 1, 1, Size - 1) + Field->GetCell(Size - 1, 0, Size - 2)) / 3.0f);
-    Field->SetCell(Size - 1, Size - 1, Size - 1, (Field->GetCell(Size - 2, Size - 1, Size - 1) + Field->GetCell(Size - 1, Size - 2, Size - 1) + Field->GetCell(Size - 1, Size - 1, Size - 2)) / 3.0f);
+    SolveFrame.Reset();
+    bInputFrameSealed = false;
 }
 
-void UWindSimulationComponent::Advect(TSharedPtr<FWindGrid> Dst, const TSharedPtr<FWindGrid> Src, const TSharedPtr<FWindGrid> Velocity, float Dt)
+void UWindSimulationComponent::UpdateSolverZoneMask()
 {
-    int32 Size = Src->GetSize();
-    float Dt0 = Dt * (Size - 2);
+    // A mask voxelized before the grid moved is shifted along with the solver's contents, so the
+    // zones keep applying while the grid follows its center. Only the cells that moved in are
+    // uncovered until the subsystem voxelizes again against the next snapshot.
+    const FIntVector Dimensions = Solver->GetDimensions();
+    const FVector CellSpacing = Solver->GetCellSpacing();
+    FIntVector CellOffset;
+    if (ZoneMask.IsValid() && !ZoneMask->IsAlignedWith(GridCenter, Dimensions, CellSpacing) && ZoneMask->GetShiftTo(GridCenter, Dimensions, CellSpacing, CellOffset))
+    {
+        // Masks are shared with published snapshots, so the shifted one is a copy
+        TSharedPtr<FWindZoneMask> Shifted = MakeShared<FWindZoneMask>(*ZoneMask);
+        Shifted->Shift(CellOffset);
+        ZoneMask = Shifted;
+    }
+
+    // One voxelized for another size or spacing would apply the zones to the wrong cells
+    const bool bAligned = ZoneMask.IsValid() && ZoneMask->IsAlignedWith(GridCenter, Dimensions, CellSpacing);
+    Solver->SetZoneMask(bAligned ? ZoneMask : nullptr);
+}
 
-    ParallelFor(Size, [&](int32 K)
+void UWindSimulationComponent::HandleGridMovement()
+{
+    // Handle grid movement. The center moves by whole cells, and the wind stays where it is in
+    // the world, so the solver's contents move against the grid.
+    FVector GridMovement = GridCenter - PreviousGridCenter;
+    if (!GridMovement.IsNearlyZero())
     {
-        for (int32 J = 1; J < Size - 1; J++)
-        {
-            for (int32 I = 1; I < Size - 1; I++)
-            {
-                FVector Pos = FVector(I, J, K) - Dt0 * Velocity->GetCell(I, J, K);
-                
-                Pos.X = FMath::Clamp(Pos.X, 0.5f, Size - 1.5f);
-                int32 I0 = FMath::FloorToInt(Pos.X);
-                int32 I1 = I0 + 1;
-                
-                Pos.Y = FMath::Clamp(Pos.Y, 0.5f, Size - 1.5f);
-                int32 J0 = FMath::FloorToInt(Pos.Y);
-                int32 J1 = J0 + 1;
-                
-                Pos.Z = FMath::Clamp(Pos.Z, 0.5f, Size - 1.5f);
-                int32 K0 = FMath::FloorToInt(Pos.Z);
-                int32 K1 = K0 + 1;
-
-                float S1 = Pos.X - I0;
-                float S0 = 1 - S1;
-                float T1 = Pos.Y - J0;
-                float T0 = 1 - T1;
-                float U1 = Pos.Z - K0;
-                float U0 = 1 - U1;
-
-                Dst->SetCell(I, J, K,
-                    S0 * (T0 * (U0 * Src->GetCell(I0, J0, K0) + U1 * Src->GetCell(I0, J0, K1)) +
-                          T1 * (U0 * Src->GetCell(I0, J1, K0) + U1 * Src->GetCell(I0, J1, K1))) +
-                    S1 * (T0 * (U0 * Src->GetCell(I1, J0, K0) + U1 * Src->GetCell(I1, J0, K1)) +
-                          T1 * (U0 * Src->GetCell(I1, J1, K0) + U1 * Src->GetCell(I1, J1, K1)))
-                );
-            }
-        }
-    });
+        FVector GridMovementCells = GridMovement / Solver->GetCellSpacing();
+        FIntVector Shift(
+            -FMath::RoundToInt32(GridMovementCells.X),
+            -FMath::RoundToInt32(GridMovementCells.Y),
+            -FMath::RoundToInt32(GridMovementCells.Z));
 
-    SetBoundary(Dst);
+        Solver->Shift(Shift);
+    }
 }
 
-void UWindSimulationComponent::ApplySIMDOperations(TSharedPtr<FWindGrid> Grid, float DeltaTime)
+FWindQueryView UWindSimulationComponent::MakeQueryView() const
 {
-    if (!Grid)
+    FWindQueryTurbulence Turbulence;
+    if (const UWindSettingsDataAsset* Settings = WindSettingsAsset)
     {
-        WINDSYSTEM_LOG_ERROR(TEXT("ApplySIMDOperations: Grid is null"));
-        return;
+        Turbulence.Field = TurbulenceField;
+        Turbulence.Strength = Settings->TurbulenceStrength;
+        Turbulence.Frequency = Settings->TurbulenceFrequency;
+        Turbulence.GlobalWindDirection = Settings->GlobalWindDirection;
+        Turbulence.GlobalWindStrength = Settings->GlobalWindStrength;
     }
+    return FWindQueryView(Snapshots.Acquire(), Turbulence, TemporalSampling);
+}
 
-    int32 Size = Grid->GetSize();
-    int32 TotalCells = Size * Size * Size;
-    int32 VectorCount = TotalCells / 4; // Number of 4-wide vectors
+FWindQueryView UWindSimulationComponent::MakeCheckedQueryView() const
+{
+    FWindQueryView View = MakeQueryView();
+    if (!View.IsValid())
+    {
+        WINDSYSTEM_LOG_ERROR(TEXT("WindGrid is not initialized"));
+    }
+    return View;
+}
 
-    TArray<FVector>& GridData = Grid->GetGridData();
-    
-    // Convert DeltaTime to a vector for SIMD operations
-    VectorRegister4Float DeltaTimeVec = VectorSetFloat1(DeltaTime);
-    
-    // Constants for clamping
-    VectorRegister4Float MaxSpeedVec = VectorSetFloat1(1000.0f); // Maximum allowed wind speed
-    VectorRegister4Float MinSpeedVec = VectorSetFloat1(-1000.0f); // Minimum allowed wind speed
+FVector UWindSimulationComponent::GetWindVelocityAtLocation(const FVector& Location) const
+{
+    return MakeCheckedQueryView().GetWindVelocityAtLocation(Location);
+}
 
-    // Process 4 vectors at a time using SIMD
-    for (int32 i = 0; i < VectorCount; i++)
-    {
-        // Load 4 FVector's (12 floats) into 3 SIMD vectors
-        VectorRegister4Float* VectorPtr = reinterpret_cast<VectorRegister4Float*>(&GridData[i * 4]);
-        VectorRegister4Float Vx = VectorPtr[0];
-        VectorRegister4Float Vy = VectorPtr[1];
-        VectorRegister4Float Vz = VectorPtr[2];
+void UWindSimulationComponent::GetWindVelocitiesAtLocations(TConstArrayView<FVector> Locations, TArrayView<FVector> OutVelocities) const
+{
+    // One snapshot, alpha and turbulence setup for the whole batch
+    MakeCheckedQueryView().GetWindVelocitiesAtLocations(Locations, OutVelocities);
+}
 
-        // Apply decay (simulate drag)
-        const VectorRegister4Float DecayFactor = VectorSetFloat1(0.99f);
-        Vx = VectorMultiply(Vx, DecayFactor);
-        Vy = VectorMultiply(Vy, DecayFactor);
-        Vz = VectorMultiply(Vz, DecayFactor);
+FVector UWindSimulationComponent::GetWindVelocityAtLocationLod(const FVector& Location, float Footprint) const
+{
+    return MakeCheckedQueryView().GetWindVelocityAtLocationLod(Location, Footprint);
+}
 
-        // Apply some force (e.g., global wind)
-        const VectorRegister4Float GlobalWindForce = VectorSetFloat1(0.1f);
-        Vx = VectorAdd(Vx, VectorMultiply(GlobalWindForce, DeltaTimeVec));
+void UWindSimulationComponent::GetWindVelocitiesAtLocationsLod(TConstArrayView<FVector> Locations, float Footprint, TArrayView<FVector> OutVelocities) const
+{
+    MakeCheckedQueryView().GetWindVelocitiesAtLocationsLod(Locations, Footprint, OutVelocities);
+}
 
-        // Clamp velocities to prevent extreme values
-        Vx = VectorMin(VectorMax(Vx, MinSpeedVec), MaxSpeedVec);
-        Vy = VectorMin(VectorMax(Vy, MinSpeedVec), MaxSpeedVec);
-        Vz = VectorMin(VectorMax(Vz, MinSpeedVec), MaxSpeedVec);
+FVector UWindSimulationComponent::GetAverageWindInBox(const FBox& Box) const
+{
+    return MakeCheckedQueryView().GetAverageWindInBox(Box);
+}
 
-        // Store the results back
-        VectorPtr[0] = Vx;
-        VectorPtr[1] = Vy;
-        VectorPtr[2] = Vz;
-    }
+FWindVelocityDerivatives UWindSimulationComponent::GetWindDerivativesAtLocation(const FVector& Location) const
+{
+    return MakeCheckedQueryView().GetWindDerivativesAtLocation(Location);
+}
 
-    // Handle remaining elements (if any)
-    for (int32 i = VectorCount * 4; i < TotalCells; i++)
-    {
-        FVector& WindVelocity = GridData[i];
-        
-        // Apply decay
-        WindVelocity *= 0.99f;
-        
-        // Apply global wind force
-        WindVelocity.X += 0.1f * DeltaTime;
-        
-        // Clamp velocity
-        WindVelocity.X = FMath::Clamp(WindVelocity.X, -1000.0f, 1000.0f);
-        WindVelocity.Y = FMath::Clamp(WindVelocity.Y, -1000.0f, 1000.0f);
-        WindVelocity.Z = FMath::Clamp(WindVelocity.Z, -1000.0f, 1000.0f);
-    }
+void UWindSimulationComponent::GetWindDerivativesAtLocations(TConstArrayView<FVector> Locations, TArrayView<FWindVelocityDerivatives> OutDerivatives) const
+{
+    MakeCheckedQueryView().GetWindDerivativesAtLocations(Locations, OutDerivatives);
 }
 
-FVector UWindSimulationComponent::GetWindVelocityAtLocation(const FVector& Location) const
+void UWindSimulationComponent::TraceWindStreamlines(TConstArrayView<FVector> Seeds, const FWindTraceSettings& Settings, TArrayView<FVector> OutPoints) const
 {
-    FScopeLock Lock(&SimulationLock);
+    MakeCheckedQueryView().TraceWindStreamlines(Seeds, Settings, OutPoints);
+}
 
-    if (!IsGridInitialized())
+void UWindSimulationComponent::PublishSnapshot()
+{
+    const TRefCountPtr<FWindSnapshot> Latest = Snapshots.Acquire();
+
+    TRefCountPtr<FWindSnapshot> Snapshot = Snapshots.BeginWrite();
+    Snapshot->Origin = GridCenter;
+    Snapshot->Dimensions = Solver->GetDimensions();
+    Snapshot->CellSpacing = Solver->GetCellSpacing();
+    Snapshot->SimulationTime = SimulationTime;
+    Solver->ExportVelocity(Snapshot->Velocity);
+    Snapshot->ZoneMask = Solver->GetZoneMask();
+    const int32 MaxWorkers = Solver->GetConfig().MaxTileWorkers;
+    Snapshot->BuildMipLevels(MaxWorkers);
+    Snapshot->BuildVelocitySums(MaxWorkers);
+    UpdateTurbulenceEnergy(*Snapshot);
+
+    // Keep the outgoing step alongside so queries can blend across it. Only a reference: the
+    // outgoing snapshot is immutable and stays alive for as long as this one holds it.
+    Snapshot->PublishTime = FPlatformTime::Seconds();
+    const bool bKeepPrevious = TemporalSampling != EWindTemporalSampling::Latest && Latest.IsValid() && Latest->IsValid()
+        && Latest->Dimensions == Snapshot->Dimensions && Latest->CellSpacing.Equals(Snapshot->CellSpacing);
+    if (bKeepPrevious)
     {
-        WINDSYSTEM_LOG_ERROR(TEXT("WindGrid is not initialized"));
-        return FVector::ZeroVector;
+        Snapshot->SetPrevious(Latest);
+        Snapshot->PublishInterval = Snapshot->PublishTime - Latest->PublishTime;
+    }
+    else
+    {
+        Snapshot->SetPrevious(nullptr);
+        Snapshot->PublishInterval = 0.0;
     }
 
-    FVector LocalPos = Location - GridCenter;
-    FVector GridPos = LocalPos / WindGrid->GetCellSize();
-
-    return InterpolateVelocity(GridPos);
+    Snapshots.Publish(MoveTemp(Snapshot));
 }
 
-FVector UWindSimulationComponent::InterpolateVelocity(const FVector& Position) const
+void UWindSimulationComponent::UpdateTurbulenceEnergy(FWindSnapshot& Snapshot) const
 {
-    int32 Size = WindGrid->GetSize();
-    int32 X0 = FMath::FloorToInt(Position.X);
-    int32 Y0 = FMath::FloorToInt(Position.Y);
-    int32 Z0 = FMath::FloorToInt(Position.Z);
-    int32 X1 = FMath::Min(X0 + 1, Size - 1);
-    int32 Y1 = FMath::Min(Y0 + 1, Size - 1);
-    int32 Z1 = FMath::Min(Z0 + 1, Size - 1);
+    // Per-cell kinetic energy averaged over the 7-point neighbourhood, which includes the local
+    // velocity variance the grid cannot resolve on its own
+    const FIntVector Dimensions = Snapshot.Dimensions;
+    const TArray<FVector>& ExportedVelocity = Snapshot.Velocity;
+    TArray<float>& TurbulenceEnergy = Snapshot.TurbulenceEnergy;
+    if (!Snapshot.IsValid())
+    {
+        TurbulenceEnergy.Reset();
+        return;
+    }
+
+    TurbulenceEnergy.SetNumUninitialized(ExportedVelocity.Num());
 
-    float Sx = Position.X - X0;
-    float Sy = Position.Y - Y0;
-    float Sz = Position.Z - Z0;
+    const FIntVector Offsets[6] = { {-1, 0, 0}, {1, 0, 0}, {0, -1, 0}, {0, 1, 0}, {0, 0, -1}, {0, 0, 1} };
+    auto GetIndex = [&Dimensions](int32 I, int32 J, int32 K) { return I + J * Dimensions.X + K * Dimensions.X * Dimensions.Y; };
+
+    FWindTileGraph::ParallelForWorkers(Dimensions.Z, Solver->GetConfig().MaxTileWorkers, [&](int32 K)
+    {
+        for (int32 J = 0; J < Dimensions.Y; J++)
+        {
+            for (int32 I = 0; I < Dimensions.X; I++)
+            {
+                float SumSquared = ExportedVelocity[GetIndex(I, J, K)].SizeSquared();
+                int32 Count = 1;
 
-    FVector C000 = WindGrid->GetCell(X0, Y0, Z0);
-    FVector C100 = WindGrid->GetCell(X1, Y0, Z0);
-    FVector C010 = WindGrid->GetCell(X0, Y1, Z0);
-    FVector C110 = WindGrid->GetCell(X1, Y1, Z0);
-    FVector C001 = WindGrid->GetCell(X0, Y0, Z1);
-    FVector C101 = WindGrid->GetCell(X1, Y0, Z1);
-    FVector C011 = WindGrid->GetCell(X0, Y1, Z1);
-    FVector C111 = WindGrid->GetCell(X1, Y1, Z1);
+                for (const FIntVector& Offset : Offsets)
+                {
+                    const int32 NI = I + Offset.X;
+                    const int32 NJ = J + Offset.Y;
+                    const int32 NK = K + Offset.Z;
+                    if (NI >= 0 && NI < Dimensions.X && NJ >= 0 && NJ < Dimensions.Y && NK >= 0 && NK < Dimensions.Z)
+                    {
+                        SumSquared += ExportedVelocity[GetIndex(NI, NJ, NK)].SizeSquared();
+                        Count++;
+                    }
+                }
 
-    return FMath::Lerp(
-        FMath::Lerp(
-            FMath::Lerp(C000, C100, Sx),
-            FMath::Lerp(C010, C110, Sx),
-            Sy),
-        FMath::Lerp(
-            FMath::Lerp(C001, C101, Sx),
-            FMath::Lerp(C011, C111, Sx),
-            Sy),
-        Sz
-    );
+                TurbulenceEnergy[GetIndex(I, J, K)] = 0.5f * SumSquared / Count;
+            }
+        }
+    });
 }
 
 void UWindSimulationComponent::AddWindAtLocation(const FVector& Location, const FVector& WindVelocity)
 {
-    FScopeLock Lock(&SimulationLock);
-    if (!IsGridInitialized())
+    if (!IsVectorFinite(WindVelocity))
     {
-        WINDSYSTEM_LOG_ERROR(TEXT("WindGrid is not initialized"));
+        WINDSYSTEM_LOG_ERROR(TEXT("Invalid wind velocity provided: %s"), *WindVelocity.ToString());
         return;
     }
 
-    if (!IsVectorFinite(WindVelocity))
+    // Lock-free; the wind reaches the solver at the start of the next step
+    InjectionQueue.Push(Location, WindVelocity);
+    WINDSYSTEM_LOG_VERBOSE(TEXT("Wind queued at location: Pos=%s, Velocity=%s"),
+        *Location.ToString(), *WindVelocity.ToString());
+}
+
+void UWindSimulationComponent::AddWindAtLocations(TArray<FWindInjection> Injections)
+{
+    const int32 NumInvalid = Injections.RemoveAll([](const FWindInjection& Injection) { return !IsVectorFinite(Injection.Velocity); });
+    if (NumInvalid > 0)
     {
-        WINDSYSTEM_LOG_ERROR(TEXT("Invalid wind velocity provided: %s"), *WindVelocity.ToString());
-        return;
+        WINDSYSTEM_LOG_ERROR(TEXT("%d invalid wind velocities provided"), NumInvalid);
     }
 
-    FVector LocalPos = Location - GridCenter;
-    FVector GridPos = LocalPos / CellSize;
+    InjectionQueue.PushBatch(MoveTemp(Injections));
+}
+
+void UWindSimulationComponent::SetZoneMask(TSharedPtr<const FWindZoneMask> Mask)
+{
+    FScopeLock Lock(&InputLock);
+    GatherFrame.bHasZoneMask = true;
+    GatherFrame.ZoneMask = MoveTemp(Mask);
+}
+
+void UWindSimulationComponent::AddWindField(TSharedPtr<const FWindForcingGrid> Forcing)
+{
+    if (Forcing.IsValid() && !Forcing->IsEmpty())
+    {
+        InjectionQueue.Push(MoveTemp(Forcing));
+    }
+}
 
-    int32 X = FMath::FloorToInt(GridPos.X);
-    int32 Y = FMath::FloorToInt(GridPos.Y);
-    int32 Z = FMath::FloorToInt(GridPos.Z);
+void UWindSimulationComponent::ApplyQueuedWind()
+{
+    if (SolveFrame.Injections.Num() == 0 && SolveFrame.Fields.Num() == 0)
+    {
+        return;
+    }
 
-    int32 Size = WindGrid->GetSize();
-    if (X >= 0 && X < Size && Y >= 0 && Y < Size && Z >= 0 && Z < Size)
+    int32 NumOutside = 0;
+    PendingCellForces.Reset();
+    for (const FWindInjection& Injection : SolveFrame.Injections)
     {
-        FVector CurrentVelocity = WindGrid->GetCell(X, Y, Z);
-      /*  if (CurrentVelocity.ContainsNaN()) {
-            CurrentVelocity = FVector::ZeroVector;
-        }*/
-        FVector NewVelocity = CurrentVelocity + WindVelocity;
-        
-        // Clamp the new velocity to prevent extreme values
-        if (NewVelocity.SizeSquared() > FMath::Square(GetMaxAllowedWindVelocity()))
+        const int32 Cell = Solver->GetCellIndex(Injection.Location - GridCenter);
+        if (Cell == INDEX_NONE)
         {
-            NewVelocity = NewVelocity.GetSafeNormal() * GetMaxAllowedWindVelocity();
-            //WINDSYSTEM_LOG_WARNING(TEXT("Wind velocity clamped at location: %s"), *Location.ToString());
+            NumOutside++;
+            continue;
         }
+        PendingCellForces.Emplace(Cell, Injection.Velocity);
+    }
+
+    for (const TSharedPtr<const FWindForcingGrid>& Field : SolveFrame.Fields)
+    {
+        GatherFieldForces(*Field);
+    }
 
-        WindGrid->SetCell(X, Y, Z, NewVelocity);
+    // Sort by destination cell so the splat walks the grid in memory order and every cell is
+    // written once. The stable sort keeps the order of contributions within a cell.
+    PendingCellForces.StableSort([](const TPair<int32, FVector>& A, const TPair<int32, FVector>& B) { return A.Key < B.Key; });
 
-        WINDSYSTEM_LOG_VERBOSE(TEXT("Wind added at location: Pos=%s, NewVelocity=%s"), 
-            *Location.ToString(), *NewVelocity.ToString());
+    for (int32 Begin = 0; Begin < PendingCellForces.Num();)
+    {
+        const int32 Cell = PendingCellForces[Begin].Key;
+        FVector Velocity = FVector::ZeroVector;
+
+        int32 End = Begin;
+        for (; End < PendingCellForces.Num() && PendingCellForces[End].Key == Cell; End++)
+        {
+            Velocity += PendingCellForces[End].Value;
+        }
+
+        Solver->AddVelocityAtCell(Cell, Velocity);
+        Begin = End;
     }
-    else
+
+    if (NumOutside > 0)
     {
-        WINDSYSTEM_LOG_WARNING(TEXT("Attempted to add wind outside the grid bounds"));
+        WINDSYSTEM_LOG_WARNING(TEXT("%d wind injections fell outside the grid bounds"), NumOutside);
     }
 }
 
-// FWindSimulationWorker implementation
-FWindSimulationWorker::FWindSimulationWorker(UWindSimulationComponent* InOwner)
-    : Owner(InOwner), bShouldRun(true)
+void UWindSimulationComponent::GatherFieldForces(const FWindForcingGrid& Forcing)
 {
-}
+    const FIntVector Dimensions = Solver->GetDimensions();
+    if (Forcing.GetDimensions() != Dimensions || !Forcing.GetCellSpacing().Equals(Solver->GetCellSpacing()))
+    {
+        WINDSYSTEM_LOG_WARNING(TEXT("Discarding wind forcing rasterized before the grid was resized"));
+        return;
+    }
 
-uint32 FWindSimulationWorker::Run()
-{
-    while (bShouldRun)
+    // The grid may have moved by whole cells since the field was rasterized
+    const FVector Shift = (Forcing.GetOrigin() - GridCenter) / Solver->GetCellSpacing();
+    const FIntVector Offset(FMath::RoundToInt32(Shift.X), FMath::RoundToInt32(Shift.Y), FMath::RoundToInt32(Shift.Z));
+
+    const TArray<FVector>& Velocity = Forcing.GetVelocity();
+    const FIntVector DirtyMin = Forcing.GetDirtyMin();
+    const FIntVector DirtyMax = Forcing.GetDirtyMax();
+    for (int32 Z = DirtyMin.Z; Z <= DirtyMax.Z; Z++)
     {
-        Owner->SimulationStep(1.0f / Owner->GetSimulationFrequency());
-        FPlatformProcess::Sleep(1.0f / Owner->GetSimulationFrequency());
+        const int32 TargetZ = Z + Offset.Z;
+        if (TargetZ < 0 || TargetZ >= Dimensions.Z)
+        {
+            continue;
+        }
+
+        for (int32 Y = DirtyMin.Y; Y <= DirtyMax.Y; Y++)
+        {
+            const int32 TargetY = Y + Offset.Y;
+            if (TargetY < 0 || TargetY >= Dimensions.Y)
+            {
+                continue;
+            }
+
+            for (int32 X = DirtyMin.X; X <= DirtyMax.X; X++)
+            {
+                const int32 TargetX = X + Offset.X;
+                const FVector& Value = Velocity[Forcing.GetIndex(X, Y, Z)];
+                if (TargetX >= 0 && TargetX < Dimensions.X && !Value.IsZero())
+                {
+                    PendingCellForces.Emplace(TargetX + TargetY * Dimensions.X + TargetZ * Dimensions.X * Dimensions.Y, Value);
+                }
+            }
+        }
     }
-    return 0;
 }
 
-void FWindSimulationWorker::Stop()
+void UWindSimulationComponent::SetObstacleAtLocation(const FVector& Location, bool bIsObstacle)
 {
-    bShouldRun = false;
+    if (!IsGridInitialized())
+    {
+        WINDSYSTEM_LOG_ERROR(TEXT("WindGrid is not initialized"));
+        return;
+    }
+
+    FScopeLock Lock(&InputLock);
+    FWindObstacleEdit& Edit = GatherFrame.ObstacleEdits.AddDefaulted_GetRef();
+    Edit.Location = Location;
+    Edit.bIsObstacle = bIsObstacle;
 }
\ No newline at end of file
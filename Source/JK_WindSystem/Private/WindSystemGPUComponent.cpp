@@ -135,6 +135,52 @@ FVector UWindGPUSimulationComponent::GetWindVelocityAtLocation(const FVector& Lo
     return FVector::ZeroVector;
 }
 
+void UWindGPUSimulationComponent::GetWindVelocitiesAtLocations(TConstArrayView<FVector> Locations, TArrayView<FVector> OutVelocities) const
+{
+    for (int32 Index = 0; Index < Locations.Num(); Index++)
+    {
+        OutVelocities[Index] = GetWindVelocityAtLocation(Locations[Index]);
+    }
+}
+
+FVector UWindGPUSimulationComponent::GetWindVelocityAtLocationLod(const FVector& Location, float Footprint) const
+{
+    return GetWindVelocityAtLocation(Location);
+}
+
+void UWindGPUSimulationComponent::GetWindVelocitiesAtLocationsLod(TConstArrayView<FVector> Locations, float Footprint, TArrayView<FVector> OutVelocities) const
+{
+    GetWindVelocitiesAtLocations(Locations, OutVelocities);
+}
+
+FVector UWindGPUSimulationComponent::GetAverageWindInBox(const FBox& Box) const
+{
+    return GetWindVelocityAtLocation(Box.GetCenter());
+}
+
+FWindVelocityDerivatives UWindGPUSimulationComponent::GetWindDerivativesAtLocation(const FVector& Location) const
+{
+    FWindVelocityDerivatives Derivatives;
+    Derivatives.Velocity = GetWindVelocityAtLocation(Location);
+    return Derivatives;
+}
+
+void UWindGPUSimulationComponent::GetWindDerivativesAtLocations(TConstArrayView<FVector> Locations, TArrayView<FWindVelocityDerivatives> OutDerivatives) const
+{
+    for (int32 Index = 0; Index < Locations.Num(); Index++)
+    {
+        OutDerivatives[Index] = GetWindDerivativesAtLocation(Locations[Index]);
+    }
+}
+
+void UWindGPUSimulationComponent::TraceWindStreamlines(TConstArrayView<FVector> Seeds, const FWindTraceSettings& Settings, TArrayView<FVector> OutPoints) const
+{
+    FWindStreamlineTracer::Trace(Seeds, Settings, [this](TConstArrayView<FVector> Positions, TArrayView<FVector> OutVelocities)
+    {
+        GetWindVelocitiesAtLocations(Positions, OutVelocities);
+    }, OutPoints);
+}
+
 void UWindGPUSimulationComponent::AddWindAtLocation(const FVector& Location, const FVector& WindVelocity)
 {
     // Implement this based on your specific needs
@@ -8,4 +8,21 @@ UWindSystemSettings::UWindSystemSettings(const FObjectInitializer& ObjectInitial
     CellSize = 100.0f; // Default value
     Viscosity = 0.1f;
     SimulationFrequency = 60.0f;
+    SolverBackend = EWindSolverBackend::StableFluids;
+    SchedulerMode = EWindSchedulerMode::GameThread;
+    TimeSliceBudgetMs = 2.0f;
+    TimeSliceFramesPerStep = 4;
+    SolverTileSize = FIntVector(16, 16, 4);
+    SolverTileWorkers = 0;
+    GeneratorWorkers = 0;
+    SimulationWorkerThreads = 2;
+    TemporalSampling = EWindTemporalSampling::Latest;
+    LayeredGridResolution = 64;
+    LayeredCellSize = 5000.0f;
+    LayeredBandCount = 6;
+    LayeredBandHeight = 5000.0f;
+    LayeredVerticalExchange = 0.5f;
+    SpongeLayerWidth = 0;
+    SpongeLayerStrength = 2.0f;
+    bInflowOutflowBoundaries = false;
 }
\ No newline at end of file
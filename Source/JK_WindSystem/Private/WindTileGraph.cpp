@@ -0,0 +1,129 @@
+#include "WindTileGraph.h"
+#include "Async/ParallelFor.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Tasks/Task.h"
+
+FWindTileGraph::FWindTileGraph(const FIntVector& InTileSize, int32 InMaxWorkers)
+    : TileSize(InTileSize)
+    , MaxWorkers(InMaxWorkers)
+{
+}
+
+FWindTileGraph::~FWindTileGraph()
+{
+}
+
+void FWindTileGraph::AddTiledStage(const FIntVector& RegionBegin, const FIntVector& RegionEnd, TFunction<void(const FWindTile&)> Kernel)
+{
+    const FIntVector Extent = RegionEnd - RegionBegin;
+    if (Extent.X <= 0 || Extent.Y <= 0 || Extent.Z <= 0)
+    {
+        return;
+    }
+
+    FStage& Stage = Stages.AddDefaulted_GetRef();
+    Stage.Kernel = MoveTemp(Kernel);
+    Stage.RegionBegin = RegionBegin;
+    Stage.RegionEnd = RegionEnd;
+    for (int32 Axis = 0; Axis < 3; Axis++)
+    {
+        Stage.TileSize[Axis] = TileSize[Axis] > 0 ? FMath::Min(TileSize[Axis], Extent[Axis]) : Extent[Axis];
+        Stage.NumTiles[Axis] = FMath::DivideAndRoundUp(Extent[Axis], Stage.TileSize[Axis]);
+    }
+
+    const int32 TotalTiles = Stage.NumTiles.X * Stage.NumTiles.Y * Stage.NumTiles.Z;
+    const int32 AvailableWorkers = MaxWorkers > 0 ? MaxWorkers : FTaskGraphInterface::Get().GetNumWorkerThreads();
+    Stage.NumWorkers = FMath::Clamp(AvailableWorkers, 1, TotalTiles);
+
+    // Each worker starts on its own contiguous run so neighbouring tiles tend to stay on one core
+    Stage.Ranges = MakeUnique<FTileRange[]>(Stage.NumWorkers);
+    for (int32 Worker = 0; Worker < Stage.NumWorkers; Worker++)
+    {
+        Stage.Ranges[Worker].Next.store(TotalTiles * Worker / Stage.NumWorkers, std::memory_order_relaxed);
+        Stage.Ranges[Worker].End = TotalTiles * (Worker + 1) / Stage.NumWorkers;
+    }
+}
+
+void FWindTileGraph::AddSerialStage(TFunction<void()> Function)
+{
+    FStage& Stage = Stages.AddDefaulted_GetRef();
+    Stage.SerialFunction = MoveTemp(Function);
+}
+
+void FWindTileGraph::Execute()
+{
+    // Stages are linked through a join task each, rather than every worker of a stage waiting on
+    // every worker of the one before
+    UE::Tasks::FTask Previous;
+    TArray<UE::Tasks::FTask> Workers;
+
+    for (FStage& Stage : Stages)
+    {
+        if (Stage.SerialFunction)
+        {
+            Previous = UE::Tasks::Launch(UE_SOURCE_LOCATION, [&Stage]() { Stage.SerialFunction(); }, UE::Tasks::Prerequisites(Previous));
+            continue;
+        }
+
+        Workers.Reset();
+        for (int32 Worker = 0; Worker < Stage.NumWorkers; Worker++)
+        {
+            Workers.Add(UE::Tasks::Launch(UE_SOURCE_LOCATION, [&Stage, Worker]() { RunWorker(Stage, Worker); }, UE::Tasks::Prerequisites(Previous)));
+        }
+        Previous = Workers.Num() == 1 ? Workers[0] : UE::Tasks::Launch(UE_SOURCE_LOCATION, []() {}, Workers);
+    }
+
+    Previous.Wait();
+    Stages.Reset();
+}
+
+void FWindTileGraph::RunWorker(FStage& Stage, int32 Worker)
+{
+    // Own range first, then steal from the others in turn. Stealing takes single tiles off the
+    // front of the victim's range through the same cursor its owner uses.
+    for (int32 Offset = 0; Offset < Stage.NumWorkers; Offset++)
+    {
+        FTileRange& Range = Stage.Ranges[(Worker + Offset) % Stage.NumWorkers];
+        for (int32 TileIndex = Range.Next.fetch_add(1, std::memory_order_relaxed); TileIndex < Range.End; TileIndex = Range.Next.fetch_add(1, std::memory_order_relaxed))
+        {
+            Stage.Kernel(Stage.GetTile(TileIndex));
+        }
+    }
+}
+
+FWindTile FWindTileGraph::FStage::GetTile(int32 TileIndex) const
+{
+    // X fastest, matching the grid layout
+    const FIntVector Coord(
+        TileIndex % NumTiles.X,
+        (TileIndex / NumTiles.X) % NumTiles.Y,
+        TileIndex / (NumTiles.X * NumTiles.Y));
+
+    FWindTile Tile;
+    Tile.Begin = RegionBegin + FIntVector(Coord.X * TileSize.X, Coord.Y * TileSize.Y, Coord.Z * TileSize.Z);
+    Tile.End = FIntVector(
+        FMath::Min(Tile.Begin.X + TileSize.X, RegionEnd.X),
+        FMath::Min(Tile.Begin.Y + TileSize.Y, RegionEnd.Y),
+        FMath::Min(Tile.Begin.Z + TileSize.Z, RegionEnd.Z));
+    return Tile;
+}
+
+void FWindTileGraph::ParallelForWorkers(int32 Num, int32 MaxWorkers, TFunctionRef<void(int32)> Body)
+{
+    if (MaxWorkers <= 0)
+    {
+        ParallelFor(Num, Body);
+        return;
+    }
+
+    // One contiguous run per allowed worker, so no more than MaxWorkers runs are ever in flight
+    const int32 NumRuns = FMath::Min(MaxWorkers, Num);
+    ParallelFor(NumRuns, [Num, NumRuns, &Body](int32 Run)
+    {
+        const int32 End = Num * (Run + 1) / NumRuns;
+        for (int32 Index = Num * Run / NumRuns; Index < End; Index++)
+        {
+            Body(Index);
+        }
+    });
+}
@@ -0,0 +1,160 @@
+#include "WindTurbulenceField.h"
+#include "Async/ParallelFor.h"
+#include "Math/RandomStream.h"
+
+namespace WindTurbulence
+{
+    FORCEINLINE float Fade(float T)
+    {
+        // Quintic fade keeps the potential C2 so its curl stays continuous across lattice cells
+        return T * T * T * (T * (T * 6.0f - 15.0f) + 10.0f);
+    }
+}
+
+FWindTurbulenceField::FWindTurbulenceField()
+    : Resolution(0)
+{
+}
+
+FORCEINLINE int32 FWindTurbulenceField::Wrap(int32 Value) const
+{
+    const int32 Mod = Value % Resolution;
+    return Mod < 0 ? Mod + Resolution : Mod;
+}
+
+FORCEINLINE int32 FWindTurbulenceField::GetIndex(int32 X, int32 Y, int32 Z) const
+{
+    return X + Y * Resolution + Z * Resolution * Resolution;
+}
+
+void FWindTurbulenceField::Initialize(int32 InResolution, int32 InLatticePeriod, int32 Seed)
+{
+    Resolution = FMath::Max(InResolution, 4);
+    const int32 Period = FMath::Clamp(InLatticePeriod, 1, Resolution);
+    const int32 NumCells = Resolution * Resolution * Resolution;
+
+    // Random vector potential on a periodic lattice
+    FRandomStream Random(Seed);
+    TArray<FVector3f> Lattice;
+    Lattice.SetNumUninitialized(Period * Period * Period);
+    for (FVector3f& Value : Lattice)
+    {
+        Value = FVector3f(Random.VRand());
+    }
+
+    auto LatticeAt = [&Lattice, Period](int32 X, int32 Y, int32 Z) -> const FVector3f&
+    {
+        return Lattice[(X % Period) + (Y % Period) * Period + (Z % Period) * Period * Period];
+    };
+
+    // Smoothly interpolate the potential up to the volume resolution
+    TArray<FVector3f> Potential;
+    Potential.SetNumUninitialized(NumCells);
+    const float LatticeScale = static_cast<float>(Period) / Resolution;
+
+    ParallelFor(Resolution, [&](int32 Z)
+    {
+        const float Fz = Z * LatticeScale;
+        const int32 Z0 = FMath::FloorToInt(Fz);
+        const float U = WindTurbulence::Fade(Fz - Z0);
+
+        for (int32 Y = 0; Y < Resolution; Y++)
+        {
+            const float Fy = Y * LatticeScale;
+            const int32 Y0 = FMath::FloorToInt(Fy);
+            const float T = WindTurbulence::Fade(Fy - Y0);
+
+            for (int32 X = 0; X < Resolution; X++)
+            {
+                const float Fx = X * LatticeScale;
+                const int32 X0 = FMath::FloorToInt(Fx);
+                const float S = WindTurbulence::Fade(Fx - X0);
+
+                Potential[GetIndex(X, Y, Z)] = FMath::Lerp(
+                    FMath::Lerp(
+                        FMath::Lerp(LatticeAt(X0, Y0, Z0), LatticeAt(X0 + 1, Y0, Z0), S),
+                        FMath::Lerp(LatticeAt(X0, Y0 + 1, Z0), LatticeAt(X0 + 1, Y0 + 1, Z0), S),
+                        T),
+                    FMath::Lerp(
+                        FMath::Lerp(LatticeAt(X0, Y0, Z0 + 1), LatticeAt(X0 + 1, Y0, Z0 + 1), S),
+                        FMath::Lerp(LatticeAt(X0, Y0 + 1, Z0 + 1), LatticeAt(X0 + 1, Y0 + 1, Z0 + 1), S),
+                        T),
+                    U);
+            }
+        }
+    });
+
+    // Curl of the potential using wrapped central differences, so the result tiles seamlessly
+    CurlNoise.SetNumUninitialized(NumCells);
+    ParallelFor(Resolution, [&](int32 Z)
+    {
+        for (int32 Y = 0; Y < Resolution; Y++)
+        {
+            for (int32 X = 0; X < Resolution; X++)
+            {
+                const FVector3f& PX0 = Potential[GetIndex(Wrap(X - 1), Y, Z)];
+                const FVector3f& PX1 = Potential[GetIndex(Wrap(X + 1), Y, Z)];
+                const FVector3f& PY0 = Potential[GetIndex(X, Wrap(Y - 1), Z)];
+                const FVector3f& PY1 = Potential[GetIndex(X, Wrap(Y + 1), Z)];
+                const FVector3f& PZ0 = Potential[GetIndex(X, Y, Wrap(Z - 1))];
+                const FVector3f& PZ1 = Potential[GetIndex(X, Y, Wrap(Z + 1))];
+
+                CurlNoise[GetIndex(X, Y, Z)] = 0.5f * FVector3f(
+                    (PY1.Z - PY0.Z) - (PZ1.Y - PZ0.Y),
+                    (PZ1.X - PZ0.X) - (PX1.Z - PX0.Z),
+                    (PX1.Y - PX0.Y) - (PY1.X - PY0.X));
+            }
+        }
+    });
+
+    // Normalize to unit RMS so TurbulenceStrength maps directly to the flutter amplitude
+    double SumSquared = 0.0;
+    for (const FVector3f& Value : CurlNoise)
+    {
+        SumSquared += Value.SizeSquared();
+    }
+
+    const double Rms = FMath::Sqrt(SumSquared / NumCells);
+    if (Rms > UE_KINDA_SMALL_NUMBER)
+    {
+        const float InvRms = static_cast<float>(1.0 / Rms);
+        for (FVector3f& Value : CurlNoise)
+        {
+            Value *= InvRms;
+        }
+    }
+}
+
+FVector FWindTurbulenceField::Sample(const FVector& TilePosition) const
+{
+    if (!IsInitialized())
+    {
+        return FVector::ZeroVector;
+    }
+
+    const FVector Position = TilePosition * Resolution;
+    const int32 X0 = FMath::FloorToInt(Position.X);
+    const int32 Y0 = FMath::FloorToInt(Position.Y);
+    const int32 Z0 = FMath::FloorToInt(Position.Z);
+
+    const float Sx = Position.X - X0;
+    const float Sy = Position.Y - Y0;
+    const float Sz = Position.Z - Z0;
+
+    const int32 Xa = Wrap(X0), Xb = Wrap(X0 + 1);
+    const int32 Ya = Wrap(Y0), Yb = Wrap(Y0 + 1);
+    const int32 Za = Wrap(Z0), Zb = Wrap(Z0 + 1);
+
+    const FVector3f Result = FMath::Lerp(
+        FMath::Lerp(
+            FMath::Lerp(CurlNoise[GetIndex(Xa, Ya, Za)], CurlNoise[GetIndex(Xb, Ya, Za)], Sx),
+            FMath::Lerp(CurlNoise[GetIndex(Xa, Yb, Za)], CurlNoise[GetIndex(Xb, Yb, Za)], Sx),
+            Sy),
+        FMath::Lerp(
+            FMath::Lerp(CurlNoise[GetIndex(Xa, Ya, Zb)], CurlNoise[GetIndex(Xb, Ya, Zb)], Sx),
+            FMath::Lerp(CurlNoise[GetIndex(Xa, Yb, Zb)], CurlNoise[GetIndex(Xb, Yb, Zb)], Sx),
+            Sy),
+        Sz);
+
+    return FVector(Result);
+}
\ No newline at end of file
@@ -0,0 +1,27 @@
+#include "WindVelocityDerivatives.h"
+
+namespace WindDerivativeConstants
+{
+    // Speed below which turbulence intensity stops growing, so calm air does not read as turbulent
+    const double MinIntensitySpeed = 1.0;
+}
+
+void FWindVelocityDerivatives::SetDerivatives(const FVector& AlongX, const FVector& AlongY, const FVector& AlongZ, const FVector& CellSpacing)
+{
+    Jacobian = FMatrix(ForceInit);
+    const FVector Columns[3] = { AlongX, AlongY, AlongZ };
+    for (int32 Axis = 0; Axis < 3; Axis++)
+    {
+        Jacobian.M[0][Axis] = Columns[Axis].X;
+        Jacobian.M[1][Axis] = Columns[Axis].Y;
+        Jacobian.M[2][Axis] = Columns[Axis].Z;
+    }
+    Jacobian.M[3][3] = 1.0;
+
+    Curl = FVector(AlongY.Z - AlongZ.Y, AlongZ.X - AlongX.Z, AlongX.Y - AlongY.X);
+    Divergence = static_cast<float>(AlongX.X + AlongY.Y + AlongZ.Z);
+
+    // Velocity difference across one cell on each axis, the variation the grid resolves locally
+    const double Variation = FMath::Sqrt((AlongX * CellSpacing.X).SizeSquared() + (AlongY * CellSpacing.Y).SizeSquared() + (AlongZ * CellSpacing.Z).SizeSquared());
+    TurbulenceIntensity = static_cast<float>(Variation / FMath::Max(Velocity.Size(), WindDerivativeConstants::MinIntensitySpeed));
+}
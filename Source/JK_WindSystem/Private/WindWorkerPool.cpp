@@ -0,0 +1,309 @@
+#include "WindWorkerPool.h"
+#include "WindSystemSettings.h"
+#include "WindSystemLog.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/Event.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/ScopeLock.h"
+
+namespace WindWorkerPoolConstants
+{
+    // Steps a domain may fall behind before the backlog is dropped instead of caught up
+    const int32 MaxCatchUpSteps = 4;
+    // Below this a worker yields instead of waiting, as event waits have millisecond granularity
+    const double MinWaitSeconds = 0.001;
+    // Longest an idle worker sleeps before looking again, in case a wake-up was missed
+    const double MaxWaitSeconds = 0.1;
+}
+
+FWindWorkerPool& FWindWorkerPool::Get()
+{
+    static FWindWorkerPool Pool;
+    return Pool;
+}
+
+FWindWorkerPool::FWindWorkerPool()
+    : WakeEvent(nullptr)
+    , WorkerGeneration(0)
+    , NextHandle(0)
+{
+}
+
+FWindWorkerPool::~FWindWorkerPool()
+{
+    // Normally a no-op: the module shut the pool down before static teardown
+    Shutdown();
+}
+
+void FWindWorkerPool::Shutdown()
+{
+    StopWorkers(false);
+
+    FScopeLock ScopeLock(&Lock);
+    Domains.Reset();
+    if (WakeEvent)
+    {
+        FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+        WakeEvent = nullptr;
+    }
+}
+
+int32 FWindWorkerPool::AddDomain(FWindPoolDomainDesc Desc)
+{
+    const double Now = FPlatformTime::Seconds();
+
+    TUniquePtr<FDomain> Domain = MakeUnique<FDomain>();
+    Domain->Desc = MoveTemp(Desc);
+    Domain->Desc.FixedStep = FMath::Max(Domain->Desc.FixedStep, KINDA_SMALL_NUMBER);
+    Domain->NextDeadline = Now + Domain->Desc.FixedStep;
+    Domain->LastRefillTime = Now;
+
+    int32 Handle = INDEX_NONE;
+    {
+        FScopeLock ScopeLock(&Lock);
+        Handle = NextHandle++;
+        Domain->Handle = Handle;
+        Domains.Add(MoveTemp(Domain));
+    }
+
+    StartWorkers();
+    WakeEvent->Trigger();
+    return Handle;
+}
+
+void FWindWorkerPool::RemoveDomain(int32 Handle)
+{
+    bool bLastDomain = false;
+    for (;;)
+    {
+        FScopeLock ScopeLock(&Lock);
+        const int32 Index = Domains.IndexOfByPredicate([Handle](const TUniquePtr<FDomain>& Domain) { return Domain->Handle == Handle; });
+        if (Index == INDEX_NONE)
+        {
+            return;
+        }
+
+        // A step in flight still references the domain's callbacks
+        if (!Domains[Index]->bRunning)
+        {
+            Domains.RemoveAt(Index);
+            bLastDomain = Domains.Num() == 0;
+            break;
+        }
+
+        ScopeLock.Unlock();
+        FPlatformProcess::YieldThread();
+    }
+
+    if (bLastDomain)
+    {
+        StopWorkers(true);
+    }
+}
+
+void FWindWorkerPool::SetDomainPaused(int32 Handle, bool bPaused)
+{
+    FScopeLock ScopeLock(&Lock);
+    for (const TUniquePtr<FDomain>& Domain : Domains)
+    {
+        if (Domain->Handle == Handle && Domain->bPaused != bPaused)
+        {
+            Domain->bPaused = bPaused;
+            if (!bPaused)
+            {
+                const double Now = FPlatformTime::Seconds();
+                Domain->NextDeadline = Now + Domain->Desc.FixedStep;
+                Domain->LastRefillTime = Now;
+                WakeEvent->Trigger();
+            }
+        }
+    }
+}
+
+void FWindWorkerPool::RequestStep(int32 Handle)
+{
+    FScopeLock ScopeLock(&Lock);
+    for (const TUniquePtr<FDomain>& Domain : Domains)
+    {
+        if (Domain->Handle == Handle && Domain->Desc.bOnDemand)
+        {
+            Domain->bStepRequested = true;
+            WakeEvent->Trigger();
+        }
+    }
+}
+
+int32 FWindWorkerPool::GetNumWorkers() const
+{
+    FScopeLock ScopeLock(&Lock);
+    return Threads.Num();
+}
+
+int32 FWindWorkerPool::GetNumDomains() const
+{
+    FScopeLock ScopeLock(&Lock);
+    return Domains.Num();
+}
+
+void FWindWorkerPool::StartWorkers()
+{
+    FScopeLock ScopeLock(&Lock);
+    if (Threads.Num() > 0)
+    {
+        return;
+    }
+    if (!WakeEvent)
+    {
+        WakeEvent = FPlatformProcess::GetSynchEventFromPool(false);
+    }
+
+    const int32 Generation = WorkerGeneration.load();
+    const int32 NumWorkers = FMath::Max(GetDefault<UWindSystemSettings>()->SimulationWorkerThreads, 1);
+    for (int32 Index = 0; Index < NumWorkers; Index++)
+    {
+        TUniquePtr<FWorker> Worker = MakeUnique<FWorker>(*this, Generation);
+        FRunnableThread* Thread = FRunnableThread::Create(Worker.Get(), *FString::Printf(TEXT("WindSimulationWorker%d"), Index));
+        if (!Thread)
+        {
+            WINDSYSTEM_LOG_WARNING(TEXT("Failed to create wind simulation worker %d"), Index);
+            break;
+        }
+        Workers.Add(MoveTemp(Worker));
+        Threads.Add(Thread);
+    }
+}
+
+void FWindWorkerPool::StopWorkers(bool bOnlyIfUnused)
+{
+    TArray<FRunnableThread*> StoppingThreads;
+    TArray<TUniquePtr<FWorker>> StoppingWorkers;
+    {
+        // Decided under Lock, as an AddDomain since the last domain went may already rely on
+        // these workers
+        FScopeLock ScopeLock(&Lock);
+        if (bOnlyIfUnused && Domains.Num() > 0)
+        {
+            return;
+        }
+        StoppingThreads = MoveTemp(Threads);
+        StoppingWorkers = MoveTemp(Workers);
+        WorkerGeneration++;
+    }
+
+    // Workers take Lock, so they are joined outside it
+    for (int32 Index = 0; Index < StoppingThreads.Num(); Index++)
+    {
+        WakeEvent->Trigger();
+    }
+    for (FRunnableThread* Thread : StoppingThreads)
+    {
+        Thread->WaitForCompletion();
+        delete Thread;
+    }
+}
+
+void FWindWorkerPool::RunWorker(int32 Generation)
+{
+    while (WorkerGeneration.load() == Generation)
+    {
+        double WaitSeconds = WindWorkerPoolConstants::MaxWaitSeconds;
+        FDomain* Domain = nullptr;
+        {
+            FScopeLock ScopeLock(&Lock);
+            Domain = ClaimDomain(FPlatformTime::Seconds(), WaitSeconds);
+        }
+
+        if (!Domain)
+        {
+            if (WaitSeconds >= WindWorkerPoolConstants::MinWaitSeconds)
+            {
+                WakeEvent->Wait(static_cast<uint32>(FMath::Min(WaitSeconds, WindWorkerPoolConstants::MaxWaitSeconds) * 1000.0));
+            }
+            else
+            {
+                FPlatformProcess::YieldThread();
+            }
+            continue;
+        }
+
+        // Domains are only removed while not running, so the pointer stays valid for the step
+        const double StartTime = FPlatformTime::Seconds();
+        Domain->Desc.StepFunction();
+        const double StepTime = FPlatformTime::Seconds() - StartTime;
+
+        FScopeLock ScopeLock(&Lock);
+        Domain->bRunning = false;
+        Domain->NextDeadline += Domain->Desc.FixedStep;
+        Domain->BudgetBalance -= StepTime;
+    }
+}
+
+FWindWorkerPool::FDomain* FWindWorkerPool::ClaimDomain(double Now, double& OutWaitSeconds)
+{
+    FDomain* Best = nullptr;
+    for (const TUniquePtr<FDomain>& DomainPtr : Domains)
+    {
+        FDomain& Domain = *DomainPtr;
+        if (Domain.bRunning || Domain.bPaused)
+        {
+            continue;
+        }
+
+        double ReadyTime = Now;
+        if (Domain.Desc.bOnDemand)
+        {
+            // Its owner decides when steps are due and how far it may fall behind
+            if (!Domain.bStepRequested)
+            {
+                continue;
+            }
+            Domain.NextDeadline = Now;
+        }
+        else
+        {
+            // Steps are paced against absolute deadlines, so step cost and wake-up latency do not
+            // accumulate into drift. A backlog beyond the catch-up limit is dropped.
+            const int32 NumBehind = FMath::FloorToInt32((Now - Domain.NextDeadline) / Domain.Desc.FixedStep);
+            if (NumBehind >= WindWorkerPoolConstants::MaxCatchUpSteps)
+            {
+                Domain.NextDeadline += NumBehind * static_cast<double>(Domain.Desc.FixedStep);
+                if (Domain.Desc.OnDroppedSteps)
+                {
+                    Domain.Desc.OnDroppedSteps(NumBehind);
+                }
+            }
+            ReadyTime = Domain.NextDeadline;
+        }
+
+        if (Domain.Desc.CpuBudget > 0.0f)
+        {
+            // At most a catch-up's worth of budget is banked, so an idle domain cannot burst
+            const double MaxBalance = WindWorkerPoolConstants::MaxCatchUpSteps * Domain.Desc.FixedStep * Domain.Desc.CpuBudget;
+            Domain.BudgetBalance = FMath::Min(Domain.BudgetBalance + (Now - Domain.LastRefillTime) * Domain.Desc.CpuBudget, MaxBalance);
+            Domain.LastRefillTime = Now;
+            if (Domain.BudgetBalance < 0.0)
+            {
+                ReadyTime = FMath::Max(ReadyTime, Now - Domain.BudgetBalance / Domain.Desc.CpuBudget);
+            }
+        }
+
+        if (ReadyTime > Now)
+        {
+            OutWaitSeconds = FMath::Min(OutWaitSeconds, ReadyTime - Now);
+            continue;
+        }
+
+        if (!Best || Domain.Desc.Priority > Best->Desc.Priority || (Domain.Desc.Priority == Best->Desc.Priority && Domain.NextDeadline < Best->NextDeadline))
+        {
+            Best = &Domain;
+        }
+    }
+
+    if (Best)
+    {
+        Best->bRunning = true;
+        Best->bStepRequested = false;
+    }
+    return Best;
+}
@@ -0,0 +1,237 @@
+#include "WindZoneIndex.h"
+#include "Algo/BinarySearch.h"
+
+namespace
+{
+    void InsertSorted(TArray<int32>& Ids, int32 Id)
+    {
+        const int32 Position = Algo::LowerBound(Ids, Id);
+        if (!Ids.IsValidIndex(Position) || Ids[Position] != Id)
+        {
+            Ids.Insert(Id, Position);
+        }
+    }
+
+    void RemoveSorted(TArray<int32>& Ids, int32 Id)
+    {
+        const int32 Position = Algo::BinarySearch(Ids, Id);
+        if (Position != INDEX_NONE)
+        {
+            Ids.RemoveAt(Position);
+        }
+    }
+}
+
+FWindZoneIndex::FWindZoneIndex(float InCellSize)
+    : CellSize(FMath::Max(InCellSize, 1.0f))
+    , InvCellSize(1.0f / FMath::Max(InCellSize, 1.0f))
+{
+}
+
+void FWindZoneIndex::Reset()
+{
+    Cells.Reset();
+    LargeEntries.Reset();
+    EntryBounds.Reset();
+    NumEntries = 0;
+}
+
+void FWindZoneIndex::Update(int32 Id, const FBox& Bounds)
+{
+    check(Id >= 0);
+    if (EntryBounds.Num() <= Id)
+    {
+        EntryBounds.SetNum(Id + 1);
+    }
+
+    FBox& Current = EntryBounds[Id];
+    if (Current.IsValid)
+    {
+        // Moving within the same cells only changes the bounds the candidates are checked against
+        if (Bounds.IsValid)
+        {
+            FIntVector OldMin, OldMax, NewMin, NewMax;
+            GetCellRange(Current, OldMin, OldMax);
+            GetCellRange(Bounds, NewMin, NewMax);
+            if (OldMin == NewMin && OldMax == NewMax)
+            {
+                Current = Bounds;
+                return;
+            }
+        }
+        Remove(Id, Current);
+        NumEntries--;
+    }
+
+    if (Bounds.IsValid)
+    {
+        Insert(Id, Bounds);
+        NumEntries++;
+    }
+    Current = Bounds;
+}
+
+void FWindZoneIndex::Query(const FVector& Point, TArray<int32, TInlineAllocator<16>>& OutIds) const
+{
+    OutIds.Reset();
+    if (NumEntries == 0)
+    {
+        return;
+    }
+
+    GatherCandidates(GetCell(Point), OutIds);
+    OutIds.RemoveAll([this, &Point](int32 Id) { return !EntryBounds[Id].IsInsideOrOn(Point); });
+}
+
+void FWindZoneIndex::ForEachCell(TConstArrayView<FVector> Points, TFunctionRef<void(TConstArrayView<int32> PointIndices, TConstArrayView<int32> CandidateIds)> Visit) const
+{
+    if (NumEntries == 0 || Points.Num() == 0)
+    {
+        return;
+    }
+
+    struct FPointCell
+    {
+        FIntVector Cell;
+        int32 Index;
+    };
+
+    TArray<FPointCell> Sorted;
+    Sorted.SetNumUninitialized(Points.Num());
+    for (int32 Index = 0; Index < Points.Num(); Index++)
+    {
+        Sorted[Index] = { GetCell(Points[Index]), Index };
+    }
+    Sorted.Sort([](const FPointCell& A, const FPointCell& B)
+    {
+        if (A.Cell.Z != B.Cell.Z)
+        {
+            return A.Cell.Z < B.Cell.Z;
+        }
+        if (A.Cell.Y != B.Cell.Y)
+        {
+            return A.Cell.Y < B.Cell.Y;
+        }
+        if (A.Cell.X != B.Cell.X)
+        {
+            return A.Cell.X < B.Cell.X;
+        }
+        return A.Index < B.Index;
+    });
+
+    TArray<int32> PointIndices;
+    TArray<int32, TInlineAllocator<16>> Candidates;
+    int32 RunStart = 0;
+    while (RunStart < Sorted.Num())
+    {
+        const FIntVector Cell = Sorted[RunStart].Cell;
+        int32 RunEnd = RunStart + 1;
+        while (RunEnd < Sorted.Num() && Sorted[RunEnd].Cell == Cell)
+        {
+            RunEnd++;
+        }
+
+        Candidates.Reset();
+        GatherCandidates(Cell, Candidates);
+        if (Candidates.Num() > 0)
+        {
+            PointIndices.Reset();
+            for (int32 SortedIndex = RunStart; SortedIndex < RunEnd; SortedIndex++)
+            {
+                PointIndices.Add(Sorted[SortedIndex].Index);
+            }
+            Visit(PointIndices, Candidates);
+        }
+        RunStart = RunEnd;
+    }
+}
+
+FIntVector FWindZoneIndex::GetCell(const FVector& Point) const
+{
+    return FIntVector(
+        FMath::FloorToInt(Point.X * InvCellSize),
+        FMath::FloorToInt(Point.Y * InvCellSize),
+        FMath::FloorToInt(Point.Z * InvCellSize));
+}
+
+void FWindZoneIndex::GetCellRange(const FBox& Bounds, FIntVector& OutMin, FIntVector& OutMax) const
+{
+    OutMin = GetCell(Bounds.Min);
+    OutMax = GetCell(Bounds.Max);
+}
+
+bool FWindZoneIndex::IsLarge(const FIntVector& Min, const FIntVector& Max)
+{
+    const int64 NumCells = int64(Max.X - Min.X + 1) * int64(Max.Y - Min.Y + 1) * int64(Max.Z - Min.Z + 1);
+    return NumCells > WindZoneIndexConstants::MaxCellsPerEntry;
+}
+
+void FWindZoneIndex::Insert(int32 Id, const FBox& Bounds)
+{
+    FIntVector Min, Max;
+    GetCellRange(Bounds, Min, Max);
+    if (IsLarge(Min, Max))
+    {
+        InsertSorted(LargeEntries, Id);
+        return;
+    }
+
+    for (int32 Z = Min.Z; Z <= Max.Z; Z++)
+    {
+        for (int32 Y = Min.Y; Y <= Max.Y; Y++)
+        {
+            for (int32 X = Min.X; X <= Max.X; X++)
+            {
+                InsertSorted(Cells.FindOrAdd(FIntVector(X, Y, Z)), Id);
+            }
+        }
+    }
+}
+
+void FWindZoneIndex::Remove(int32 Id, const FBox& Bounds)
+{
+    FIntVector Min, Max;
+    GetCellRange(Bounds, Min, Max);
+    if (IsLarge(Min, Max))
+    {
+        RemoveSorted(LargeEntries, Id);
+        return;
+    }
+
+    for (int32 Z = Min.Z; Z <= Max.Z; Z++)
+    {
+        for (int32 Y = Min.Y; Y <= Max.Y; Y++)
+        {
+            for (int32 X = Min.X; X <= Max.X; X++)
+            {
+                const FIntVector Cell(X, Y, Z);
+                if (TArray<int32>* Ids = Cells.Find(Cell))
+                {
+                    RemoveSorted(*Ids, Id);
+                    if (Ids->Num() == 0)
+                    {
+                        Cells.Remove(Cell);
+                    }
+                }
+            }
+        }
+    }
+}
+
+void FWindZoneIndex::GatherCandidates(const FIntVector& Cell, TArray<int32, TInlineAllocator<16>>& OutIds) const
+{
+    if (const TArray<int32>* Ids = Cells.Find(Cell))
+    {
+        OutIds.Append(*Ids);
+    }
+    if (LargeEntries.Num() > 0)
+    {
+        // Both lists are sorted, but they are short enough that appending and sorting is simplest
+        const bool bNeedsSort = OutIds.Num() > 0;
+        OutIds.Append(LargeEntries);
+        if (bNeedsSort)
+        {
+            OutIds.Sort();
+        }
+    }
+}
@@ -0,0 +1,331 @@
+#include "WindZoneMask.h"
+
+namespace WindZoneMaskConstants
+{
+    // Sample points per axis inside each cell when measuring how much of it a zone covers. Zones
+    // thinner than a cell take more, up to the maximum, so they cannot fall between the samples.
+    const int32 CoverageSamples = 2;
+    const int32 MaxCoverageSamples = 8;
+    // A cell freezes, or is held at rest by zones that block the flow, once they cover at least
+    // this much of it; below, the flow passes
+    const float MinFrozenCoverage = 0.5f;
+    const float MinBlockedCoverage = 0.5f;
+    // Modifier table size addressable by the per-node indices. Once full, further zones are left
+    // out and overlaps keep the entry of the later zone.
+    const int32 MaxModifiers = MAX_uint16;
+}
+
+void FWindZoneMask::Initialize(const FVector& InOrigin, const FIntVector& InDimensions, const FVector& InCellSpacing)
+{
+    Origin = InOrigin;
+    Dimensions = InDimensions;
+    CellSpacing = InCellSpacing;
+
+    const int32 NumNodes = Dimensions.X * Dimensions.Y * Dimensions.Z;
+    ModifierIndices.Reset();
+    ModifierIndices.SetNumZeroed(NumNodes);
+    Weights.Reset();
+    Weights.SetNumZeroed(NumNodes);
+    NumCovered = 0;
+    BlockedCells.Reset();
+    NumBlocked = 0;
+    FrozenCells.Reset();
+    FrozenSums.Reset();
+    NumFrozen = 0;
+
+    Modifiers.Reset();
+    Modifiers.AddDefaulted();
+    Compositions.Reset();
+    Zones.Reset();
+    ZoneIndex.Reset();
+}
+
+bool FWindZoneMask::IsAlignedWith(const FVector& InOrigin, const FIntVector& InDimensions, const FVector& InCellSpacing) const
+{
+    const double Tolerance = CellSpacing.GetMin() * 0.01;
+    return IsValid() && Dimensions == InDimensions && CellSpacing.Equals(InCellSpacing, Tolerance) && Origin.Equals(InOrigin, Tolerance);
+}
+
+bool FWindZoneMask::GetShiftTo(const FVector& InOrigin, const FIntVector& InDimensions, const FVector& InCellSpacing, FIntVector& OutCellOffset) const
+{
+    const double Tolerance = CellSpacing.GetMin() * 0.01;
+    if (!IsValid() || Dimensions != InDimensions || !CellSpacing.Equals(InCellSpacing, Tolerance))
+    {
+        return false;
+    }
+
+    // The contents move against the origin
+    const FVector Cells = (Origin - InOrigin) / CellSpacing;
+    OutCellOffset = FIntVector(FMath::RoundToInt32(Cells.X), FMath::RoundToInt32(Cells.Y), FMath::RoundToInt32(Cells.Z));
+    return (Origin - FVector(OutCellOffset) * CellSpacing).Equals(InOrigin, Tolerance);
+}
+
+void FWindZoneMask::Shift(const FIntVector& CellOffset)
+{
+    if (!IsValid() || CellOffset == FIntVector::ZeroValue)
+    {
+        return;
+    }
+
+    TArray<uint16> NewModifierIndices;
+    NewModifierIndices.SetNumZeroed(ModifierIndices.Num());
+    TArray<float> NewWeights;
+    NewWeights.SetNumZeroed(Weights.Num());
+    NumCovered = 0;
+    for (int32 Z = 0; Z < Dimensions.Z; Z++)
+    {
+        const int32 OldZ = Z - CellOffset.Z;
+        for (int32 Y = 0; Y < Dimensions.Y; Y++)
+        {
+            const int32 OldY = Y - CellOffset.Y;
+            for (int32 X = 0; X < Dimensions.X; X++)
+            {
+                const int32 OldX = X - CellOffset.X;
+                if (OldX < 0 || OldY < 0 || OldZ < 0 || OldX >= Dimensions.X || OldY >= Dimensions.Y || OldZ >= Dimensions.Z)
+                {
+                    continue;
+                }
+                const int32 OldIndex = GetIndex(OldX, OldY, OldZ);
+                const int32 NewIndex = GetIndex(X, Y, Z);
+                NewModifierIndices[NewIndex] = ModifierIndices[OldIndex];
+                NewWeights[NewIndex] = Weights[OldIndex];
+                NumCovered += ModifierIndices[OldIndex] != 0 ? 1 : 0;
+            }
+        }
+    }
+    ModifierIndices = MoveTemp(NewModifierIndices);
+    Weights = MoveTemp(NewWeights);
+    Origin -= FVector(CellOffset) * CellSpacing;
+
+    // The frozen summary is rebuilt over the moved cells
+    Finalize();
+}
+
+int32 FWindZoneMask::GetCellAt(const FVector& WorldPosition) const
+{
+    const FVector GridPosition = (WorldPosition - Origin) / CellSpacing;
+    const int32 X = FMath::RoundToInt(GridPosition.X);
+    const int32 Y = FMath::RoundToInt(GridPosition.Y);
+    const int32 Z = FMath::RoundToInt(GridPosition.Z);
+    if (X < 0 || Y < 0 || Z < 0 || X >= Dimensions.X || Y >= Dimensions.Y || Z >= Dimensions.Z)
+    {
+        return INDEX_NONE;
+    }
+    return GetIndex(X, Y, Z);
+}
+
+FVector FWindZoneMask::Apply(const FVector& WorldPosition, const FVector& Velocity) const
+{
+    const int32 CellIndex = IsValid() ? GetCellAt(WorldPosition) : INDEX_NONE;
+    return CellIndex != INDEX_NONE ? ApplyToCell(CellIndex, Velocity) : Velocity;
+}
+
+FVector FWindZoneMask::ApplyZones(const FVector& WorldPosition, FVector Velocity) const
+{
+    TArray<int32, TInlineAllocator<16>> Candidates;
+    ZoneIndex.Query(WorldPosition, Candidates);
+    for (const int32 ZoneId : Candidates)
+    {
+        const FZone& Zone = Zones[ZoneId];
+        if (Zone.LocalBox.IsInsideOrOn(Zone.Transform.InverseTransformPosition(WorldPosition)))
+        {
+            Velocity = Zone.VelocityMap.TransformVector(Velocity);
+        }
+    }
+    return Velocity;
+}
+
+void FWindZoneMask::AddZone(const FTransform& ZoneTransform, const FVector& Extent, const FWindZoneModifier& Modifier)
+{
+    using namespace WindZoneMaskConstants;
+
+    if (!IsValid())
+    {
+        return;
+    }
+
+    // Nodes whose cells the zone's world box touches. A node's cell spans half a spacing each way.
+    const FBox LocalBox(-Extent, Extent);
+    const FBox WorldBox = LocalBox.TransformBy(ZoneTransform);
+    ZoneIndex.Update(Zones.Num(), WorldBox);
+    Zones.Add({ ZoneTransform, LocalBox, Modifier.VelocityMap });
+
+    const FVector MinGrid = (WorldBox.Min - Origin) / CellSpacing;
+    const FVector MaxGrid = (WorldBox.Max - Origin) / CellSpacing;
+    const FIntVector Min(
+        FMath::Max(FMath::FloorToInt(MinGrid.X + 0.5), 0),
+        FMath::Max(FMath::FloorToInt(MinGrid.Y + 0.5), 0),
+        FMath::Max(FMath::FloorToInt(MinGrid.Z + 0.5), 0));
+    const FIntVector Max(
+        FMath::Min(FMath::CeilToInt(MaxGrid.X - 0.5), Dimensions.X - 1),
+        FMath::Min(FMath::CeilToInt(MaxGrid.Y - 0.5), Dimensions.Y - 1),
+        FMath::Min(FMath::CeilToInt(MaxGrid.Z - 0.5), Dimensions.Z - 1));
+    if (Min.X > Max.X || Min.Y > Max.Y || Min.Z > Max.Z)
+    {
+        return;
+    }
+
+    const uint16 ZoneEntry = AddModifier(Modifier);
+    if (ZoneEntry == 0)
+    {
+        return;
+    }
+    const double Thinnest = 2.0 * (Extent * ZoneTransform.GetScale3D().GetAbs()).GetMin();
+    const int32 NumSamples = Thinnest > 0.0
+        ? FMath::Clamp(FMath::CeilToInt32(CellSpacing.GetMax() / Thinnest), CoverageSamples, MaxCoverageSamples)
+        : MaxCoverageSamples;
+    const float SampleWeight = 1.0f / (NumSamples * NumSamples * NumSamples);
+
+    for (int32 Z = Min.Z; Z <= Max.Z; Z++)
+    {
+        for (int32 Y = Min.Y; Y <= Max.Y; Y++)
+        {
+            for (int32 X = Min.X; X <= Max.X; X++)
+            {
+                // Coverage from a regular set of points inside the cell, tested in zone space
+                const FVector CellMin = Origin + (FVector(X, Y, Z) - 0.5) * CellSpacing;
+                float Coverage = 0.0f;
+                for (int32 SampleZ = 0; SampleZ < NumSamples; SampleZ++)
+                {
+                    for (int32 SampleY = 0; SampleY < NumSamples; SampleY++)
+                    {
+                        for (int32 SampleX = 0; SampleX < NumSamples; SampleX++)
+                        {
+                            const FVector Offset = (FVector(SampleX, SampleY, SampleZ) + 0.5) / NumSamples;
+                            const FVector LocalPoint = ZoneTransform.InverseTransformPosition(CellMin + Offset * CellSpacing);
+                            if (LocalBox.IsInsideOrOn(LocalPoint))
+                            {
+                                Coverage += SampleWeight;
+                            }
+                        }
+                    }
+                }
+                if (Coverage <= 0.0f)
+                {
+                    continue;
+                }
+
+                const int32 CellIndex = GetIndex(X, Y, Z);
+                uint16& Entry = ModifierIndices[CellIndex];
+                if (Entry == 0)
+                {
+                    Entry = ZoneEntry;
+                    NumCovered++;
+                }
+                else
+                {
+                    Entry = Compose(Entry, ZoneEntry);
+                }
+                Weights[CellIndex] = FMath::Max(Weights[CellIndex], Coverage);
+            }
+        }
+    }
+}
+
+void FWindZoneMask::Finalize()
+{
+    using namespace WindZoneMaskConstants;
+
+    BlockedCells.Reset();
+    NumBlocked = 0;
+    FrozenCells.Reset();
+    FrozenSums.Reset();
+    NumFrozen = 0;
+
+    const int32 NumNodes = ModifierIndices.Num();
+    for (int32 CellIndex = 0; CellIndex < NumNodes; CellIndex++)
+    {
+        const FWindZoneModifier& Modifier = Modifiers[ModifierIndices[CellIndex]];
+        const bool bFrozen = Modifier.bFreeze && Weights[CellIndex] >= MinFrozenCoverage;
+        if (bFrozen)
+        {
+            if (NumFrozen == 0)
+            {
+                FrozenCells.SetNumZeroed(NumNodes);
+            }
+            FrozenCells[CellIndex] = 1;
+            NumFrozen++;
+        }
+        if (bFrozen || (Modifier.bBlocksFlow && Weights[CellIndex] >= MinBlockedCoverage))
+        {
+            if (NumBlocked == 0)
+            {
+                BlockedCells.SetNumZeroed(NumNodes);
+            }
+            BlockedCells[CellIndex] = 1;
+            NumBlocked++;
+        }
+    }
+    if (NumFrozen == 0)
+    {
+        return;
+    }
+
+    const int32 SumX = Dimensions.X + 1;
+    const int32 SumY = Dimensions.Y + 1;
+    FrozenSums.SetNumZeroed(SumX * SumY * (Dimensions.Z + 1));
+    auto Sum = [this, SumX, SumY](int32 SX, int32 SY, int32 SZ) { return FrozenSums[SX + SY * SumX + SZ * SumX * SumY]; };
+    for (int32 Z = 0; Z < Dimensions.Z; Z++)
+    {
+        for (int32 Y = 0; Y < Dimensions.Y; Y++)
+        {
+            for (int32 X = 0; X < Dimensions.X; X++)
+            {
+                FrozenSums[(X + 1) + (Y + 1) * SumX + (Z + 1) * SumX * SumY] = FrozenCells[GetIndex(X, Y, Z)]
+                    + Sum(X, Y + 1, Z + 1) + Sum(X + 1, Y, Z + 1) + Sum(X + 1, Y + 1, Z)
+                    - Sum(X, Y, Z + 1) - Sum(X, Y + 1, Z) - Sum(X + 1, Y, Z)
+                    + Sum(X, Y, Z);
+            }
+        }
+    }
+}
+
+bool FWindZoneMask::IsRegionFrozen(const FIntVector& Begin, const FIntVector& End) const
+{
+    if (NumFrozen == 0 || Begin.X >= End.X || Begin.Y >= End.Y || Begin.Z >= End.Z)
+    {
+        return false;
+    }
+
+    const int32 SumX = Dimensions.X + 1;
+    const int32 SumY = Dimensions.Y + 1;
+    auto Sum = [this, SumX, SumY](int32 SX, int32 SY, int32 SZ) { return FrozenSums[SX + SY * SumX + SZ * SumX * SumY]; };
+    const FIntVector& B = Begin;
+    const FIntVector& E = End;
+    const int32 Count = Sum(E.X, E.Y, E.Z)
+        - Sum(B.X, E.Y, E.Z) - Sum(E.X, B.Y, E.Z) - Sum(E.X, E.Y, B.Z)
+        + Sum(B.X, B.Y, E.Z) + Sum(B.X, E.Y, B.Z) + Sum(E.X, B.Y, B.Z)
+        - Sum(B.X, B.Y, B.Z);
+    return Count == (E.X - B.X) * (E.Y - B.Y) * (E.Z - B.Z);
+}
+
+uint16 FWindZoneMask::AddModifier(const FWindZoneModifier& Modifier)
+{
+    if (Modifiers.Num() >= WindZoneMaskConstants::MaxModifiers)
+    {
+        return 0;
+    }
+    return static_cast<uint16>(Modifiers.Add(Modifier));
+}
+
+uint16 FWindZoneMask::Compose(uint16 Existing, uint16 Added)
+{
+    const uint32 Key = (uint32(Existing) << 16) | Added;
+    if (const uint16* Found = Compositions.Find(Key))
+    {
+        return *Found;
+    }
+
+    // Row vectors: the existing map applies first
+    FWindZoneModifier Composed;
+    Composed.VelocityMap = Modifiers[Existing].VelocityMap * Modifiers[Added].VelocityMap;
+    Composed.bBlocksFlow = Modifiers[Existing].bBlocksFlow || Modifiers[Added].bBlocksFlow;
+    Composed.bFreeze = Modifiers[Existing].bFreeze || Modifiers[Added].bFreeze;
+    uint16 Entry = AddModifier(Composed);
+    if (Entry == 0)
+    {
+        Entry = Added;
+    }
+    Compositions.Add(Key, Entry);
+    return Entry;
+}
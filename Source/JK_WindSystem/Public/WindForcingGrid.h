@@ -0,0 +1,53 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Velocities to add to the simulation, on the same nodes as the exported solver grid. Generators
+// rasterize into it and the simulation applies it at the start of its next step.
+class JK_WINDSYSTEM_API FWindForcingGrid
+{
+public:
+    // Matches the grid to a simulation layout and clears it. Storage is kept if the size matches.
+    void Initialize(const FVector& InOrigin, const FIntVector& InDimensions, const FVector& InCellSpacing);
+    // Clears the values, keeping the layout
+    void Reset();
+
+    bool IsValid() const { return Velocity.Num() > 0; }
+    // True until something is written
+    bool IsEmpty() const { return DirtyMin.X > DirtyMax.X; }
+
+    const FVector& GetOrigin() const { return Origin; }
+    const FIntVector& GetDimensions() const { return Dimensions; }
+    const FVector& GetCellSpacing() const { return CellSpacing; }
+    const TArray<FVector>& GetVelocity() const { return Velocity; }
+
+    // Inclusive node range that has been written to
+    const FIntVector& GetDirtyMin() const { return DirtyMin; }
+    const FIntVector& GetDirtyMax() const { return DirtyMax; }
+
+    FORCEINLINE int32 GetIndex(int32 X, int32 Y, int32 Z) const { return X + Y * Dimensions.X + Z * Dimensions.X * Dimensions.Y; }
+    FORCEINLINE FVector GetNodePosition(int32 X, int32 Y, int32 Z) const { return Origin + FVector(X, Y, Z) * CellSpacing; }
+
+    // Inclusive node range a world-space box touches, including the nodes a trilinear splat from
+    // inside the box can reach. False if the box misses the grid.
+    bool GetNodeRange(const FBox& Bounds, FIntVector& OutMin, FIntVector& OutMax) const;
+
+    void AddNode(int32 X, int32 Y, int32 Z, const FVector& Value);
+    // Spreads Value over the 8 nodes around a world position with trilinear weights
+    void SplatTrilinear(const FVector& WorldPosition, const FVector& Value);
+
+    // Adds another grid with the same layout
+    void Accumulate(const FWindForcingGrid& Other);
+
+private:
+    FVector Origin = FVector::ZeroVector;
+    FIntVector Dimensions = FIntVector::ZeroValue;
+    FVector CellSpacing = FVector::OneVector;
+    TArray<FVector> Velocity;
+
+    FIntVector DirtyMin = FIntVector(MAX_int32);
+    FIntVector DirtyMax = FIntVector(MIN_int32);
+
+    void MarkDirty(int32 X, int32 Y, int32 Z);
+    void ClearDirty();
+};
@@ -2,6 +2,9 @@
 
 #include "CoreMinimal.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
+#include "WindQueryHandle.h"
+#include "WindVelocityDerivatives.h"
+#include "WindStreamlines.h"
 #include "WindFunctionLibrary.generated.h"
 
 UCLASS()
@@ -12,4 +15,39 @@ class JK_WINDSYSTEM_API UWindSimulationFunctionLibrary : public UBlueprintFuncti
 public:
     UFUNCTION(BlueprintCallable, Category = "Wind Simulation", meta = (WorldContext = "WorldContextObject"))
     static FVector GetWindVelocityAtLocation(const UObject* WorldContextObject, const FVector& WorldLocation);
+
+    // Wind at every location in one call, far cheaper than querying them one at a time
+    UFUNCTION(BlueprintCallable, Category = "Wind Simulation", meta = (WorldContext = "WorldContextObject"))
+    static void GetWindVelocitiesAtLocations(const UObject* WorldContextObject, const TArray<FVector>& WorldLocations, TArray<FVector>& OutVelocities);
+
+    // Wind averaged over a region about Footprint across. Cheaper for distant consumers that do
+    // not need cell-accurate wind.
+    UFUNCTION(BlueprintCallable, Category = "Wind Simulation", meta = (WorldContext = "WorldContextObject"))
+    static FVector GetWindVelocityAtLocationLod(const UObject* WorldContextObject, const FVector& WorldLocation, float Footprint);
+
+    // Mean wind over an axis-aligned box, as cheap as a single point query whatever its size
+    UFUNCTION(BlueprintCallable, Category = "Wind Simulation", meta = (WorldContext = "WorldContextObject"))
+    static FVector GetAverageWindInBox(const UObject* WorldContextObject, const FBox& Box);
+
+    // Wind with its shear, vorticity, divergence and turbulence intensity at a point
+    UFUNCTION(BlueprintCallable, Category = "Wind Simulation", meta = (WorldContext = "WorldContextObject"))
+    static FWindVelocityDerivatives GetWindDerivativesAtLocation(const UObject* WorldContextObject, const FVector& WorldLocation);
+
+    // Predicts the path of everything released at Seeds, such as debris, smoke or a kite, as one
+    // polyline per seed
+    UFUNCTION(BlueprintCallable, Category = "Wind Simulation", meta = (WorldContext = "WorldContextObject"))
+    static void TraceWindStreamlines(const UObject* WorldContextObject, const TArray<FVector>& Seeds, const FWindTraceSettings& Settings, TArray<FWindTracePolyline>& OutPolylines);
+
+    // Registers a query that follows Component and is resolved once per tick with every other
+    // registered query. Read it with GetQueriedWindVelocity instead of querying every tick.
+    UFUNCTION(BlueprintCallable, Category = "Wind Simulation|Queries", meta = (WorldContext = "WorldContextObject"))
+    static FWindQueryHandle RegisterWindQuery(const UObject* WorldContextObject, const USceneComponent* Component);
+
+    UFUNCTION(BlueprintCallable, Category = "Wind Simulation|Queries", meta = (WorldContext = "WorldContextObject"))
+    static void UnregisterWindQuery(const UObject* WorldContextObject, UPARAM(ref) FWindQueryHandle& Handle);
+
+    // Wind at the query's component as of the last resolve. The handle knows its subsystem, so
+    // this is a lookup without finding the world.
+    UFUNCTION(BlueprintPure, Category = "Wind Simulation|Queries")
+    static FVector GetQueriedWindVelocity(const FWindQueryHandle& Handle);
 };
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Dense cubic grid of velocities, X fastest
+class JK_WINDSYSTEM_API FWindGrid
+{
+public:
+    FWindGrid(int32 Size, float InCellSize)
+        : GridSize(Size), CellSize(InCellSize)
+    {
+        Grid.SetNumZeroed(Size * Size * Size);
+    }
+
+    FORCEINLINE FVector GetCell(int32 X, int32 Y, int32 Z) const
+    {
+        return IsValidIndex(X, Y, Z) ? Grid[GetIndex(X, Y, Z)] : FVector::ZeroVector;
+    }
+
+    FORCEINLINE void SetCell(int32 X, int32 Y, int32 Z, const FVector& Value)
+    {
+        if (IsValidIndex(X, Y, Z))
+        {
+            Grid[GetIndex(X, Y, Z)] = Value;
+        }
+    }
+
+    int32 GetSize() const { return GridSize; }
+    FIntVector GetBoundSize() const { return FIntVector(GridSize, GridSize, GridSize); }
+    float GetCellSize() const { return CellSize; }
+
+    TArray<FVector>& GetGridData() { return Grid; }
+    // Add a const version
+    const TArray<FVector>& GetGridData() const { return Grid; }
+
+    FORCEINLINE int32 GetIndex(int32 X, int32 Y, int32 Z) const { return X + Y * GridSize + Z * GridSize * GridSize; }
+    FORCEINLINE bool IsValidIndex(int32 X, int32 Y, int32 Z) const
+    {
+        return X >= 0 && X < GridSize && Y >= 0 && Y < GridSize && Z >= 0 && Z < GridSize;
+    }
+
+private:
+    TArray<FVector> Grid;
+    int32 GridSize;
+    float CellSize;
+};
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/SharedPointer.h"
+#include <atomic>
+
+class FWindForcingGrid;
+
+struct FWindInjection
+{
+    FVector Location = FVector::ZeroVector;
+    FVector Velocity = FVector::ZeroVector;
+};
+
+// Wind added from any number of threads, collected by the simulation once per step. Producers
+// never lock or wait: a push is a single compare-and-swap onto a list the consumer takes whole.
+// Each push allocates a node, so producers with many injections hand them over as one batch.
+class JK_WINDSYSTEM_API FWindInjectionQueue
+{
+public:
+    FWindInjectionQueue();
+    ~FWindInjectionQueue();
+
+    // Safe from any thread
+    void Push(const FVector& Location, const FVector& Velocity);
+    void Push(TSharedPtr<const FWindForcingGrid> Field);
+    // Takes over the whole array in one node and one compare-and-swap. Its injections are
+    // drained together, in order.
+    void PushBatch(TArray<FWindInjection> Injections);
+
+    // Appends everything pushed so far, in push order per producer. Single consumer only.
+    void Drain(TArray<FWindInjection>& OutInjections, TArray<TSharedPtr<const FWindForcingGrid>>& OutFields);
+
+    bool IsEmpty() const { return Head.load(std::memory_order_relaxed) == nullptr; }
+
+private:
+    struct FNode
+    {
+        FWindInjection Injection;
+        TArray<FWindInjection> Batch;
+        TSharedPtr<const FWindForcingGrid> Field;
+        FNode* Next = nullptr;
+    };
+
+    std::atomic<FNode*> Head;
+
+    void PushNode(FNode* Node);
+
+    FWindInjectionQueue(const FWindInjectionQueue&) = delete;
+    FWindInjectionQueue& operator=(const FWindInjectionQueue&) = delete;
+};
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/SharedPointer.h"
+#include "WindInjectionQueue.h"
+
+class FWindForcingGrid;
+class FWindZoneMask;
+
+struct FWindObstacleEdit
+{
+    FVector Location = FVector::ZeroVector;
+    bool bIsObstacle = false;
+};
+
+// Everything the game thread hands to one simulation step. The component keeps two: inputs are
+// gathered into one while a step consumes the other, and the two swap when the next step is
+// sealed, so gathering for step N+1 can overlap the solve of step N.
+struct FWindInputFrame
+{
+    // Set when the grid was moved since the last frame was sealed
+    bool bHasGridCenter = false;
+    FVector GridCenter = FVector::ZeroVector;
+
+    // In the order they were made, so the last edit of a cell wins
+    TArray<FWindObstacleEdit> ObstacleEdits;
+
+    TArray<FWindInjection> Injections;
+    TArray<TSharedPtr<const FWindForcingGrid>> Fields;
+
+    // Set when the zones were voxelized again since the last frame was sealed
+    bool bHasZoneMask = false;
+    TSharedPtr<const FWindZoneMask> ZoneMask;
+
+    void Reset()
+    {
+        bHasGridCenter = false;
+        bHasZoneMask = false;
+        ZoneMask.Reset();
+        ObstacleEdits.Reset();
+        Injections.Reset();
+        Fields.Reset();
+    }
+};
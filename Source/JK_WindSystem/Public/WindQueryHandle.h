@@ -0,0 +1,25 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+#include "WindQueryHandle.generated.h"
+
+class UWindSimulationSubsystem;
+
+// Persistent wind query registered with the wind subsystem. The subsystem resolves every
+// registered query in one batch each tick, so reading the result is a lookup rather than a query.
+USTRUCT(BlueprintType)
+struct JK_WINDSYSTEM_API FWindQueryHandle
+{
+    GENERATED_BODY()
+
+    // Slot in the subsystem's query tables
+    int32 Index = INDEX_NONE;
+    // Bumped whenever the slot is reused, so a stale handle never reads another query's result
+    uint32 Serial = 0;
+    // Subsystem that owns the slot, so reading the result needs no world or subsystem lookup
+    TWeakObjectPtr<const UWindSimulationSubsystem> Subsystem;
+
+    bool IsValid() const { return Index != INDEX_NONE; }
+    void Invalidate() { Index = INDEX_NONE; Serial = 0; Subsystem.Reset(); }
+};
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/RefCounting.h"
+#include "Templates/SharedPointer.h"
+#include "WindSnapshot.h"
+#include "WindSystemSettings.h"
+#include "WindTurbulenceField.h"
+#include "WindVelocityDerivatives.h"
+#include "WindStreamlines.h"
+
+class FWindZoneMask;
+
+// Turbulence settings copied out of the settings asset, so sampling reads no UObject
+struct JK_WINDSYSTEM_API FWindQueryTurbulence
+{
+    TSharedPtr<const FWindTurbulenceField> Field;
+    float Strength = 0.0f;
+    float Frequency = 0.1f;
+    FVector GlobalWindDirection = FVector(1.0f, 0.0f, 0.0f);
+    float GlobalWindStrength = 0.0f;
+
+    bool IsEnabled() const { return Strength > 0.0f && Field.IsValid() && Field->IsInitialized(); }
+
+    // Sub-grid flutter at a position in grid units of the snapshot, at blended simulation time Time
+    FVector Sample(const FWindSnapshot& Snapshot, const FVector& GridPosition, float Time) const;
+};
+
+// Everything a wind query reads, pinned as one immutable value: the published snapshot with the
+// zone mask the solver applied, the turbulence layer, and optionally the zones to apply where the
+// grid does not reach. A view refers to no UObject and takes no lock, so any thread may build
+// queries on it and hold it for a frame; the data it pins stays alive until the last copy goes.
+class JK_WINDSYSTEM_API FWindQueryView
+{
+public:
+    FWindQueryView() = default;
+    FWindQueryView(TRefCountPtr<FWindSnapshot> InSnapshot, const FWindQueryTurbulence& InTurbulence, EWindTemporalSampling InTemporalSampling);
+
+    // False before the simulation published anything. Queries on an invalid view return zero wind.
+    bool IsValid() const { return Snapshot.IsValid(); }
+    const FWindSnapshot* GetSnapshot() const { return Snapshot.GetReference(); }
+
+    // Zones applied to positions the snapshot's own mask does not cover, each tested against its
+    // exact box. Every query applies them, so all of them agree off the grid.
+    void SetOuterZones(TSharedPtr<const FWindZoneMask> InOuterZones) { OuterZones = MoveTemp(InOuterZones); }
+
+    FVector GetWindVelocityAtLocation(const FVector& Location) const;
+    // Large batches are split across task graph workers. OutVelocities must be at least as long.
+    void GetWindVelocitiesAtLocations(TConstArrayView<FVector> Locations, TArrayView<FVector> OutVelocities) const;
+
+    FVector GetWindVelocityAtLocationLod(const FVector& Location, float Footprint) const;
+    void GetWindVelocitiesAtLocationsLod(TConstArrayView<FVector> Locations, float Footprint, TArrayView<FVector> OutVelocities) const;
+
+    FVector GetAverageWindInBox(const FBox& Box) const;
+
+    FWindVelocityDerivatives GetWindDerivativesAtLocation(const FVector& Location) const;
+    void GetWindDerivativesAtLocations(TConstArrayView<FVector> Locations, TArrayView<FWindVelocityDerivatives> OutDerivatives) const;
+
+    void TraceWindStreamlines(TConstArrayView<FVector> Seeds, const FWindTraceSettings& Settings, TArrayView<FVector> OutPoints) const;
+
+private:
+    TRefCountPtr<FWindSnapshot> Snapshot;
+    FWindQueryTurbulence Turbulence;
+    EWindTemporalSampling TemporalSampling = EWindTemporalSampling::Latest;
+    TSharedPtr<const FWindZoneMask> OuterZones;
+
+    float GetTemporalAlpha() const;
+    // The snapshot's mask on the grid, OuterZones off it. Also applies to velocity derivatives,
+    // as each zone is linear in the velocity.
+    FVector ApplyZones(const FVector& Location, const FVector& Velocity) const;
+    bool HasZones() const;
+    // Batched body shared by every level of detail
+    void SampleWindVelocities(TConstArrayView<FVector> Locations, TArrayView<FVector> OutVelocities, float Lod) const;
+};
@@ -0,0 +1,117 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include <atomic>
+
+enum class EWindSchedulerMode : uint8;
+
+struct FWindSchedulerStats
+{
+    int32 NumSteps = 0;
+    // Steps discarded because the simulation fell too far behind
+    int32 NumDroppedSteps = 0;
+    double AverageStepMs = 0.0;
+    double AverageIntervalMs = 0.0;
+    // Standard deviation and worst absolute deviation of the time between step starts from the period
+    double JitterMs = 0.0;
+    double MaxJitterMs = 0.0;
+    // Longest game thread time spent stepping within a single Advance
+    double MaxAdvanceMs = 0.0;
+};
+
+// Resumable stepping used by TimeSliced mode
+struct FWindSlicedStepFunctions
+{
+    TFunction<void(float)> BeginStep;
+    // Runs one bounded slice of the current step, returns true once the step is complete
+    TFunction<bool()> StepSlice;
+    TFunction<float()> GetProgress;
+};
+
+// The single authority that decides when the wind simulation steps. Steps always advance the
+// solver by the fixed period; the scheduler only decides where and when they run.
+class JK_WINDSYSTEM_API FWindSimulationScheduler
+{
+public:
+    FWindSimulationScheduler();
+    virtual ~FWindSimulationScheduler();
+
+    void Configure(EWindSchedulerMode InMode, float InFixedStep, TFunction<void(float)> InStepFunction);
+    // Without these, TimeSliced mode runs whole steps like GameThread mode
+    void ConfigureTimeSlicing(FWindSlicedStepFunctions InSlicedStep, float InBudgetMs, int32 InFramesPerStep);
+    // Called on the game thread just before Pipelined mode launches a step, to hand it its inputs
+    void ConfigurePipeline(TFunction<void()> InSealInputs);
+    // How background steps compete with other domains on the shared worker pool
+    void ConfigurePool(int32 InPriority, float InCpuBudget);
+
+    // Joins the shared worker pool. DedicatedThread mode is then stepped by the pool; TaskGraph and
+    // Pipelined modes hand it the steps each Advance launches, and join on their first launch if
+    // never started. Until then DedicatedThread mode steps inline.
+    void Start();
+    // Leaves the worker pool, waiting for a step already running. A batch still waiting for a
+    // worker is dropped.
+    void Shutdown();
+
+    // Called once per frame on the game thread with the frame time
+    void Advance(float DeltaTime, bool bPaused);
+
+    EWindSchedulerMode GetMode() const { return Mode; }
+    float GetFixedStep() const { return FixedStep; }
+    // True while stepped by the shared worker pool
+    bool IsThreadRunning() const { return PoolDomain != INDEX_NONE; }
+    // True while TaskGraph or Pipelined steps launched by an earlier Advance are still running
+    bool IsStepInFlight() const { return bBackgroundStepInFlight.load(); }
+
+    // Fraction of the current time-sliced step that has run, 1 between steps
+    float GetStepProgress() const;
+
+    FWindSchedulerStats GetStats() const;
+    void ResetStats();
+
+private:
+    TFunction<void(float)> StepFunction;
+    EWindSchedulerMode Mode;
+    float FixedStep;
+    double Accumulator;
+
+    int32 PoolDomain;
+    int32 PoolPriority;
+    float PoolCpuBudget;
+    bool bPaused;
+    TFunction<void()> SealInputs;
+    // Steps of the batch TaskGraph and Pipelined modes last handed to the pool, and whether it
+    // has yet to finish
+    int32 NumBackgroundSteps;
+    std::atomic<bool> bBackgroundStepInFlight{ false };
+
+    FWindSlicedStepFunctions SlicedStep;
+    double SliceBudgetSeconds;
+    int32 FramesPerSlicedStep;
+    bool bSlicedStepInFlight;
+    int32 SlicedStepFrames;
+    double SlicedStepStartTime;
+    double SlicedStepWorkTime;
+
+    mutable FCriticalSection StatsLock;
+    double LastStepStartTime;
+    double TotalStepTime;
+    double TotalInterval;
+    double TotalSquaredDeviation;
+    double MaxDeviation;
+    int32 NumIntervals;
+    int32 NumSteps;
+    int32 NumDroppedSteps;
+    double MaxAdvanceTime;
+
+    // Takes whole periods out of the accumulator, dropping any backlog beyond the catch-up limit
+    int32 ConsumeDueSteps();
+    void ExecuteStep();
+    void JoinPool();
+    void ExecuteBackgroundSteps();
+    void AdvanceBackground();
+    void AdvanceTimeSliced();
+    void RecordStep(double StartTime, double WorkTime);
+    void RecordAdvance(double AdvanceTime);
+    void AddDroppedSteps(int32 Count);
+};
@@ -0,0 +1,153 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/RefCounting.h"
+#include "HAL/CriticalSection.h"
+#include <atomic>
+
+enum class EWindTemporalSampling : uint8;
+class FWindZoneMask;
+struct FWindVelocityDerivatives;
+
+// One level of the snapshot's mip pyramid. Each node is the box-filtered average of the 2x2x2
+// nodes below it, so node I sits at the snapshot origin + Offset + I * CellSpacing.
+struct FWindMipLevel
+{
+    FIntVector Dimensions = FIntVector::ZeroValue;
+    FVector Offset = FVector::ZeroVector;
+    FVector CellSpacing = FVector::OneVector;
+    TArray<FVector> Velocity;
+};
+
+// Copy of the simulation state published after each step. Once published a snapshot is never
+// modified, so any number of threads can sample it without synchronization.
+class JK_WINDSYSTEM_API FWindSnapshot : public FThreadSafeRefCountedObject
+{
+public:
+    // World position of node 0,0,0
+    FVector Origin = FVector::ZeroVector;
+    FIntVector Dimensions = FIntVector::ZeroValue;
+    FVector CellSpacing = FVector::OneVector;
+    float SimulationTime = 0.0f;
+
+    // Node-centred, X fastest, as exported by the solver backend
+    TArray<FVector> Velocity;
+    TArray<float> TurbulenceEnergy;
+    // Zones the solver applied to this step, aligned with Velocity. Null without zones.
+    TSharedPtr<const FWindZoneMask> ZoneMask;
+    // Levels 1 and up of the mip pyramid, halving the resolution each level down to a single
+    // node. Level 0 is Velocity itself.
+    TArray<FWindMipLevel> MipLevels;
+    // Summed-volume table of Velocity, one larger than the grid on each axis: entry X,Y,Z is the
+    // sum over every node below it on all three axes, so row, column and plane 0 are zero
+    TArray<FVector> VelocitySums;
+
+    // Platform time of publication and the real time since the previous publication
+    double PublishTime = 0.0;
+    double PublishInterval = 0.0;
+
+    bool IsValid() const { return Velocity.Num() > 0 && Velocity.Num() == Dimensions.X * Dimensions.Y * Dimensions.Z; }
+    // The snapshot published before this one, shared rather than copied for temporal blending.
+    // Null when queries never blend and after a change of layout. Set before publishing.
+    void SetPrevious(TRefCountPtr<const FWindSnapshot> InPrevious) { Previous = MoveTemp(InPrevious); }
+    const FWindSnapshot* GetPrevious() const { return Previous.GetReference(); }
+    bool HasPrevious() const { return Previous.IsValid() && Previous->Velocity.Num() == Velocity.Num(); }
+    bool HasVelocitySums() const { return VelocitySums.Num() == (Dimensions.X + 1) * (Dimensions.Y + 1) * (Dimensions.Z + 1); }
+
+    FORCEINLINE int32 GetIndex(int32 X, int32 Y, int32 Z) const { return X + Y * Dimensions.X + Z * Dimensions.X * Dimensions.Y; }
+
+    // Trilinear sample at a position relative to Origin. Positions outside the grid read the
+    // nearest edge.
+    FVector SampleVelocity(const FVector& LocalPosition) const;
+
+    // Weight of this step against the previous one at platform time Now: 1 is this step, values
+    // in 0-1 interpolate and values above 1 extrapolate
+    float GetTemporalAlpha(EWindTemporalSampling Sampling, double Now) const;
+
+    // Previous + (Current - Previous) * Alpha at a world position, each sampled at its own origin
+    FVector SampleBlendedVelocity(const FVector& WorldPosition, float Alpha) const;
+    // SampleBlendedVelocity for many positions at once. The grid constants are set up once and each
+    // trilinear fetch runs on vector registers. OutVelocities must be at least as long.
+    void SampleBlendedVelocities(TConstArrayView<FVector> WorldPositions, TArrayView<FVector> OutVelocities, float Alpha) const;
+    float GetBlendedSimulationTime(float Alpha) const;
+
+    // Rebuilds MipLevels from Velocity, each level in parallel on at most MaxWorkers threads, 0
+    // meaning every task graph worker. Keeps the level allocations of a recycled snapshot.
+    void BuildMipLevels(int32 MaxWorkers = 0);
+    // Levels including level 0, or 0 for an invalid snapshot
+    int32 GetNumMipLevels() const { return IsValid() ? MipLevels.Num() + 1 : 0; }
+    // Level whose cells are about Footprint across, measured against the coarsest axis. Fractional
+    // levels blend the two levels around them.
+    float GetLodForFootprint(float Footprint) const;
+
+    // SampleBlendedVelocity with the velocity's derivatives, taken analytically from the same
+    // trilinear stencil. Positions outside the grid take the derivatives of the nearest edge cell.
+    FWindVelocityDerivatives SampleBlendedDerivatives(const FVector& WorldPosition, float Alpha) const;
+    void SampleBlendedDerivatives(TConstArrayView<FVector> WorldPositions, TArrayView<FWindVelocityDerivatives> OutDerivatives, float Alpha) const;
+
+    // Rebuilds VelocitySums from Velocity as a parallel prefix sum, slices then columns, with the
+    // same worker limit as BuildMipLevels
+    void BuildVelocitySums(int32 MaxWorkers = 0);
+    // Mean velocity over the nodes whose cells a world-space box covers, blended like
+    // SampleBlendedVelocity. The box is rounded to whole cells and clamped to the grid, and always
+    // covers at least one cell. Eight fetches per step, whatever the size of the box.
+    FVector GetBlendedAverageVelocity(const FBox& WorldBox, float Alpha) const;
+
+    // SampleBlendedVelocity at a mip level. Trilinear within a level and linear between the two
+    // levels around a fractional Lod, which is clamped to the pyramid.
+    FVector SampleBlendedVelocityLod(const FVector& WorldPosition, float Lod, float Alpha) const;
+    void SampleBlendedVelocitiesLod(TConstArrayView<FVector> WorldPositions, TArrayView<FVector> OutVelocities, float Lod, float Alpha) const;
+
+    // Energy of the node nearest to a position in grid units
+    float GetTurbulenceEnergy(const FVector& GridPosition) const;
+
+private:
+    friend class FWindSnapshotChannel;
+
+    // Only reachable as a plain pointer, so nobody can pin it and read its own Previous, which the
+    // channel drops once no reader holds that snapshot directly
+    TRefCountPtr<const FWindSnapshot> Previous;
+
+    FVector SampleField(const TArray<FVector>& Field, const FVector& LocalPosition) const;
+};
+
+// Single-writer, many-reader publication of FWindSnapshot, RCU style. Readers never lock or wait:
+// they pin the current snapshot with a reference. The writer swaps in the new snapshot and keeps
+// the old one retired until no reader holds it directly; only then is its own Previous dropped
+// and, once no newer snapshot blends against it either, it is recycled for the next write. Steady
+// state rotates two buffers, or three when snapshots keep their previous, without allocating.
+class JK_WINDSYSTEM_API FWindSnapshotChannel
+{
+public:
+    FWindSnapshotChannel();
+    ~FWindSnapshotChannel();
+
+    // Latest published snapshot, or null before the first publish. Lock-free.
+    TRefCountPtr<FWindSnapshot> Acquire() const;
+
+    // A snapshot no reader references, to be filled and passed to Publish
+    TRefCountPtr<FWindSnapshot> BeginWrite();
+    void Publish(TRefCountPtr<FWindSnapshot> Snapshot);
+
+    // Drops the published snapshot. Readers still holding it are unaffected.
+    void Reset();
+
+private:
+    // Holds one reference to the published snapshot
+    std::atomic<FWindSnapshot*> Current;
+    // Readers inside Acquire, between loading Current and taking a reference
+    mutable std::atomic<int32> NumAcquiring;
+
+    // Writer side only. Each entry holds one reference.
+    FCriticalSection WriterLock;
+    TArray<FWindSnapshot*> Retired;
+    TArray<FWindSnapshot*> Recycled;
+
+    void Retire(FWindSnapshot* Snapshot);
+    void CollectRetired();
+    // Published snapshots that blend against Snapshot
+    int32 CountSuccessors(const FWindSnapshot* Snapshot) const;
+
+    FWindSnapshotChannel(const FWindSnapshotChannel&) = delete;
+    FWindSnapshotChannel& operator=(const FWindSnapshotChannel&) = delete;
+};
@@ -0,0 +1,117 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/SharedPointer.h"
+
+enum class EWindSolverBackend : uint8;
+class FWindZoneMask;
+
+// Parameters shared by every solver backend. Backends ignore the fields that do not apply to them.
+struct FWindSolverConfig
+{
+    // Cells per side of the simulated domain
+    int32 GridSize = 32;
+    float CellSize = 100.0f;
+    float Viscosity = 0.1f;
+    // Fixed step for backends that sub-step internally
+    float TimeStep = 1.0f / 60.0f;
+    float MaxVelocity = 1000000.0f;
+
+    // Absorbing layer along the faces that relaxes wind toward the ambient wind. Strength is the
+    // relaxation rate in 1/s at the face and ramps quadratically to zero SpongeWidth cells inside.
+    int32 SpongeWidth = 0;
+    float SpongeStrength = 2.0f;
+    // Faces where the ambient wind enters the domain are held at the ambient wind; the other faces
+    // stay zero-gradient outflow
+    bool bOpenBoundaries = false;
+
+    // Cells per tile when a backend splits its passes into tasks; non-positive extents span the
+    // whole domain along that axis. MaxTileWorkers also caps passes that are not tiled; 0 uses
+    // every task graph worker.
+    FIntVector TileSize = FIntVector(16, 16, 4);
+    int32 MaxTileWorkers = 0;
+
+    // Layered backend only: GridSize x GridSize cells in each of NumBands altitude bands
+    int32 NumBands = 6;
+    float BandHeight = 5000.0f;
+    float VerticalExchange = 0.5f;
+};
+
+// UObject-free wind solver. Positions are relative to the domain origin (the centre of cell 0,0,0)
+// in world units, so a backend can be created, stepped and benchmarked without a world.
+class JK_WINDSYSTEM_API IWindSolverBackend
+{
+public:
+    virtual ~IWindSolverBackend() = default;
+
+    virtual const TCHAR* GetName() const = 0;
+
+    virtual void Initialize(const FWindSolverConfig& InConfig) = 0;
+    virtual bool IsInitialized() const = 0;
+    virtual const FWindSolverConfig& GetConfig() const = 0;
+
+    // Reallocates the domain at a new resolution and resamples the current velocity into it.
+    // Solid cells are cleared.
+    virtual void Resize(int32 NewGridSize, float NewCellSize) = 0;
+
+    virtual void Step(float DeltaTime) = 0;
+
+    // Resumable stepping for time-sliced schedules. BeginStep latches a step, then each StepSlice
+    // runs one bounded unit of it and returns true once the step is complete. Backends without
+    // finer stages run the whole step in the first slice.
+    virtual void BeginStep(float DeltaTime);
+    virtual bool StepSlice();
+    // Fraction of the current resumable step that has run, 1 when no step is in progress
+    virtual float GetStepProgress() const;
+
+    // Inject and SetSolid return false when the position lies outside the domain
+    virtual bool AddVelocity(const FVector& LocalPosition, const FVector& Velocity) = 0;
+    virtual FVector SampleVelocity(const FVector& LocalPosition) const = 0;
+    virtual bool SetSolid(const FVector& LocalPosition, bool bSolid) = 0;
+    // Cell AddVelocity would write for a position, as an index into the exported grid, or
+    // INDEX_NONE outside the domain
+    virtual int32 GetCellIndex(const FVector& LocalPosition) const = 0;
+    // AddVelocity on a cell index from GetCellIndex
+    virtual void AddVelocityAtCell(int32 CellIndex, const FVector& Velocity) = 0;
+
+    // Moves the contents by whole cells, filling new cells with air at rest
+    virtual void Shift(const FIntVector& CellOffset) = 0;
+
+    // Far-field wind used by the sponge layer and inflow faces
+    virtual void SetAmbientWind(const FVector& AmbientVelocity) = 0;
+
+    // Zone modifiers applied to the flow at the end of every step, laid out like the exported
+    // grid. Null removes them.
+    void SetZoneMask(TSharedPtr<const FWindZoneMask> InZoneMask) { ZoneMask = MoveTemp(InZoneMask); }
+    const TSharedPtr<const FWindZoneMask>& GetZoneMask() const { return ZoneMask; }
+
+    // The backend state as a regular node-centred grid, X fastest
+    virtual FIntVector GetDimensions() const = 0;
+    virtual FVector GetCellSpacing() const = 0;
+    virtual void ExportVelocity(TArray<FVector>& OutVelocity) const = 0;
+
+protected:
+    TSharedPtr<const FWindZoneMask> ZoneMask;
+
+    // State of the default single-slice implementation
+    float PendingStepTime = 0.0f;
+    bool bStepPending = false;
+};
+
+namespace WindSolverBackend
+{
+    JK_WINDSYSTEM_API TSharedPtr<IWindSolverBackend> Create(EWindSolverBackend Backend);
+
+    // Injects Source's velocity at every node of Target. Used by Resize implementations.
+    JK_WINDSYSTEM_API void Resample(const IWindSolverBackend& Source, IWindSolverBackend& Target);
+
+    // Per-step sponge relaxation factors indexed by distance to the nearest face, in cells.
+    // Empty when the sponge layer is disabled.
+    JK_WINDSYSTEM_API void GetSpongeBlend(const FWindSolverConfig& Config, float DeltaTime, TArray<float>& OutBlend);
+
+    // Whether the ambient wind enters the domain through the face on Side (-1 or +1) of Axis
+    FORCEINLINE bool IsInflowFace(const FWindSolverConfig& Config, const FVector& AmbientVelocity, int32 Axis, int32 Side)
+    {
+        return Config.bOpenBoundaries && AmbientVelocity[Axis] * Side < 0.0;
+    }
+}
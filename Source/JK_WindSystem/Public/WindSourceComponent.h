@@ -7,6 +7,7 @@
 #include "WindSourceComponent.generated.h"
 
 class UWindSimulationSubsystem;
+class FWindForcingGrid;
 
 UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
 class JK_WINDSYSTEM_API UWindGeneratorComponent : public USceneComponent
@@ -30,8 +31,15 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wind")
     float UpdateFrequency = 0.1f;
 
-    // New function to update wind simulation
-    virtual void UpdateWindSimulation(float DeltaTime, UWindSimulationSubsystem* Subsystem);
+    // Advances the update timer. True once UpdateFrequency has elapsed, restarting the timer.
+    bool ConsumeUpdate(float DeltaTime);
+
+    // World-space box outside which GetWindVelocityAtLocation is zero
+    virtual FBox GetWindBounds() const;
+
+    // Evaluates the generator on the forcing grid nodes inside GetWindBounds. Shapes smaller than
+    // a cell are supersampled and splatted so they still reach the grid. Deterministic.
+    virtual void RasterizeWind(FWindForcingGrid& Forcing) const;
 
 protected:
     virtual void BeginPlay() override;
@@ -97,6 +105,7 @@ public:
     USplineWindGeneratorComponent();
 
     virtual FVector GetWindVelocityAtLocation(const FVector& Location) const override;
+    virtual FBox GetWindBounds() const override;
 
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Wind")
     class USplineComponent* WindSpline;
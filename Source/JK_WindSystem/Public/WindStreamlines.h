@@ -0,0 +1,58 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WindStreamlines.generated.h"
+
+UENUM(BlueprintType)
+enum class EWindTraceIntegrator : uint8
+{
+    // Midpoint method, two velocity fetches per step
+    RK2,
+    // Classic Runge-Kutta, four velocity fetches per step and far less drift in curving flow
+    RK4
+};
+
+USTRUCT(BlueprintType)
+struct JK_WINDSYSTEM_API FWindTraceSettings
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wind Trace")
+    EWindTraceIntegrator Integrator = EWindTraceIntegrator::RK4;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wind Trace", meta = (ClampMin = "1"))
+    int32 NumSteps = 30;
+
+    // Seconds advanced per step, so a trace covers NumSteps * StepTime seconds of drift
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wind Trace", meta = (ClampMin = "0.0"))
+    float StepTime = 0.1f;
+
+    // Points per seed in a trace's output: the seed itself, then one per step
+    int32 GetNumPoints() const { return FMath::Max(NumSteps, 0) + 1; }
+};
+
+USTRUCT(BlueprintType)
+struct JK_WINDSYSTEM_API FWindTracePolyline
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Wind Trace")
+    TArray<FVector> Points;
+};
+
+// Integrates many seeds through a velocity field at once. Seeds are advanced in chunks that share
+// every velocity fetch, so each Runge-Kutta stage is one batched query per chunk, and the chunks
+// run in parallel.
+class JK_WINDSYSTEM_API FWindStreamlineTracer
+{
+public:
+    // Fills OutVelocities with the velocity at each position. Called concurrently from workers.
+    using FSampler = TFunctionRef<void(TConstArrayView<FVector> Positions, TArrayView<FVector> OutVelocities)>;
+
+    // Writes Settings.GetNumPoints() points per seed to OutPoints, seed after seed, which must be
+    // at least that long
+    static void Trace(TConstArrayView<FVector> Seeds, const FWindTraceSettings& Settings, FSampler Sampler, TArrayView<FVector> OutPoints);
+
+    // Splits a flat trace into one polyline per seed
+    static void ToPolylines(TConstArrayView<FVector> Points, int32 NumPointsPerSeed, TArray<FWindTracePolyline>& OutPolylines);
+};
@@ -3,11 +3,20 @@
 #include "CoreMinimal.h"
 #include "Subsystems/WorldSubsystem.h"
 #include "WindSourceComponent.h"
+#include "WindQueryHandle.h"
+#include "WindZoneIndex.h"
+#include "WindVelocityDerivatives.h"
+#include "WindStreamlines.h"
+#include "WindQueryView.h"
+#include "WindInjectionQueue.h"
+#include "HAL/CriticalSection.h"
 #include "WindSubsystem.generated.h"
 
 class AWindSystemActor;
 class UWindGeneratorComponent;
 class UWindZoneVolumeComponent;
+class FWindForcingGrid;
+class FWindZoneMask;
 UCLASS()
 class JK_WINDSYSTEM_API UWindSimulationSubsystem : public UWorldSubsystem
 {
@@ -25,8 +34,61 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Wind Simulation")
     FVector GetWindVelocityAtLocation(const FVector& WorldLocation) const;
 
+    // Wind at many points from one simulation snapshot, zones included. Much cheaper per point
+    // than GetWindVelocityAtLocation. OutVelocities must be at least as long as Locations.
+    void GetWindVelocitiesAtLocations(TConstArrayView<FVector> Locations, TArrayView<FVector> OutVelocities) const;
+
+    // Wind averaged over a region about Footprint across, zones included. Reads a coarser level of
+    // the simulation's mip pyramid the larger the footprint, for consumers that are far away.
+    UFUNCTION(BlueprintCallable, Category = "Wind Simulation")
+    FVector GetWindVelocityAtLocationLod(const FVector& WorldLocation, float Footprint) const;
+    void GetWindVelocitiesAtLocationsLod(TConstArrayView<FVector> Locations, float Footprint, TArrayView<FVector> OutVelocities) const;
+
+    // Mean wind over an axis-aligned box in constant time, for sails, vehicles and tree clusters.
+    // Zones that block flow are part of the simulated wind; redirecting zones are not applied.
+    UFUNCTION(BlueprintCallable, Category = "Wind Simulation")
+    FVector GetAverageWindInBox(const FBox& Box) const;
+
+    // Wind with its Jacobian, curl, divergence and turbulence intensity from one neighbourhood
+    // fetch, in place of finite-differencing several point queries. Zones apply inside the grid.
+    UFUNCTION(BlueprintCallable, Category = "Wind Simulation")
+    FWindVelocityDerivatives GetWindDerivativesAtLocation(const FVector& WorldLocation) const;
+    void GetWindDerivativesAtLocations(TConstArrayView<FVector> Locations, TArrayView<FWindVelocityDerivatives> OutDerivatives) const;
+
+    // Predicts where each seed drifts over the next Settings.NumSteps * Settings.StepTime seconds,
+    // integrating all of them through one snapshot in a single parallel pass. Writes
+    // Settings.GetNumPoints() points per seed to OutPoints. Zones apply inside the grid.
+    void TraceWindStreamlines(TConstArrayView<FVector> Seeds, const FWindTraceSettings& Settings, TArrayView<FVector> OutPoints) const;
+
+    // Snapshot, turbulence and zones as of the last tick, as one immutable view. Safe to call from
+    // any thread, including physics, animation and audio workers: it takes no simulation lock and
+    // the view touches no UObject, so a consumer can hold it for a frame and query it freely.
+    // Queries on it match GetWindVelocityAtLocation and the other queries above.
+    FWindQueryView GetQueryView() const;
+
+    // Registers a query resolved once per tick, after the simulation advanced, in one batch with
+    // every other registered query. LocationProvider is called on the game thread.
+    FWindQueryHandle RegisterWindQuery(TFunction<FVector()> LocationProvider);
+    // Registered query that follows a component. Resolves to zero once the component is gone.
+    FWindQueryHandle RegisterWindQuery(const USceneComponent* Component);
+    // Releases the query and invalidates the handle
+    void UnregisterWindQuery(FWindQueryHandle& Handle);
+
+    // Wind at the query's location as of the last resolve, zones included. Zero for stale handles.
+    FORCEINLINE FVector GetQueriedWindVelocity(const FWindQueryHandle& Handle) const
+    {
+        return IsWindQueryValid(Handle) ? QueryResults[Handle.Index] : FVector::ZeroVector;
+    }
+    FORCEINLINE bool IsWindQueryValid(const FWindQueryHandle& Handle) const
+    {
+        return QuerySlots.IsValidIndex(Handle.Index) && QuerySlots[Handle.Index].Serial == Handle.Serial && QuerySlots[Handle.Index].bActive;
+    }
+    int32 GetNumWindQueries() const { return QuerySlots.Num() - FreeQuerySlots.Num(); }
+
     UFUNCTION(BlueprintCallable, Category = "Wind Simulation")
     void AddWindAtLocation(const FVector& Location, const FVector& WindVelocity);
+    // Many injections handed over as one batch, for producers that add wind at many points a tick
+    void AddWindAtLocations(TArray<FWindInjection> Injections);
 
     void RegisterWindGenerator(UWindGeneratorComponent* WindGenerator);
     void UnregisterWindGenerator(UWindGeneratorComponent* WindGenerator);
@@ -37,6 +99,8 @@ public:
 
     void RegisterWindZone(UWindZoneVolumeComponent* Modifier);
     void UnregisterWindZone(UWindZoneVolumeComponent* Modifier);
+    // Re-indexes a zone after it moved or changed size
+    void UpdateWindZone(UWindZoneVolumeComponent* Modifier);
 
     UFUNCTION(BlueprintCallable, Category = "Wind Simulation")
     AWindSystemActor* GetWindSystemActor() const { return WindSystemActor; }
@@ -46,18 +110,66 @@ private:
     AActor* WindGridCenter;
 
     // UPROPERTY()
+    // Applied in registration order; a zone's position here is its id in ZoneIndex
     TArray<UWindZoneVolumeComponent*> WindZones;
+    FWindZoneIndex ZoneIndex;
+
+    // Zones voxelized onto the simulation grid, rebuilt when a zone changes or the grid moves.
+    // Queries inside the grid read it instead of testing zones.
+    TSharedPtr<FWindZoneMask> ZoneMask;
+    bool bZoneMaskDirty = false;
 
     // UPROPERTY()
     AWindSystemActor* WindSystemActor;
 
     // UPROPERTY()
+    // Only changed at the start of UpdateWindGenerators, so workers can read it without a lock
     TArray<UWindGeneratorComponent*> WindGenerators;
+
+    // Registrations since the last update. GeneratorsLock guards these lists only.
+    TArray<UWindGeneratorComponent*> PendingGeneratorAdds;
+    TArray<UWindGeneratorComponent*> PendingGeneratorRemovals;
     FCriticalSection GeneratorsLock;
 
+    // Generators due this update, split into contiguous runs between the workers
+    TArray<UWindGeneratorComponent*> DueGenerators;
+
+    // Generators rasterize here; handed to the simulation and reused once it lets go of it
+    TSharedPtr<FWindForcingGrid> GeneratorForcing;
+    // Private forcing of every worker but the first, which writes straight into GeneratorForcing
+    TArray<FWindForcingGrid> WorkerForcing;
+
+    struct FWindQuerySlot
+    {
+        TFunction<FVector()> LocationProvider;
+        TWeakObjectPtr<const USceneComponent> Component;
+        uint32 Serial = 0;
+        bool bActive = false;
+    };
+
+    // Registered queries. Locations and results are kept apart from the slots so the resolve
+    // passes them straight to the batched query.
+    TArray<FWindQuerySlot> QuerySlots;
+    TArray<int32> FreeQuerySlots;
+    TArray<FVector> QueryLocations;
+    TArray<FVector> QueryResults;
+
+    // Rebuilt on the game thread each tick. QueryViewLock only guards the copy in and out.
+    FWindQueryView QueryView;
+    mutable FRWLock QueryViewLock;
+
     FTSTicker::FDelegateHandle TickHandle;
 
     void UpdateWindGenerators(float DeltaTime);
+    void ApplyGeneratorChanges();
+    void RebuildZoneIndex();
+    // Applies the zones the simulation's mask does not cover to velocities it returned
+    FVector ApplyWindZones(const FVector& WorldLocation, FVector WindVelocity) const;
+    void ApplyWindZones(TConstArrayView<FVector> Locations, TArrayView<FVector> OutVelocities) const;
+    void UpdateZoneMask();
+    FWindQueryHandle AllocateWindQuery();
+    void ResolveWindQueries();
+    void PublishQueryView();
     void EnsureWindSystemActorInitialized();
     void DestroyWindSystemActor();
 };
\ No newline at end of file
@@ -2,58 +2,27 @@
 
 #include "CoreMinimal.h"
 #include "Components/SceneComponent.h"
-#include "HAL/Runnable.h"
-#include "HAL/ThreadSafeBool.h"
 #include "HAL/CriticalSection.h"
 #include "Containers/Array.h"
 #include "Templates/SharedPointer.h"
 #include "WindSystemSettings.h"
+#include "WindTurbulenceField.h"
+#include "WindQueryView.h"
+#include "WindSolverBackend.h"
+#include "WindSimulationScheduler.h"
+#include "WindSnapshot.h"
+#include "WindInjectionQueue.h"
+#include "WindInputFrame.h"
+#include "WindVelocityDerivatives.h"
+#include "WindStreamlines.h"
 #include "WindSystemComponent.generated.h"
 
 class UWindSimulationComponent;
 class UWindGPUSimulationComponent;
+class UWindSettingsDataAsset;
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnWindCellUpdated, const FVector&, CellCenter, const FVector&, WindVelocity, float, CellSize);
 
-class JK_WINDSYSTEM_API FWindGrid
-{
-public:
-    FWindGrid(int32 Size, float InCellSize);
-
-    FVector GetCell(int32 X, int32 Y, int32 Z) const;
-    void SetCell(int32 X, int32 Y, int32 Z, const FVector& Value);
-
-    int32 GetSize() const { return GridSize; }
-    FIntVector GetBoundSize() const { return FIntVector(GridSize, GridSize, GridSize); }
-    float GetCellSize() const { return CellSize; }
-
-    TArray<FVector>& GetGridData() { return Grid; }
-    // Add a const version
-    const TArray<FVector>& GetGridData() const { return Grid; }
-
-private:
-    TArray<FVector> Grid;
-    int32 GridSize;
-    float CellSize;
-
-    FORCEINLINE int32 GetIndex(int32 X, int32 Y, int32 Z) const;
-    FORCEINLINE bool IsValidIndex(int32 X, int32 Y, int32 Z) const;
-
-friend UWindSimulationComponent;
-};
-
-class FWindSimulationWorker : public FRunnable
-{
-public:
-    FWindSimulationWorker(class UWindSimulationComponent* InOwner);
-    virtual uint32 Run() override;
-    void Stop();
-
-private:
-    class UWindSimulationComponent* Owner;
-    FThreadSafeBool bShouldRun;
-};
-
 UCLASS(ClassGroup = (Custom), HideCategories = (Rendering, Replication, Collision, HLOD, Mobile, Physics, Mobility, VirtualTexture, ComponentTick))
 class JK_WINDSYSTEM_API UWindSimulationComponent : public USceneComponent
 {
@@ -69,9 +38,50 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Wind Simulation")
     virtual FVector GetWindVelocityAtLocation(const FVector& Location) const;
 
+    // GetWindVelocityAtLocation for many points against one snapshot. Large batches are split
+    // across task graph workers. OutVelocities must be at least as long as Locations.
+    virtual void GetWindVelocitiesAtLocations(TConstArrayView<FVector> Locations, TArrayView<FVector> OutVelocities) const;
+
+    // Wind averaged over a region about Footprint across, read from the snapshot's mip pyramid.
+    // Cheaper and steadier than GetWindVelocityAtLocation for distant consumers; turbulence below
+    // the footprint is filtered out with the rest of the fine detail.
+    UFUNCTION(BlueprintCallable, Category = "Wind Simulation")
+    virtual FVector GetWindVelocityAtLocationLod(const FVector& Location, float Footprint) const;
+    virtual void GetWindVelocitiesAtLocationsLod(TConstArrayView<FVector> Locations, float Footprint, TArrayView<FVector> OutVelocities) const;
+
+    // Mean wind over an axis-aligned box, rounded to whole cells, in constant time from the
+    // snapshot's summed-volume table. Resolved wind only: no turbulence and no redirecting zones.
+    UFUNCTION(BlueprintCallable, Category = "Wind Simulation")
+    virtual FVector GetAverageWindInBox(const FBox& Box) const;
+
+    // Wind with its Jacobian, curl, divergence and turbulence intensity, all from the one stencil
+    // a plain query reads. Resolved wind only, without turbulence noise.
+    UFUNCTION(BlueprintCallable, Category = "Wind Simulation")
+    virtual FWindVelocityDerivatives GetWindDerivativesAtLocation(const FVector& Location) const;
+    virtual void GetWindDerivativesAtLocations(TConstArrayView<FVector> Locations, TArrayView<FWindVelocityDerivatives> OutDerivatives) const;
+
+    // Integrates every seed through the latest snapshot, held steady for the whole trace, and
+    // writes Settings.GetNumPoints() points per seed to OutPoints. Resolved wind with zones applied;
+    // turbulence noise is left out so traces stay smooth.
+    virtual void TraceWindStreamlines(TConstArrayView<FVector> Seeds, const FWindTraceSettings& Settings, TArrayView<FVector> OutPoints) const;
+
     UFUNCTION(BlueprintCallable, Category = "Wind Simulation")
     virtual void AddWindAtLocation(const FVector& Location, const FVector& WindVelocity);
 
+    // AddWindAtLocation for many points at once, queued as a single batch. Lock-free.
+    void AddWindAtLocations(TArray<FWindInjection> Injections);
+
+    // Queues a forcing field, laid out like the published snapshot, for the next step. Lock-free.
+    void AddWindField(TSharedPtr<const FWindForcingGrid> Forcing);
+
+    // Wind zones voxelized onto the published grid layout. Takes effect at the start of the next
+    // step, and only while the grid keeps that layout. Null removes the zones.
+    void SetZoneMask(TSharedPtr<const FWindZoneMask> Mask);
+
+    // Takes effect at the start of the next step
+    UFUNCTION(BlueprintCallable, Category = "Wind Simulation")
+    void SetObstacleAtLocation(const FVector& Location, bool bIsObstacle);
+
     UFUNCTION(BlueprintCallable, Category = "Wind Simulation")
     float GetSimulationFrequency() const { return SimulationFrequency; }
 
@@ -81,8 +91,37 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Wind Simulation")
     float GetCellSize() const { return CellSize; }
 
+    // Reallocates the simulation at a new resolution, resampling the current wind into it
+    UFUNCTION(BlueprintCallable, Category = "Wind Simulation")
+    void ResizeGrid(int32 NewGridSize, float NewCellSize);
+
+    EWindSolverBackend GetSolverBackend() const { return SolverBackend; }
+    const IWindSolverBackend* GetSolver() const { return Solver.Get(); }
+
+    // Latest published simulation state. Safe to call and sample from any thread without locking.
+    TRefCountPtr<FWindSnapshot> GetSnapshot() const { return Snapshots.Acquire(); }
+
+    // Latest snapshot with the turbulence settings, as a view the wind queries above all run on.
+    // Settings are read here, so call it on the game thread; the view itself may go to any thread.
+    FWindQueryView MakeQueryView() const;
+
     void virtual SimulationStep(float DeltaTime);
 
+    // Feeds frame time to the scheduler, which runs however many fixed steps are due
+    void AdvanceSimulation(float DeltaTime, bool bPaused);
+
+    FWindSchedulerStats GetSchedulerStats() const;
+    EWindSchedulerMode GetSchedulerMode() const;
+
+    // Resumable form of SimulationStep used by the time-sliced scheduler. The snapshot is only
+    // published once the last slice completes.
+    void BeginSimulationStep(float DeltaTime);
+    bool StepSimulationSlice();
+
+    // Fraction of the current time-sliced step that has run, 1 between steps
+    UFUNCTION(BlueprintCallable, Category = "Wind Simulation")
+    float GetSimulationStepProgress() const;
+
     UFUNCTION(BlueprintCallable, Category = "Wind Simulation|Testing")
     void InitializeForTesting();
 
@@ -92,15 +131,31 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Wind Simulation")
     float GetMaxAllowedWindVelocity() const;
 
+    // Moves the grid at the start of the next step. Never waits on a running step.
     void UpdateGridCenter(const FVector& NewCenter);
+
+    // Global wind and turbulence settings. Falls back to the asset referenced by UWindSystemSettings.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wind Simulation")
+    UWindSettingsDataAsset* WindSettingsAsset;
+
+    // Among simulations due at the same time on the shared worker pool, higher priorities step first
+    UPROPERTY(EditAnywhere, Category = "Wind Simulation|Workers")
+    int32 SimulationPriority = 0;
+
+    // Average fraction of one pool worker this simulation may use. Steps are delayed while over
+    // budget; a backlog of four or more steps is dropped. 0 leaves it unlimited.
+    UPROPERTY(EditAnywhere, Category = "Wind Simulation|Workers", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+    float SimulationCpuBudget = 0.0f;
+
 protected:
-    TSharedPtr<FWindGrid> WindGrid;
-    TSharedPtr<FWindGrid> TempGrid;
+    TSharedPtr<IWindSolverBackend> Solver;
     float Viscosity;
     float SimulationFrequency;
+    EWindSolverBackend SolverBackend;
+    EWindTemporalSampling TemporalSampling;
 
-    FWindSimulationWorker* SimulationWorker;
-    FRunnableThread* SimulationThread;
+    // Sole owner of simulation stepping, so the solver never advances from two places at once
+    TUniquePtr<FWindSimulationScheduler> Scheduler;
 
     mutable FCriticalSection SimulationLock;
 
@@ -113,21 +168,60 @@ protected:
     FVector PreviousGridCenter;
     bool bIsBroadcasting = false;
 
+    // Queries read the published snapshot and never take SimulationLock
+    FWindSnapshotChannel Snapshots;
+
+    // Sub-grid turbulence synthesized at query time from the exported solver state. Shared with
+    // the query views, which may outlive the component.
+    TSharedPtr<const FWindTurbulenceField> TurbulenceField;
+    float SimulationTime;
+
+    bool bSlicedStepInProgress = false;
+    float SlicedStepTime = 0.0f;
+
+    // Wind added since the last step. AddWindAtLocation only pushes here, so it never waits on a
+    // running step; the queue is applied at the start of the next one.
+    FWindInjectionQueue InjectionQueue;
+
+    // Inputs for the next step and those of the step being solved. InputLock only guards
+    // GatherFrame, so the game thread never waits on SimulationLock to hand over inputs.
+    FWindInputFrame GatherFrame;
+    FWindInputFrame SolveFrame;
+    FCriticalSection InputLock;
+    // Set once SolveFrame holds the inputs of the next step, cleared when that step consumes them
+    std::atomic<bool> bInputFrameSealed{ false };
+    // Cell index and velocity of every queued contribution, merged per cell before it is applied
+    TArray<TPair<int32, FVector>> PendingCellForces;
+    // Latest zone mask handed over, whether or not it still lines up with the grid
+    TSharedPtr<const FWindZoneMask> ZoneMask;
+
     const UWindSystemSettings* GetSettings() const;
 
-    bool IsGridInitialized() const { return WindGrid != nullptr; }
+    bool IsGridInitialized() const { return Solver.IsValid(); }
 private:
     
 
     void InitializeGrid();
-    void SwapGrids();
+    void InitializeScheduler();
     void HandleGridMovement();
-    
-    
-    void Diffuse(TSharedPtr<FWindGrid> Dst, const TSharedPtr<FWindGrid> Src, float Diff, float Dt);
-    void Project(TSharedPtr<FWindGrid> Velocity, TSharedPtr<FWindGrid> P, TSharedPtr<FWindGrid> Div);
-    void SetBoundary(TSharedPtr<FWindGrid> Field);
-    void Advect(TSharedPtr<FWindGrid> Dst, const TSharedPtr<FWindGrid> Src, const TSharedPtr<FWindGrid> Velocity, float Dt);
-    void ApplySIMDOperations(TSharedPtr<FWindGrid> Grid, float Scalar);
-    FVector InterpolateVelocity(const FVector& Position) const;
+    // Closes the gathered inputs for the next step and starts gathering the one after. Called on
+    // the game thread by Pipelined mode once per batch of steps, otherwise at the start of each
+    // step itself.
+    void SealInputFrame();
+    // Applies the sealed inputs to the solver. Called with SimulationLock held.
+    void ApplyInputFrame();
+    // Adds the frame's wind to the solver, merging everything that lands in the same cell
+    void ApplyQueuedWind();
+    // Hands ZoneMask to the solver if it matches the current grid, shifted along if the grid moved
+    // by whole cells since it was voxelized, otherwise clears the solver's
+    void UpdateSolverZoneMask();
+    void GatherFieldForces(const FWindForcingGrid& Forcing);
+    FWindSolverConfig MakeSolverConfig() const;
+    FVector GetAmbientWind() const;
+
+    // Exports the solver state into a new snapshot and publishes it. Called with SimulationLock held.
+    void PublishSnapshot();
+    void UpdateTurbulenceEnergy(FWindSnapshot& Snapshot) const;
+    // MakeQueryView, logging when nothing is published yet
+    FWindQueryView MakeCheckedQueryView() const;
 };
@@ -16,9 +16,12 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wind Settings")
     FVector GlobalWindDirection = FVector(1.0f, 0.0f, 0.0f);
 
+    // Sub-grid flutter amplitude reached where the simulated wind speed equals GlobalWindStrength
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wind Settings")
     float TurbulenceStrength = 10.0f;
 
+    // Turbulence noise tiles per grid cell. Each tile holds several noise features, so values
+    // around 0.1 produce detail at roughly the cell scale and higher values add finer flutter.
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wind Settings")
     float TurbulenceFrequency = 0.1f;
 
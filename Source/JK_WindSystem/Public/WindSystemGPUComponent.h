@@ -22,6 +22,13 @@ public:
     virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
     virtual FVector GetWindVelocityAtLocation(const FVector& Location) const override;
+    virtual void GetWindVelocitiesAtLocations(TConstArrayView<FVector> Locations, TArrayView<FVector> OutVelocities) const override;
+    virtual FVector GetWindVelocityAtLocationLod(const FVector& Location, float Footprint) const override;
+    virtual void GetWindVelocitiesAtLocationsLod(TConstArrayView<FVector> Locations, float Footprint, TArrayView<FVector> OutVelocities) const override;
+    virtual FVector GetAverageWindInBox(const FBox& Box) const override;
+    virtual FWindVelocityDerivatives GetWindDerivativesAtLocation(const FVector& Location) const override;
+    virtual void GetWindDerivativesAtLocations(TConstArrayView<FVector> Locations, TArrayView<FWindVelocityDerivatives> OutDerivatives) const override;
+    virtual void TraceWindStreamlines(TConstArrayView<FVector> Seeds, const FWindTraceSettings& Settings, TArrayView<FVector> OutPoints) const override;
     virtual void AddWindAtLocation(const FVector& Location, const FVector& WindVelocity) override;
 
     virtual void SimulationStep(float DeltaTime) override;
@@ -4,6 +4,44 @@
 #include "UObject/NoExportTypes.h"
 #include "WindSystemSettings.generated.h"
 
+class UWindSettingsDataAsset;
+
+UENUM()
+enum class EWindSolverBackend : uint8
+{
+    StableFluids,
+    LatticeBoltzmann,
+    // 2.5D altitude bands for large open worlds, configured by the Layered settings below
+    Layered
+};
+
+UENUM()
+enum class EWindSchedulerMode : uint8
+{
+    // Steps run inline from the subsystem tick
+    GameThread,
+    // Steps run on the shared wind worker pool, paced against absolute deadlines
+    DedicatedThread,
+    // Steps due each frame run as one batch on the shared wind worker pool
+    TaskGraph,
+    // Each step is split into slices spread over several game thread frames
+    TimeSliced,
+    // Each step runs on the shared wind worker pool on the inputs sealed when it launched, while
+    // the game thread gathers the inputs of the next one
+    Pipelined
+};
+
+UENUM()
+enum class EWindTemporalSampling : uint8
+{
+    // Queries return the most recent step as is
+    Latest,
+    // Queries blend the last two steps by the time elapsed since the latest, trailing one step behind
+    Interpolate,
+    // Queries continue the trend of the last two steps forward, up to one step ahead
+    Extrapolate
+};
+
 UCLASS(config=JK_WindSystem, defaultconfig)
 class JK_WINDSYSTEM_API UWindSystemSettings : public UObject
 {
@@ -26,4 +64,79 @@ public:
 
     UPROPERTY(config, EditAnywhere, Category = "Wind Simulation", meta = (ClampMin = "1.0"))
     float SimulationFrequency;
+
+    // Global wind and turbulence settings used when a simulation component has no asset assigned
+    UPROPERTY(config, EditAnywhere, Category = "Wind Simulation")
+    TSoftObjectPtr<UWindSettingsDataAsset> WindSettingsAsset;
+
+    UPROPERTY(config, EditAnywhere, Category = "Wind Simulation")
+    EWindSolverBackend SolverBackend;
+
+    // Where fixed steps of 1 / SimulationFrequency are executed
+    UPROPERTY(config, EditAnywhere, Category = "Wind Simulation")
+    EWindSchedulerMode SchedulerMode;
+
+    // How queries fill in the time between simulation steps. Lets SimulationFrequency drop well
+    // below the frame rate without visible stepping.
+    UPROPERTY(config, EditAnywhere, Category = "Wind Simulation")
+    EWindTemporalSampling TemporalSampling;
+
+    // Game thread time per frame a time-sliced step may use before yielding to the next frame
+    UPROPERTY(config, EditAnywhere, Category = "Wind Simulation|Time Slicing", meta = (ClampMin = "0.0"))
+    float TimeSliceBudgetMs;
+
+    // Frames a time-sliced step is spread over. The budget is exceeded if needed to finish in time.
+    UPROPERTY(config, EditAnywhere, Category = "Wind Simulation|Time Slicing", meta = (ClampMin = "1"))
+    int32 TimeSliceFramesPerStep;
+
+    // Cells per task when a solver pass is split across workers. Flatter tiles suit small grids,
+    // cubic ones keep stencil reads in cache on large grids. 0 spans the whole domain on that axis.
+    UPROPERTY(config, EditAnywhere, Category = "Wind Simulation|Tiling", meta = (ClampMin = "0"))
+    FIntVector SolverTileSize;
+
+    // Workers sharing the tiles of a pass, and the most threads any other parallel pass of a step
+    // or snapshot build uses. 0 uses every task graph worker.
+    UPROPERTY(config, EditAnywhere, Category = "Wind Simulation|Tiling", meta = (ClampMin = "0"))
+    int32 SolverTileWorkers;
+
+    // Threads of the worker pool shared by every simulation in DedicatedThread, TaskGraph and
+    // Pipelined modes, across all worlds. Caps how many steps run at once however many domains
+    // exist; SolverTileWorkers caps the threads each of those steps fans out to.
+    UPROPERTY(config, EditAnywhere, Category = "Wind Simulation|Workers", meta = (ClampMin = "1"))
+    int32 SimulationWorkerThreads;
+
+    // Workers evaluating wind generators in parallel, each into its own forcing buffer. 0 uses
+    // every task graph worker.
+    UPROPERTY(config, EditAnywhere, Category = "Wind Simulation|Generators", meta = (ClampMin = "0"))
+    int32 GeneratorWorkers;
+
+    // Cells per side of each altitude band
+    UPROPERTY(config, EditAnywhere, Category = "Wind Simulation|Layered", meta = (ClampMin = "4"))
+    int32 LayeredGridResolution;
+
+    UPROPERTY(config, EditAnywhere, Category = "Wind Simulation|Layered", meta = (ClampMin = "1.0"))
+    float LayeredCellSize;
+
+    UPROPERTY(config, EditAnywhere, Category = "Wind Simulation|Layered", meta = (ClampMin = "1"))
+    int32 LayeredBandCount;
+
+    // Vertical distance between band centres
+    UPROPERTY(config, EditAnywhere, Category = "Wind Simulation|Layered", meta = (ClampMin = "1.0"))
+    float LayeredBandHeight;
+
+    // Rate at which neighbouring bands exchange momentum, per second
+    UPROPERTY(config, EditAnywhere, Category = "Wind Simulation|Layered", meta = (ClampMin = "0.0"))
+    float LayeredVerticalExchange;
+
+    // Cells along each face that relax the wind toward the global wind. 0 disables the layer.
+    UPROPERTY(config, EditAnywhere, Category = "Wind Simulation|Boundaries", meta = (ClampMin = "0"))
+    int32 SpongeLayerWidth;
+
+    // Relaxation rate at the outer face, per second
+    UPROPERTY(config, EditAnywhere, Category = "Wind Simulation|Boundaries", meta = (ClampMin = "0.0"))
+    float SpongeLayerStrength;
+
+    // Hold the global wind on the faces it blows in through and let it leave freely through the rest
+    UPROPERTY(config, EditAnywhere, Category = "Wind Simulation|Boundaries")
+    bool bInflowOutflowBoundaries;
 };
\ No newline at end of file
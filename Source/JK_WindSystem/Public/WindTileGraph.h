@@ -0,0 +1,71 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/UniquePtr.h"
+#include <atomic>
+
+// Half-open box of cells [Begin, End)
+struct FWindTile
+{
+    FIntVector Begin = FIntVector::ZeroValue;
+    FIntVector End = FIntVector::ZeroValue;
+};
+
+// One solver step as a graph of stages. Each stage starts only once every earlier stage has
+// finished; a tiled stage splits its region into tiles shared out between worker tasks, and a
+// worker that runs out of tiles steals from the others. The whole graph is launched at once, so a
+// step costs one wait instead of one dispatch and join per pass.
+class JK_WINDSYSTEM_API FWindTileGraph
+{
+public:
+    // Non-positive tile extents cover the whole region along that axis. MaxWorkers of 0 launches
+    // one worker task per task graph worker; the calling thread only waits in Execute.
+    FWindTileGraph(const FIntVector& InTileSize, int32 InMaxWorkers = 0);
+    ~FWindTileGraph();
+
+    // Runs Kernel once for every tile of [RegionBegin, RegionEnd). Tiles of a stage may run in any
+    // order and concurrently.
+    void AddTiledStage(const FIntVector& RegionBegin, const FIntVector& RegionEnd, TFunction<void(const FWindTile&)> Kernel);
+    // Runs Function once, on its own
+    void AddSerialStage(TFunction<void()> Function);
+
+    int32 GetNumStages() const { return Stages.Num(); }
+
+    // Launches every stage and waits for the last. The graph is empty afterwards.
+    void Execute();
+
+    // ParallelFor over [0, Num) on at most MaxWorkers threads at once, 0 meaning every task graph
+    // worker. Passes that are not tiled go through this to keep to the same worker limit.
+    static void ParallelForWorkers(int32 Num, int32 MaxWorkers, TFunctionRef<void(int32)> Body);
+
+private:
+    // Contiguous run of tile indices owned by one worker; others steal from Next once done
+    struct alignas(64) FTileRange
+    {
+        std::atomic<int32> Next{ 0 };
+        int32 End = 0;
+    };
+
+    struct FStage
+    {
+        TFunction<void(const FWindTile&)> Kernel;
+        TFunction<void()> SerialFunction;
+        FIntVector RegionBegin = FIntVector::ZeroValue;
+        FIntVector RegionEnd = FIntVector::ZeroValue;
+        FIntVector TileSize = FIntVector::ZeroValue;
+        FIntVector NumTiles = FIntVector::ZeroValue;
+        int32 NumWorkers = 0;
+        TUniquePtr<FTileRange[]> Ranges;
+
+        FWindTile GetTile(int32 TileIndex) const;
+    };
+
+    FIntVector TileSize;
+    int32 MaxWorkers;
+    TArray<FStage> Stages;
+
+    static void RunWorker(FStage& Stage, int32 Worker);
+
+    FWindTileGraph(const FWindTileGraph&) = delete;
+    FWindTileGraph& operator=(const FWindTileGraph&) = delete;
+};
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Precomputed tileable curl-noise volume used to synthesize sub-grid wind detail at query time.
+// The curl of a smooth periodic vector potential is divergence-free, so the added flutter does
+// not create sources or sinks in the resolved flow.
+class JK_WINDSYSTEM_API FWindTurbulenceField
+{
+public:
+    FWindTurbulenceField();
+
+    void Initialize(int32 InResolution, int32 InLatticePeriod, int32 Seed);
+
+    bool IsInitialized() const { return Resolution > 0; }
+    int32 GetResolution() const { return Resolution; }
+
+    // Samples the noise with trilinear filtering. TilePosition is expressed in tiles, so the
+    // pattern repeats every 1.0 along each axis. Output has unit RMS magnitude.
+    FVector Sample(const FVector& TilePosition) const;
+
+private:
+    TArray<FVector3f> CurlNoise;
+    int32 Resolution;
+
+    FORCEINLINE int32 Wrap(int32 Value) const;
+    FORCEINLINE int32 GetIndex(int32 X, int32 Y, int32 Z) const;
+};
\ No newline at end of file
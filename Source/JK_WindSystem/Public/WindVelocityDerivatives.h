@@ -0,0 +1,38 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WindVelocityDerivatives.generated.h"
+
+// Wind velocity at a point with its first derivatives, all from one trilinear stencil
+USTRUCT(BlueprintType)
+struct JK_WINDSYSTEM_API FWindVelocityDerivatives
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Wind Simulation")
+    FVector Velocity = FVector::ZeroVector;
+
+    // M[I][J] is the rate of change of velocity component I along world axis J, per unit distance
+    UPROPERTY(BlueprintReadOnly, Category = "Wind Simulation")
+    FMatrix Jacobian = FMatrix(ForceInit);
+
+    // Vorticity, the rotation of the flow about each axis
+    UPROPERTY(BlueprintReadOnly, Category = "Wind Simulation")
+    FVector Curl = FVector::ZeroVector;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Wind Simulation")
+    float Divergence = 0.0f;
+
+    // Change in velocity across one cell relative to the local speed. Near 0 in smooth flow,
+    // around 1 and above in gusty, sheared flow.
+    UPROPERTY(BlueprintReadOnly, Category = "Wind Simulation")
+    float TurbulenceIntensity = 0.0f;
+
+    // Derivative of the velocity along one world axis, column Axis of the Jacobian
+    FVector GetDerivative(int32 Axis) const { return FVector(Jacobian.M[0][Axis], Jacobian.M[1][Axis], Jacobian.M[2][Axis]); }
+
+    // Sets the Jacobian from the derivative along each world axis and derives curl, divergence and
+    // turbulence intensity from it. Velocity must already be set; CellSpacing sets the scale
+    // turbulence intensity is measured at.
+    void SetDerivatives(const FVector& AlongX, const FVector& AlongY, const FVector& AlongZ, const FVector& CellSpacing);
+};
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "HAL/CriticalSection.h"
+#include "Templates/UniquePtr.h"
+#include <atomic>
+
+class FRunnableThread;
+class FEvent;
+
+// One simulation that wants fixed steps run on the pool
+struct FWindPoolDomainDesc
+{
+    float FixedStep = 1.0f / 60.0f;
+    // Among domains due at the same time, higher priorities step first
+    int32 Priority = 0;
+    // Average fraction of one worker the domain may use. 0 leaves it unlimited.
+    float CpuBudget = 0.0f;
+    TFunction<void()> StepFunction;
+    // Told how many steps were skipped because the domain fell behind or ran out of budget
+    TFunction<void(int32)> OnDroppedSteps;
+    // Steps once per RequestStep instead of every FixedStep, for callers that keep their own clock
+    bool bOnDemand = false;
+};
+
+// Process-wide pool of wind simulation threads shared by every simulation component in every
+// world. Domains are stepped against absolute deadlines or on request, one step at a time each,
+// so however many domains exist and whatever mode they step in, no more steps run at once than the
+// pool has threads. The passes inside a step keep to the solver's own worker limit. Workers start
+// with the first domain and stop once the last one is removed.
+class JK_WINDSYSTEM_API FWindWorkerPool
+{
+public:
+    static FWindWorkerPool& Get();
+
+    ~FWindWorkerPool();
+
+    // Returns a handle for the other calls. The first step is due one period from now.
+    int32 AddDomain(FWindPoolDomainDesc Desc);
+    // Waits for a step of the domain that is already running
+    void RemoveDomain(int32 Handle);
+    // Paused domains neither step nor bank time for later
+    void SetDomainPaused(int32 Handle, bool bPaused);
+    // Has an on-demand domain step once more. Requests made while one is pending are merged.
+    void RequestStep(int32 Handle);
+
+    int32 GetNumWorkers() const;
+    int32 GetNumDomains() const;
+
+    // Joins the workers and drops every domain left. Called when the module shuts down, while the
+    // engine's threading is still up; a later AddDomain starts the pool again.
+    void Shutdown();
+
+private:
+    FWindWorkerPool();
+
+    struct FDomain
+    {
+        int32 Handle = INDEX_NONE;
+        FWindPoolDomainDesc Desc;
+        double NextDeadline = 0.0;
+        // CPU seconds the domain may still spend; refills at CpuBudget per second
+        double BudgetBalance = 0.0;
+        double LastRefillTime = 0.0;
+        bool bRunning = false;
+        bool bPaused = false;
+        bool bStepRequested = false;
+    };
+
+    class FWorker : public FRunnable
+    {
+    public:
+        FWorker(FWindWorkerPool& InPool, int32 InGeneration) : Pool(InPool), Generation(InGeneration) {}
+        virtual uint32 Run() override { Pool.RunWorker(Generation); return 0; }
+
+    private:
+        FWindWorkerPool& Pool;
+        int32 Generation;
+    };
+
+    mutable FCriticalSection Lock;
+    TArray<TUniquePtr<FDomain>> Domains;
+    TArray<TUniquePtr<FWorker>> Workers;
+    TArray<FRunnableThread*> Threads;
+    // Taken from the engine's event pool with the first workers and returned by Shutdown
+    FEvent* WakeEvent;
+    // Workers run until the generation they were started with is stopped, so workers being
+    // joined never mix with a new set started meanwhile
+    std::atomic<int32> WorkerGeneration;
+    int32 NextHandle;
+
+    void RunWorker(int32 Generation);
+    // Claims the due domain that should step next, or returns null with the time until one is due.
+    // Called with Lock held.
+    FDomain* ClaimDomain(double Now, double& OutWaitSeconds);
+    void StartWorkers();
+    // With bOnlyIfUnused, leaves the workers running if a domain was added meanwhile
+    void StopWorkers(bool bOnlyIfUnused);
+
+    FWindWorkerPool(const FWindWorkerPool&) = delete;
+    FWindWorkerPool& operator=(const FWindWorkerPool&) = delete;
+};
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace WindZoneIndexConstants
+{
+    // Edge of one hash cell in world units, about the size of a room or a short tunnel
+    const float DefaultCellSize = 2000.0f;
+    // Entries spanning more cells than this are kept in a list every query checks instead
+    const int32 MaxCellsPerEntry = 512;
+}
+
+// Uniform spatial hash over world-space boxes, used to find the wind zones that may contain a
+// point without testing every zone. Entries are identified by small non-negative ids, and
+// candidates always come back in ascending id order so callers can apply them in a fixed order.
+class JK_WINDSYSTEM_API FWindZoneIndex
+{
+public:
+    explicit FWindZoneIndex(float InCellSize = WindZoneIndexConstants::DefaultCellSize);
+
+    void Reset();
+
+    // Inserts the entry or moves it to new bounds. Only the cells it leaves or enters are touched.
+    // An invalid box removes it.
+    void Update(int32 Id, const FBox& Bounds);
+
+    int32 Num() const { return NumEntries; }
+
+    // Entries whose bounds contain Point, in ascending id order
+    void Query(const FVector& Point, TArray<int32, TInlineAllocator<16>>& OutIds) const;
+
+    // Sorts the points by hash cell and calls Visit once per cell that has candidates, with the
+    // indices of the points in that cell and the entries that may contain any of them. Points of
+    // one call share their candidates, so each entry is set up once per cell instead of per point.
+    void ForEachCell(TConstArrayView<FVector> Points, TFunctionRef<void(TConstArrayView<int32> PointIndices, TConstArrayView<int32> CandidateIds)> Visit) const;
+
+private:
+    float CellSize;
+    float InvCellSize;
+    int32 NumEntries = 0;
+
+    // Ids overlapping each occupied cell, kept sorted
+    TMap<FIntVector, TArray<int32>> Cells;
+    // Ids too large to hash, kept sorted
+    TArray<int32> LargeEntries;
+    // Bounds of each id as inserted, invalid for unused ids
+    TArray<FBox> EntryBounds;
+
+    FIntVector GetCell(const FVector& Point) const;
+    void GetCellRange(const FBox& Bounds, FIntVector& OutMin, FIntVector& OutMax) const;
+    static bool IsLarge(const FIntVector& Min, const FIntVector& Max);
+    void Insert(int32 Id, const FBox& Bounds);
+    void Remove(int32 Id, const FBox& Bounds);
+    void GatherCandidates(const FIntVector& Cell, TArray<int32, TInlineAllocator<16>>& OutIds) const;
+};
@@ -0,0 +1,131 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WindZoneIndex.h"
+
+// What a zone does to the wind in the cells it covers: velocity becomes VelocityMap applied to it
+struct FWindZoneModifier
+{
+    FMatrix VelocityMap = FMatrix::Identity;
+    // The zone stops the flow, so solvers hold the cells it mostly covers at rest and queries leave
+    // those alone; cells it only clips are attenuated by queries like any other zone. Other maps
+    // would compound if a solver applied them every step, so only queries apply those.
+    bool bBlocksFlow = false;
+    // The cells are taken out of the simulation entirely
+    bool bFreeze = false;
+};
+
+// Wind zones voxelized onto the nodes of the exported solver grid. Each node holds an index into
+// a small table of modifiers and the fraction of its cell the zones cover. Solvers hold the cells
+// that zones stop at rest, and queries apply the other zones at the node nearest to them, so each
+// zone applies exactly once and neither depends on how many zones there are. Immutable once
+// handed to the simulation.
+class JK_WINDSYSTEM_API FWindZoneMask
+{
+public:
+    // Matches the mask to a simulation layout with no zones in it
+    void Initialize(const FVector& InOrigin, const FIntVector& InDimensions, const FVector& InCellSpacing);
+
+    // Voxelizes a box zone given by its transform and unscaled half extent. Zones must be added in
+    // the order they apply; where they overlap the later one applies to the result of the earlier.
+    // The zone is also kept as given for ApplyZones, whether or not it reaches the grid.
+    void AddZone(const FTransform& ZoneTransform, const FVector& Extent, const FWindZoneModifier& Modifier);
+    // Call once every zone is added. Decides which cells solvers hold at rest and builds the
+    // summary they use to skip frozen regions.
+    void Finalize();
+
+    bool IsValid() const { return ModifierIndices.Num() > 0; }
+    // True until a zone covers any node
+    bool IsEmpty() const { return NumCovered == 0; }
+    bool IsAlignedWith(const FVector& InOrigin, const FIntVector& InDimensions, const FVector& InCellSpacing) const;
+    // Whether the layout only differs from the mask's by an origin a whole number of cells away. If
+    // so, OutCellOffset is the Shift that carries the mask onto it.
+    bool GetShiftTo(const FVector& InOrigin, const FIntVector& InDimensions, const FVector& InCellSpacing, FIntVector& OutCellOffset) const;
+    // Moves the voxelized zones by whole cells the way IWindSolverBackend::Shift moves a solver's
+    // contents, keeping them where they are in the world. Nodes shifted in from outside the old
+    // layout are left uncovered until the zones are voxelized again.
+    void Shift(const FIntVector& CellOffset);
+
+    const FVector& GetOrigin() const { return Origin; }
+    const FIntVector& GetDimensions() const { return Dimensions; }
+    const FVector& GetCellSpacing() const { return CellSpacing; }
+    int32 GetNumCovered() const { return NumCovered; }
+
+    FORCEINLINE int32 GetIndex(int32 X, int32 Y, int32 Z) const { return X + Y * Dimensions.X + Z * Dimensions.X * Dimensions.Y; }
+
+    // Node nearest to a world position, or INDEX_NONE outside the cells of the grid
+    int32 GetCellAt(const FVector& WorldPosition) const;
+
+    FORCEINLINE bool IsModified(int32 CellIndex) const { return ModifierIndices[CellIndex] != 0; }
+    // Frozen cells are taken out of the solve and held at rest like solids
+    bool HasFrozen() const { return NumFrozen > 0; }
+    FORCEINLINE bool IsCellFrozen(int32 CellIndex) const { return NumFrozen > 0 && FrozenCells[CellIndex] != 0; }
+    // Whether every cell of the half-open node box [Begin, End) is frozen. Constant time.
+    bool IsRegionFrozen(const FIntVector& Begin, const FIntVector& End) const;
+    FORCEINLINE float GetWeight(int32 CellIndex) const { return Weights[CellIndex]; }
+    // Whether solvers hold the cell at rest: zones that block the flow cover at least half of it,
+    // or it is frozen. Decided once per mask, so how strongly a zone blocks does not depend on how
+    // often the solver steps.
+    bool HasBlocked() const { return NumBlocked > 0; }
+    FORCEINLINE bool IsCellBlocked(int32 CellIndex) const { return NumBlocked > 0 && BlockedCells[CellIndex] != 0; }
+
+    // Velocity after the cell's modifier, blended by how much of the cell the zones cover. Blocked
+    // cells were held at rest by the solver and are left alone here, while a blocking zone too thin
+    // to block a cell scales its velocity down by the coverage instead.
+    FORCEINLINE FVector ApplyToCell(int32 CellIndex, const FVector& Velocity) const
+    {
+        const uint16 ModifierIndex = ModifierIndices[CellIndex];
+        if (ModifierIndex == 0 || IsCellBlocked(CellIndex))
+        {
+            return Velocity;
+        }
+        return Velocity + (Modifiers[ModifierIndex].VelocityMap.TransformVector(Velocity) - Velocity) * Weights[CellIndex];
+    }
+
+    // ApplyToCell at the node nearest to a world position. Positions outside the grid are unchanged.
+    // Like ApplyToCell, it leaves blocked cells to the solver.
+    FVector Apply(const FVector& WorldPosition, const FVector& Velocity) const;
+
+    // Every zone whose box contains a world position applied to the velocity in the order they were
+    // added, each tested against its exact box rather than the grid. For positions the grid misses,
+    // so blocking zones apply here too.
+    FVector ApplyZones(const FVector& WorldPosition, FVector Velocity) const;
+    int32 GetNumZones() const { return Zones.Num(); }
+
+private:
+    FVector Origin = FVector::ZeroVector;
+    FIntVector Dimensions = FIntVector::ZeroValue;
+    FVector CellSpacing = FVector::OneVector;
+
+    // Per node, 0 where no zone applies
+    TArray<uint16> ModifierIndices;
+    TArray<float> Weights;
+    int32 NumCovered = 0;
+
+    // Filled by Finalize, and only when something is blocked or frozen. FrozenSums holds the number
+    // of frozen cells in the box from node 0 up to each node, with one extra layer of zeros in front.
+    TArray<uint8> BlockedCells;
+    int32 NumBlocked = 0;
+    TArray<uint8> FrozenCells;
+    TArray<int32> FrozenSums;
+    int32 NumFrozen = 0;
+
+    // Each zone as added, with an index over their world boxes for ApplyZones
+    struct FZone
+    {
+        FTransform Transform;
+        FBox LocalBox;
+        FMatrix VelocityMap;
+    };
+    TArray<FZone> Zones;
+    FWindZoneIndex ZoneIndex;
+
+    // Entry 0 is the identity. Overlaps get their own entry, the composition of the zones involved.
+    TArray<FWindZoneModifier> Modifiers;
+    // Composed entry for each (entry already in a cell, entry of the zone added over it)
+    TMap<uint32, uint16> Compositions;
+
+    // Index of the new entry, or 0 once the table is full
+    uint16 AddModifier(const FWindZoneModifier& Modifier);
+    uint16 Compose(uint16 Existing, uint16 Added);
+};
@@ -0,0 +1,518 @@
+#include "WindLatticeBoltzmannSolver.h"
+#include "WindTileGraph.h"
+#include "WindZoneMask.h"
+
+namespace WindLatticeBoltzmann
+{
+    // D3Q19 lattice: rest, 6 face neighbours, 12 edge neighbours. Directions come in opposite pairs.
+    const int32 Ex[FWindLatticeBoltzmannSolver::NumDirections] = { 0, 1, -1, 0, 0, 0, 0, 1, -1, 1, -1, 1, -1, 1, -1, 0, 0, 0, 0 };
+    const int32 Ey[FWindLatticeBoltzmannSolver::NumDirections] = { 0, 0, 0, 1, -1, 0, 0, 1, -1, -1, 1, 0, 0, 0, 0, 1, -1, 1, -1 };
+    const int32 Ez[FWindLatticeBoltzmannSolver::NumDirections] = { 0, 0, 0, 0, 0, 1, -1, 0, 0, 0, 0, 1, -1, -1, 1, 1, -1, -1, 1 };
+    const int32 Opposite[FWindLatticeBoltzmannSolver::NumDirections] = { 0, 2, 1, 4, 3, 6, 5, 8, 7, 10, 9, 12, 11, 14, 13, 16, 15, 18, 17 };
+    const float Weights[FWindLatticeBoltzmannSolver::NumDirections] =
+    {
+        1.0f / 3.0f,
+        1.0f / 18.0f, 1.0f / 18.0f, 1.0f / 18.0f, 1.0f / 18.0f, 1.0f / 18.0f, 1.0f / 18.0f,
+        1.0f / 36.0f, 1.0f / 36.0f, 1.0f / 36.0f, 1.0f / 36.0f, 1.0f / 36.0f, 1.0f / 36.0f,
+        1.0f / 36.0f, 1.0f / 36.0f, 1.0f / 36.0f, 1.0f / 36.0f, 1.0f / 36.0f, 1.0f / 36.0f
+    };
+
+    // Lattice speeds must stay well below the lattice speed of sound (1/sqrt(3)) to remain stable
+    const float MaxLatticeSpeed = 0.3f;
+    const float MinDensity = 0.05f;
+    const float MinTau = 0.51f;
+    const float MaxTau = 4.0f;
+    const int32 MaxSubSteps = 4;
+
+    FORCEINLINE float Equilibrium(int32 Q, float Density, const FVector3f& U, float USquared)
+    {
+        const float Eu = Ex[Q] * U.X + Ey[Q] * U.Y + Ez[Q] * U.Z;
+        return Weights[Q] * Density * (1.0f + 3.0f * Eu + 4.5f * Eu * Eu - 1.5f * USquared);
+    }
+
+    FORCEINLINE FVector3f ClampLatticeVelocity(const FVector3f& U)
+    {
+        const float SpeedSquared = U.SizeSquared();
+        return SpeedSquared > FMath::Square(MaxLatticeSpeed) ? U * (MaxLatticeSpeed / FMath::Sqrt(SpeedSquared)) : U;
+    }
+}
+
+FWindLatticeBoltzmannSolver::FWindLatticeBoltzmannSolver()
+    : GridSize(0)
+    , CurrentBuffer(0)
+    , CellSize(1.0f)
+    , TimeStep(1.0f)
+    , Tau(1.0f)
+    , TimeAccumulator(0.0f)
+    , AmbientVelocity(FVector::ZeroVector)
+{
+}
+
+void FWindLatticeBoltzmannSolver::Initialize(const FWindSolverConfig& InConfig)
+{
+    using namespace WindLatticeBoltzmann;
+
+    Config = InConfig;
+    GridSize = FMath::Max(Config.GridSize, 3);
+    CellSize = FMath::Max(Config.CellSize, UE_KINDA_SMALL_NUMBER);
+    TimeStep = FMath::Max(Config.TimeStep, UE_KINDA_SMALL_NUMBER);
+    CurrentBuffer = 0;
+    TimeAccumulator = 0.0f;
+
+    // Same per-step diffusion coefficient as the Stable Fluids Diffuse pass: a = dt * diff * (N - 2)^2
+    const float LatticeViscosity = Config.Viscosity * TimeStep * FMath::Square(GridSize - 2);
+    Tau = FMath::Clamp(3.0f * LatticeViscosity + 0.5f, MinTau, MaxTau);
+
+    Distributions[0].SetNumUninitialized(NumDirections * NumCells());
+    Distributions[1].SetNumUninitialized(NumDirections * NumCells());
+    Velocity.SetNumZeroed(NumCells());
+    SolidMask.SetNumZeroed(NumCells());
+
+    for (int32 Cell = 0; Cell < NumCells(); Cell++)
+    {
+        SetEquilibrium(Cell, 1.0f, FVector3f::ZeroVector);
+    }
+    Distributions[1] = Distributions[0];
+}
+
+void FWindLatticeBoltzmannSolver::Resize(int32 NewGridSize, float NewCellSize)
+{
+    const FWindLatticeBoltzmannSolver Previous = *this;
+
+    FWindSolverConfig NewConfig = Config;
+    NewConfig.GridSize = NewGridSize;
+    NewConfig.CellSize = NewCellSize;
+    Initialize(NewConfig);
+
+    if (Previous.IsInitialized())
+    {
+        WindSolverBackend::Resample(Previous, *this);
+    }
+}
+
+void FWindLatticeBoltzmannSolver::SetEquilibrium(int32 CellIndex, float Density, const FVector3f& U)
+{
+    const float USquared = U.SizeSquared();
+    float* F = Distributions[CurrentBuffer].GetData();
+    for (int32 Q = 0; Q < NumDirections; Q++)
+    {
+        F[Q * NumCells() + CellIndex] = WindLatticeBoltzmann::Equilibrium(Q, Density, U, USquared);
+    }
+    Velocity[CellIndex] = U;
+}
+
+void FWindLatticeBoltzmannSolver::Step(float DeltaTime)
+{
+    if (!IsInitialized())
+    {
+        return;
+    }
+
+    TimeAccumulator += DeltaTime;
+    WindSolverBackend::GetSpongeBlend(Config, TimeStep, SpongeBlend);
+
+    int32 NumSteps = 0;
+    while (TimeAccumulator + UE_KINDA_SMALL_NUMBER >= TimeStep && NumSteps < WindLatticeBoltzmann::MaxSubSteps)
+    {
+        StreamAndCollide();
+        ApplySponge();
+        ApplyZones();
+        TimeAccumulator -= TimeStep;
+        NumSteps++;
+    }
+
+    // Drop any backlog rather than spiralling when the caller falls far behind
+    if (NumSteps == WindLatticeBoltzmann::MaxSubSteps)
+    {
+        TimeAccumulator = 0.0f;
+    }
+}
+
+const FWindZoneMask* FWindLatticeBoltzmannSolver::GetFrozenMask() const
+{
+    return ZoneMask.IsValid() && ZoneMask->HasFrozen() ? ZoneMask.Get() : nullptr;
+}
+
+FORCEINLINE bool FWindLatticeBoltzmannSolver::IsSolidOrFrozen(const FWindZoneMask* Frozen, int32 CellIndex) const
+{
+    return SolidMask[CellIndex] || (Frozen && Frozen->IsCellFrozen(CellIndex));
+}
+
+void FWindLatticeBoltzmannSolver::StreamAndCollide()
+{
+    using namespace WindLatticeBoltzmann;
+
+    const float* Src = Distributions[CurrentBuffer].GetData();
+    float* Dst = Distributions[1 - CurrentBuffer].GetData();
+    const int32 Count = NumCells();
+    const float Omega = 1.0f / Tau;
+
+    // Populations entering through an inflow face come from the equilibrium of the ambient wind
+    const FVector3f AmbientU = ClampLatticeVelocity(FVector3f(AmbientVelocity * (TimeStep / CellSize)));
+    const float AmbientUSquared = AmbientU.SizeSquared();
+    bool bInflow[3][2];
+    for (int32 Axis = 0; Axis < 3; Axis++)
+    {
+        bInflow[Axis][0] = WindSolverBackend::IsInflowFace(Config, AmbientVelocity, Axis, -1);
+        bInflow[Axis][1] = WindSolverBackend::IsInflowFace(Config, AmbientVelocity, Axis, 1);
+    }
+
+    const FWindZoneMask* Frozen = GetFrozenMask();
+    auto IsBlocked = [this, Frozen](int32 Cell) { return IsSolidOrFrozen(Frozen, Cell); };
+
+    // Pull scheme: each cell gathers its incoming populations and collides them in place, so
+    // rows are fully independent and need no synchronization beyond the buffer swap
+    FWindTileGraph::ParallelForWorkers(GridSize * GridSize, Config.MaxTileWorkers, [&](int32 Row)
+    {
+        const int32 Y = Row % GridSize;
+        const int32 Z = Row / GridSize;
+        float Incoming[NumDirections];
+
+        for (int32 X = 0; X < GridSize; X++)
+        {
+            const int32 Cell = GetIndex(X, Y, Z);
+
+            if (IsBlocked(Cell))
+            {
+                for (int32 Q = 0; Q < NumDirections; Q++)
+                {
+                    Dst[Q * Count + Cell] = Weights[Q];
+                }
+                Velocity[Cell] = FVector3f::ZeroVector;
+                continue;
+            }
+
+            float Density = 0.0f;
+            FVector3f Momentum = FVector3f::ZeroVector;
+
+            for (int32 Q = 0; Q < NumDirections; Q++)
+            {
+                const int32 SX = X - Ex[Q];
+                const int32 SY = Y - Ey[Q];
+                const int32 SZ = Z - Ez[Q];
+
+                float Value;
+                if (!IsValidIndex(SX, SY, SZ))
+                {
+                    const bool bFromInflow =
+                        (SX < 0 && bInflow[0][0]) || (SX >= GridSize && bInflow[0][1]) ||
+                        (SY < 0 && bInflow[1][0]) || (SY >= GridSize && bInflow[1][1]) ||
+                        (SZ < 0 && bInflow[2][0]) || (SZ >= GridSize && bInflow[2][1]);
+
+                    // Otherwise zero-gradient, matching SetBoundary on the Stable Fluids path
+                    Value = bFromInflow ? Equilibrium(Q, 1.0f, AmbientU, AmbientUSquared) : Src[Q * Count + Cell];
+                }
+                else
+                {
+                    const int32 SourceCell = GetIndex(SX, SY, SZ);
+                    // Halfway bounce-back: a population that hit a solid neighbour returns reversed
+                    Value = IsBlocked(SourceCell) ? Src[Opposite[Q] * Count + Cell] : Src[Q * Count + SourceCell];
+                }
+
+                Incoming[Q] = Value;
+                Density += Value;
+                Momentum += FVector3f(Ex[Q], Ey[Q], Ez[Q]) * Value;
+            }
+
+            Density = FMath::Max(Density, MinDensity);
+            const FVector3f U = ClampLatticeVelocity(Momentum / Density);
+            const float USquared = U.SizeSquared();
+
+            for (int32 Q = 0; Q < NumDirections; Q++)
+            {
+                Dst[Q * Count + Cell] = Incoming[Q] - Omega * (Incoming[Q] - Equilibrium(Q, Density, U, USquared));
+            }
+            Velocity[Cell] = U;
+        }
+    });
+
+    CurrentBuffer = 1 - CurrentBuffer;
+}
+
+void FWindLatticeBoltzmannSolver::AddCellVelocity(int32 X, int32 Y, int32 Z, const FVector& WorldVelocity)
+{
+    using namespace WindLatticeBoltzmann;
+
+    if (!IsValidIndex(X, Y, Z))
+    {
+        return;
+    }
+
+    const int32 Cell = GetIndex(X, Y, Z);
+    if (SolidMask[Cell])
+    {
+        return;
+    }
+
+    float Density;
+    const FVector3f OldU = GetCellMoments(Cell, Density);
+    ChangeCellVelocity(Cell, Density, OldU, ClampLatticeVelocity(OldU + FVector3f(WorldVelocity * (TimeStep / CellSize))));
+}
+
+FVector3f FWindLatticeBoltzmannSolver::GetCellMoments(int32 CellIndex, float& OutDensity) const
+{
+    using namespace WindLatticeBoltzmann;
+
+    const float* F = Distributions[CurrentBuffer].GetData();
+    const int32 Count = NumCells();
+
+    float Density = 0.0f;
+    FVector3f Momentum = FVector3f::ZeroVector;
+    for (int32 Q = 0; Q < NumDirections; Q++)
+    {
+        const float Value = F[Q * Count + CellIndex];
+        Density += Value;
+        Momentum += FVector3f(Ex[Q], Ey[Q], Ez[Q]) * Value;
+    }
+
+    OutDensity = FMath::Max(Density, MinDensity);
+    return Momentum / OutDensity;
+}
+
+void FWindLatticeBoltzmannSolver::ApplyZones()
+{
+    const FWindZoneMask* Mask = ZoneMask.Get();
+    if (!Mask || !Mask->HasBlocked())
+    {
+        return;
+    }
+
+    // Frozen cells are bounced off like solids in StreamAndCollide and never hold any flow
+    FWindTileGraph::ParallelForWorkers(GridSize * GridSize, Config.MaxTileWorkers, [&](int32 Row)
+    {
+        const int32 RowBegin = Row * GridSize;
+        for (int32 Cell = RowBegin; Cell < RowBegin + GridSize; Cell++)
+        {
+            if (!Mask->IsCellBlocked(Cell) || SolidMask[Cell] || Mask->IsCellFrozen(Cell))
+            {
+                continue;
+            }
+
+            float Density;
+            const FVector3f OldU = GetCellMoments(Cell, Density);
+            ChangeCellVelocity(Cell, Density, OldU, FVector3f::ZeroVector);
+        }
+    });
+}
+
+void FWindLatticeBoltzmannSolver::ChangeCellVelocity(int32 CellIndex, float Density, const FVector3f& OldU, const FVector3f& NewU)
+{
+    using namespace WindLatticeBoltzmann;
+
+    float* F = Distributions[CurrentBuffer].GetData();
+    const int32 Count = NumCells();
+    const float OldUSquared = OldU.SizeSquared();
+    const float NewUSquared = NewU.SizeSquared();
+
+    for (int32 Q = 0; Q < NumDirections; Q++)
+    {
+        F[Q * Count + CellIndex] += Equilibrium(Q, Density, NewU, NewUSquared) - Equilibrium(Q, Density, OldU, OldUSquared);
+    }
+    Velocity[CellIndex] = NewU;
+}
+
+void FWindLatticeBoltzmannSolver::ApplySponge()
+{
+    using namespace WindLatticeBoltzmann;
+
+    if (SpongeBlend.Num() == 0)
+    {
+        return;
+    }
+
+    const int32 Width = SpongeBlend.Num();
+    const FVector3f AmbientU = ClampLatticeVelocity(FVector3f(AmbientVelocity * (TimeStep / CellSize)));
+    const FWindZoneMask* Frozen = GetFrozenMask();
+
+    FWindTileGraph::ParallelForWorkers(GridSize * GridSize, Config.MaxTileWorkers, [&](int32 Row)
+    {
+        const int32 Y = Row % GridSize;
+        const int32 Z = Row / GridSize;
+        const int32 DistanceYZ = FMath::Min(FMath::Min(Y, GridSize - 1 - Y), FMath::Min(Z, GridSize - 1 - Z));
+
+        for (int32 X = 0; X < GridSize; X++)
+        {
+            const int32 Distance = FMath::Min(DistanceYZ, FMath::Min(X, GridSize - 1 - X));
+            const int32 Cell = GetIndex(X, Y, Z);
+            if (Distance >= Width || IsSolidOrFrozen(Frozen, Cell))
+            {
+                continue;
+            }
+
+            float Density;
+            const FVector3f OldU = GetCellMoments(Cell, Density);
+            ChangeCellVelocity(Cell, Density, OldU, OldU + (AmbientU - OldU) * SpongeBlend[Distance]);
+        }
+    });
+}
+
+FVector FWindLatticeBoltzmannSolver::GetCellVelocity(int32 X, int32 Y, int32 Z) const
+{
+    return IsValidIndex(X, Y, Z) ? FVector(Velocity[GetIndex(X, Y, Z)]) * (CellSize / TimeStep) : FVector::ZeroVector;
+}
+
+void FWindLatticeBoltzmannSolver::SetCellSolid(int32 X, int32 Y, int32 Z, bool bSolid)
+{
+    if (!IsValidIndex(X, Y, Z))
+    {
+        return;
+    }
+
+    const int32 Cell = GetIndex(X, Y, Z);
+    SolidMask[Cell] = bSolid ? 1 : 0;
+    SetEquilibrium(Cell, 1.0f, FVector3f::ZeroVector);
+}
+
+bool FWindLatticeBoltzmannSolver::IsCellSolid(int32 X, int32 Y, int32 Z) const
+{
+    return IsValidIndex(X, Y, Z) && SolidMask[GetIndex(X, Y, Z)] != 0;
+}
+
+bool FWindLatticeBoltzmannSolver::AddVelocity(const FVector& LocalPosition, const FVector& Velocity)
+{
+    const int32 Cell = GetCellIndex(LocalPosition);
+    if (Cell == INDEX_NONE)
+    {
+        return false;
+    }
+
+    AddVelocityAtCell(Cell, Velocity);
+    return true;
+}
+
+void FWindLatticeBoltzmannSolver::AddVelocityAtCell(int32 CellIndex, const FVector& Velocity)
+{
+    const int32 X = CellIndex % GridSize;
+    const int32 Y = (CellIndex / GridSize) % GridSize;
+    const int32 Z = CellIndex / (GridSize * GridSize);
+
+    const FVector CurrentVelocity = GetCellVelocity(X, Y, Z);
+    FVector NewVelocity = CurrentVelocity + Velocity;
+    if (NewVelocity.SizeSquared() > FMath::Square(Config.MaxVelocity))
+    {
+        NewVelocity = NewVelocity.GetSafeNormal() * Config.MaxVelocity;
+    }
+
+    AddCellVelocity(X, Y, Z, NewVelocity - CurrentVelocity);
+}
+
+int32 FWindLatticeBoltzmannSolver::GetCellIndex(const FVector& LocalPosition) const
+{
+    const int32 X = FMath::FloorToInt(LocalPosition.X / CellSize);
+    const int32 Y = FMath::FloorToInt(LocalPosition.Y / CellSize);
+    const int32 Z = FMath::FloorToInt(LocalPosition.Z / CellSize);
+    return IsInitialized() && IsValidIndex(X, Y, Z) ? GetIndex(X, Y, Z) : INDEX_NONE;
+}
+
+FVector FWindLatticeBoltzmannSolver::SampleVelocity(const FVector& LocalPosition) const
+{
+    if (!IsInitialized())
+    {
+        return FVector::ZeroVector;
+    }
+
+    const FVector Position = LocalPosition / CellSize;
+    const int32 X0 = FMath::FloorToInt(Position.X);
+    const int32 Y0 = FMath::FloorToInt(Position.Y);
+    const int32 Z0 = FMath::FloorToInt(Position.Z);
+    const int32 X1 = FMath::Min(X0 + 1, GridSize - 1);
+    const int32 Y1 = FMath::Min(Y0 + 1, GridSize - 1);
+    const int32 Z1 = FMath::Min(Z0 + 1, GridSize - 1);
+
+    const float Sx = Position.X - X0;
+    const float Sy = Position.Y - Y0;
+    const float Sz = Position.Z - Z0;
+
+    return FMath::Lerp(
+        FMath::Lerp(
+            FMath::Lerp(GetCellVelocity(X0, Y0, Z0), GetCellVelocity(X1, Y0, Z0), Sx),
+            FMath::Lerp(GetCellVelocity(X0, Y1, Z0), GetCellVelocity(X1, Y1, Z0), Sx),
+            Sy),
+        FMath::Lerp(
+            FMath::Lerp(GetCellVelocity(X0, Y0, Z1), GetCellVelocity(X1, Y0, Z1), Sx),
+            FMath::Lerp(GetCellVelocity(X0, Y1, Z1), GetCellVelocity(X1, Y1, Z1), Sx),
+            Sy),
+        Sz);
+}
+
+bool FWindLatticeBoltzmannSolver::SetSolid(const FVector& LocalPosition, bool bSolid)
+{
+    const int32 X = FMath::FloorToInt(LocalPosition.X / CellSize);
+    const int32 Y = FMath::FloorToInt(LocalPosition.Y / CellSize);
+    const int32 Z = FMath::FloorToInt(LocalPosition.Z / CellSize);
+
+    if (!IsInitialized() || !IsValidIndex(X, Y, Z))
+    {
+        return false;
+    }
+
+    SetCellSolid(X, Y, Z, bSolid);
+    return true;
+}
+
+void FWindLatticeBoltzmannSolver::Shift(const FIntVector& CellOffset)
+{
+    if (!IsInitialized() || CellOffset == FIntVector::ZeroValue)
+    {
+        return;
+    }
+
+    const int32 Count = NumCells();
+    const TArray<float> OldDistributions = Distributions[CurrentBuffer];
+    const TArray<FVector3f> OldVelocity = Velocity;
+    const TArray<uint8> OldSolidMask = SolidMask;
+    float* F = Distributions[CurrentBuffer].GetData();
+
+    FWindTileGraph::ParallelForWorkers(GridSize, Config.MaxTileWorkers, [&](int32 Z)
+    {
+        for (int32 Y = 0; Y < GridSize; Y++)
+        {
+            for (int32 X = 0; X < GridSize; X++)
+            {
+                const int32 Cell = GetIndex(X, Y, Z);
+                const int32 OldX = X - CellOffset.X;
+                const int32 OldY = Y - CellOffset.Y;
+                const int32 OldZ = Z - CellOffset.Z;
+
+                if (IsValidIndex(OldX, OldY, OldZ))
+                {
+                    const int32 OldCell = GetIndex(OldX, OldY, OldZ);
+                    for (int32 Q = 0; Q < NumDirections; Q++)
+                    {
+                        F[Q * Count + Cell] = OldDistributions[Q * Count + OldCell];
+                    }
+                    Velocity[Cell] = OldVelocity[OldCell];
+                    SolidMask[Cell] = OldSolidMask[OldCell];
+                }
+                else
+                {
+                    for (int32 Q = 0; Q < NumDirections; Q++)
+                    {
+                        F[Q * Count + Cell] = WindLatticeBoltzmann::Weights[Q];
+                    }
+                    Velocity[Cell] = FVector3f::ZeroVector;
+                    SolidMask[Cell] = 0;
+                }
+            }
+        }
+    });
+}
+
+void FWindLatticeBoltzmannSolver::ExportVelocity(TArray<FVector>& OutVelocity) const
+{
+    if (OutVelocity.Num() != NumCells())
+    {
+        OutVelocity.SetNumUninitialized(NumCells());
+    }
+
+    const float Scale = CellSize / TimeStep;
+    FWindTileGraph::ParallelForWorkers(GridSize, Config.MaxTileWorkers, [&](int32 Z)
+    {
+        const int32 Begin = Z * GridSize * GridSize;
+        const int32 End = Begin + GridSize * GridSize;
+        for (int32 Cell = Begin; Cell < End; Cell++)
+        {
+            OutVelocity[Cell] = FVector(Velocity[Cell] * Scale);
+        }
+    });
+}
\ No newline at end of file
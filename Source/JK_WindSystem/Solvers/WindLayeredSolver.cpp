@@ -0,0 +1,621 @@
+#include "WindLayeredSolver.h"
+#include "WindTileGraph.h"
+#include "WindZoneMask.h"
+
+namespace WindLayered
+{
+    const int32 PressureIterations = 20;
+    // Explicit vertical exchange is only stable while k * dt stays below a quarter
+    const float MaxExchangePerStep = 0.25f;
+}
+
+FWindLayeredSolver::FWindLayeredSolver()
+    : Resolution(0)
+    , NumBands(0)
+    , CellSize(1.0f)
+    , BandHeight(1.0f)
+    , Viscosity(0.0f)
+    , VerticalExchange(0.0f)
+    , AmbientVelocity(FVector2f::ZeroVector)
+{
+}
+
+void FWindLayeredSolver::Initialize(const FWindSolverConfig& InConfig)
+{
+    Config = InConfig;
+    Resolution = FMath::Max(Config.GridSize, 4);
+    NumBands = FMath::Max(Config.NumBands, 1);
+    CellSize = FMath::Max(Config.CellSize, UE_KINDA_SMALL_NUMBER);
+    BandHeight = FMath::Max(Config.BandHeight, UE_KINDA_SMALL_NUMBER);
+    Viscosity = Config.Viscosity;
+    VerticalExchange = FMath::Max(Config.VerticalExchange, 0.0f);
+
+    Velocity.SetNumZeroed(NumCells());
+    TempVelocity.SetNumZeroed(NumCells());
+    Pressure.SetNumZeroed(NumCells());
+    Divergence.SetNumZeroed(NumCells());
+    SolidMask.SetNumZeroed(NumCells());
+}
+
+void FWindLayeredSolver::Resize(int32 NewGridSize, float NewCellSize)
+{
+    const FWindLayeredSolver Previous = *this;
+
+    FWindSolverConfig NewConfig = Config;
+    NewConfig.GridSize = NewGridSize;
+    NewConfig.CellSize = NewCellSize;
+    Initialize(NewConfig);
+
+    if (Previous.IsInitialized())
+    {
+        WindSolverBackend::Resample(Previous, *this);
+    }
+}
+
+void FWindLayeredSolver::Step(float DeltaTime)
+{
+    if (!IsInitialized())
+    {
+        return;
+    }
+
+    UpdateFrozenRows();
+    Diffuse(DeltaTime);
+    Swap(Velocity, TempVelocity);
+    Project();
+    Advect(DeltaTime);
+    Swap(Velocity, TempVelocity);
+    Project();
+    ExchangeBands(DeltaTime);
+    ApplySponge(DeltaTime);
+    ApplyZones();
+    ApplySolids();
+}
+
+const FWindZoneMask* FWindLayeredSolver::GetFrozenMask() const
+{
+    return ZoneMask.IsValid() && ZoneMask->HasFrozen() ? ZoneMask.Get() : nullptr;
+}
+
+FORCEINLINE bool FWindLayeredSolver::IsCellFrozen(const FWindZoneMask* Frozen, int32 Cell)
+{
+    return Frozen && Frozen->IsCellFrozen(Cell);
+}
+
+void FWindLayeredSolver::Diffuse(float DeltaTime)
+{
+    const float A = DeltaTime * Viscosity * (Resolution - 2) * (Resolution - 2);
+    const FWindZoneMask* Frozen = GetFrozenMask();
+
+    FWindTileGraph::ParallelForWorkers(NumBands * Resolution, Config.MaxTileWorkers, [&](int32 Row)
+    {
+        const int32 Y = Row % Resolution;
+        const int32 Band = Row / Resolution;
+        if (Y == 0 || Y == Resolution - 1)
+        {
+            return;
+        }
+
+        if (IsRowFrozen(Row))
+        {
+            ClearRow(TempVelocity, Row);
+            return;
+        }
+
+        for (int32 X = 1; X < Resolution - 1; X++)
+        {
+            const int32 Cell = GetIndex(X, Y, Band);
+            if (IsCellFrozen(Frozen, Cell))
+            {
+                TempVelocity[Cell] = FVector2f::ZeroVector;
+                continue;
+            }
+
+            TempVelocity[Cell] = (Velocity[Cell] +
+                A * (Velocity[Cell - 1] + Velocity[Cell + 1] + Velocity[Cell - Resolution] + Velocity[Cell + Resolution])) / (1.0f + 4.0f * A);
+        }
+    });
+
+    SetBoundary(TempVelocity);
+}
+
+void FWindLayeredSolver::Project()
+{
+    const FWindZoneMask* Frozen = GetFrozenMask();
+
+    FWindTileGraph::ParallelForWorkers(NumBands * Resolution, Config.MaxTileWorkers, [&](int32 Row)
+    {
+        const int32 Y = Row % Resolution;
+        const int32 Band = Row / Resolution;
+        if (Y == 0 || Y == Resolution - 1)
+        {
+            return;
+        }
+
+        if (IsRowFrozen(Row))
+        {
+            for (int32 X = 1; X < Resolution - 1; X++)
+            {
+                Divergence[GetIndex(X, Y, Band)] = 0.0f;
+                Pressure[GetIndex(X, Y, Band)] = 0.0f;
+            }
+            return;
+        }
+
+        for (int32 X = 1; X < Resolution - 1; X++)
+        {
+            const int32 Cell = GetIndex(X, Y, Band);
+            if (IsCellFrozen(Frozen, Cell))
+            {
+                Divergence[Cell] = 0.0f;
+                Pressure[Cell] = 0.0f;
+                continue;
+            }
+
+            Divergence[Cell] = -0.5f * (
+                Velocity[Cell + 1].X - Velocity[Cell - 1].X +
+                Velocity[Cell + Resolution].Y - Velocity[Cell - Resolution].Y);
+            Pressure[Cell] = 0.0f;
+        }
+    });
+
+    SetBoundary(Divergence);
+    SetBoundary(Pressure);
+
+    // Red-black Gauss-Seidel so every half-sweep only reads cells of the other colour
+    for (int32 Iteration = 0; Iteration < WindLayered::PressureIterations; Iteration++)
+    {
+        for (int32 Colour = 0; Colour < 2; Colour++)
+        {
+            FWindTileGraph::ParallelForWorkers(NumBands * Resolution, Config.MaxTileWorkers, [&](int32 Row)
+            {
+                const int32 Y = Row % Resolution;
+                const int32 Band = Row / Resolution;
+                if (Y == 0 || Y == Resolution - 1 || IsRowFrozen(Row))
+                {
+                    return;
+                }
+
+                for (int32 X = 1 + ((Y + Colour + 1) & 1); X < Resolution - 1; X += 2)
+                {
+                    const int32 Cell = GetIndex(X, Y, Band);
+                    if (!Frozen)
+                    {
+                        Pressure[Cell] = (Divergence[Cell] +
+                            Pressure[Cell - 1] + Pressure[Cell + 1] +
+                            Pressure[Cell - Resolution] + Pressure[Cell + Resolution]) * 0.25f;
+                        continue;
+                    }
+
+                    if (Frozen->IsCellFrozen(Cell))
+                    {
+                        continue;
+                    }
+
+                    // Frozen neighbours are walls with no pressure gradient into them, so they drop
+                    // out of the stencil
+                    float Sum = Divergence[Cell];
+                    int32 NumOpen = 0;
+                    for (const int32 Neighbour : { Cell - 1, Cell + 1, Cell - Resolution, Cell + Resolution })
+                    {
+                        if (!Frozen->IsCellFrozen(Neighbour))
+                        {
+                            Sum += Pressure[Neighbour];
+                            NumOpen++;
+                        }
+                    }
+                    Pressure[Cell] = NumOpen > 0 ? Sum / NumOpen : 0.0f;
+                }
+            });
+        }
+        SetBoundary(Pressure);
+    }
+
+    FWindTileGraph::ParallelForWorkers(NumBands * Resolution, Config.MaxTileWorkers, [&](int32 Row)
+    {
+        const int32 Y = Row % Resolution;
+        const int32 Band = Row / Resolution;
+        if (Y == 0 || Y == Resolution - 1 || IsRowFrozen(Row))
+        {
+            return;
+        }
+
+        for (int32 X = 1; X < Resolution - 1; X++)
+        {
+            const int32 Cell = GetIndex(X, Y, Band);
+            if (IsCellFrozen(Frozen, Cell))
+            {
+                continue;
+            }
+
+            // A frozen neighbour mirrors the cell's own pressure, as in the pressure solve
+            auto GetPressure = [this, Frozen, Cell](int32 Neighbour)
+            {
+                return IsCellFrozen(Frozen, Neighbour) ? Pressure[Cell] : Pressure[Neighbour];
+            };
+            Velocity[Cell].X -= 0.5f * (GetPressure(Cell + 1) - GetPressure(Cell - 1));
+            Velocity[Cell].Y -= 0.5f * (GetPressure(Cell + Resolution) - GetPressure(Cell - Resolution));
+        }
+    });
+
+    SetBoundary(Velocity);
+}
+
+void FWindLayeredSolver::Advect(float DeltaTime)
+{
+    const float Dt0 = DeltaTime / CellSize;
+    const float MaxPos = Resolution - 1.5f;
+    const FWindZoneMask* Frozen = GetFrozenMask();
+
+    FWindTileGraph::ParallelForWorkers(NumBands * Resolution, Config.MaxTileWorkers, [&](int32 Row)
+    {
+        const int32 Y = Row % Resolution;
+        const int32 Band = Row / Resolution;
+        if (Y == 0 || Y == Resolution - 1)
+        {
+            return;
+        }
+
+        if (IsRowFrozen(Row))
+        {
+            ClearRow(TempVelocity, Row);
+            return;
+        }
+
+        for (int32 X = 1; X < Resolution - 1; X++)
+        {
+            if (IsCellFrozen(Frozen, GetIndex(X, Y, Band)))
+            {
+                TempVelocity[GetIndex(X, Y, Band)] = FVector2f::ZeroVector;
+                continue;
+            }
+
+            const FVector2f& Vel = Velocity[GetIndex(X, Y, Band)];
+            const float PosX = FMath::Clamp(X - Dt0 * Vel.X, 0.5f, MaxPos);
+            const float PosY = FMath::Clamp(Y - Dt0 * Vel.Y, 0.5f, MaxPos);
+
+            const int32 X0 = FMath::FloorToInt(PosX);
+            const int32 Y0 = FMath::FloorToInt(PosY);
+            const float S = PosX - X0;
+            const float T = PosY - Y0;
+
+            const int32 Base = GetIndex(X0, Y0, Band);
+            TempVelocity[GetIndex(X, Y, Band)] = FMath::Lerp(
+                FMath::Lerp(Velocity[Base], Velocity[Base + 1], S),
+                FMath::Lerp(Velocity[Base + Resolution], Velocity[Base + Resolution + 1], S),
+                T);
+        }
+    });
+
+    SetBoundary(TempVelocity);
+}
+
+void FWindLayeredSolver::ExchangeBands(float DeltaTime)
+{
+    if (NumBands < 2 || VerticalExchange <= 0.0f)
+    {
+        return;
+    }
+
+    const float K = FMath::Min(VerticalExchange * DeltaTime, WindLayered::MaxExchangePerStep);
+    const int32 BandStride = Resolution * Resolution;
+    const FWindZoneMask* Frozen = GetFrozenMask();
+
+    FWindTileGraph::ParallelForWorkers(NumBands * Resolution, Config.MaxTileWorkers, [&](int32 Row)
+    {
+        const int32 Y = Row % Resolution;
+        const int32 Band = Row / Resolution;
+
+        for (int32 X = 0; X < Resolution; X++)
+        {
+            const int32 Cell = GetIndex(X, Y, Band);
+            if (IsCellFrozen(Frozen, Cell))
+            {
+                TempVelocity[Cell] = FVector2f::ZeroVector;
+                continue;
+            }
+
+            // Frozen cells in the bands above and below exchange nothing
+            FVector2f Exchange = FVector2f::ZeroVector;
+            if (Band > 0 && !IsCellFrozen(Frozen, Cell - BandStride))
+            {
+                Exchange += Velocity[Cell - BandStride] - Velocity[Cell];
+            }
+            if (Band < NumBands - 1 && !IsCellFrozen(Frozen, Cell + BandStride))
+            {
+                Exchange += Velocity[Cell + BandStride] - Velocity[Cell];
+            }
+            TempVelocity[Cell] = Velocity[Cell] + K * Exchange;
+        }
+    });
+
+    Swap(Velocity, TempVelocity);
+}
+
+void FWindLayeredSolver::ApplySponge(float DeltaTime)
+{
+    // Only the lateral faces absorb; the bands themselves are the vertical extent of the domain
+    WindSolverBackend::GetSpongeBlend(Config, DeltaTime, SpongeBlend);
+    if (SpongeBlend.Num() == 0)
+    {
+        return;
+    }
+
+    const int32 Width = SpongeBlend.Num();
+    const FWindZoneMask* Frozen = GetFrozenMask();
+    FWindTileGraph::ParallelForWorkers(NumBands * Resolution, Config.MaxTileWorkers, [&](int32 Row)
+    {
+        const int32 Y = Row % Resolution;
+        const int32 Band = Row / Resolution;
+        const int32 DistanceY = FMath::Min(Y, Resolution - 1 - Y);
+
+        for (int32 X = 0; X < Resolution; X++)
+        {
+            const int32 Distance = FMath::Min(DistanceY, FMath::Min(X, Resolution - 1 - X));
+            if (Distance < Width && !IsCellFrozen(Frozen, GetIndex(X, Y, Band)))
+            {
+                FVector2f& Cell = Velocity[GetIndex(X, Y, Band)];
+                Cell += (AmbientVelocity - Cell) * SpongeBlend[Distance];
+            }
+        }
+    });
+}
+
+void FWindLayeredSolver::UpdateFrozenRows()
+{
+    const FWindZoneMask* Mask = ZoneMask.Get();
+    bHasFrozenRows = false;
+    if (!Mask || !Mask->HasFrozen())
+    {
+        return;
+    }
+
+    FrozenRows.SetNumZeroed(NumBands * Resolution);
+    for (int32 Row = 0; Row < FrozenRows.Num(); Row++)
+    {
+        const int32 Y = Row % Resolution;
+        const int32 Band = Row / Resolution;
+        FrozenRows[Row] = Mask->IsRegionFrozen(FIntVector(0, Y, Band), FIntVector(Resolution, Y + 1, Band + 1)) ? 1 : 0;
+        bHasFrozenRows |= FrozenRows[Row] != 0;
+    }
+}
+
+void FWindLayeredSolver::ClearRow(TArray<FVector2f>& Field, int32 Row) const
+{
+    const int32 Y = Row % Resolution;
+    const int32 Band = Row / Resolution;
+    for (int32 X = 0; X < Resolution; X++)
+    {
+        Field[GetIndex(X, Y, Band)] = FVector2f::ZeroVector;
+    }
+}
+
+void FWindLayeredSolver::ApplyZones()
+{
+    const FWindZoneMask* Mask = ZoneMask.Get();
+    if (!Mask || !Mask->HasBlocked())
+    {
+        return;
+    }
+
+    for (int32 Cell = 0; Cell < Velocity.Num(); Cell++)
+    {
+        if (Mask->IsCellBlocked(Cell))
+        {
+            Velocity[Cell] = FVector2f::ZeroVector;
+        }
+    }
+}
+
+void FWindLayeredSolver::ApplySolids()
+{
+    for (int32 Cell = 0; Cell < SolidMask.Num(); Cell++)
+    {
+        if (SolidMask[Cell])
+        {
+            Velocity[Cell] = FVector2f::ZeroVector;
+        }
+    }
+}
+
+void FWindLayeredSolver::SetBoundary(TArray<FVector2f>& Field) const
+{
+    const int32 N = Resolution;
+    const FVector Ambient(AmbientVelocity.X, AmbientVelocity.Y, 0.0f);
+    const bool bInflowX[2] = { WindSolverBackend::IsInflowFace(Config, Ambient, 0, -1), WindSolverBackend::IsInflowFace(Config, Ambient, 0, 1) };
+    const bool bInflowY[2] = { WindSolverBackend::IsInflowFace(Config, Ambient, 1, -1), WindSolverBackend::IsInflowFace(Config, Ambient, 1, 1) };
+    FWindTileGraph::ParallelForWorkers(NumBands, Config.MaxTileWorkers, [&](int32 Band)
+    {
+        for (int32 I = 1; I < N - 1; I++)
+        {
+            Field[GetIndex(0, I, Band)] = Field[GetIndex(1, I, Band)];
+            Field[GetIndex(N - 1, I, Band)] = Field[GetIndex(N - 2, I, Band)];
+            Field[GetIndex(I, 0, Band)] = Field[GetIndex(I, 1, Band)];
+            Field[GetIndex(I, N - 1, Band)] = Field[GetIndex(I, N - 2, Band)];
+        }
+
+        Field[GetIndex(0, 0, Band)] = 0.5f * (Field[GetIndex(1, 0, Band)] + Field[GetIndex(0, 1, Band)]);
+        Field[GetIndex(N - 1, 0, Band)] = 0.5f * (Field[GetIndex(N - 2, 0, Band)] + Field[GetIndex(N - 1, 1, Band)]);
+        Field[GetIndex(0, N - 1, Band)] = 0.5f * (Field[GetIndex(1, N - 1, Band)] + Field[GetIndex(0, N - 2, Band)]);
+        Field[GetIndex(N - 1, N - 1, Band)] = 0.5f * (Field[GetIndex(N - 2, N - 1, Band)] + Field[GetIndex(N - 1, N - 2, Band)]);
+
+        // Inflow faces hold the ambient wind so it is carried into the domain by advection
+        for (int32 Side = 0; Side < 2; Side++)
+        {
+            const int32 Face = Side == 0 ? 0 : N - 1;
+            for (int32 I = 0; I < N; I++)
+            {
+                if (bInflowX[Side])
+                {
+                    Field[GetIndex(Face, I, Band)] = AmbientVelocity;
+                }
+                if (bInflowY[Side])
+                {
+                    Field[GetIndex(I, Face, Band)] = AmbientVelocity;
+                }
+            }
+        }
+    });
+}
+
+void FWindLayeredSolver::SetBoundary(TArray<float>& Field) const
+{
+    const int32 N = Resolution;
+    FWindTileGraph::ParallelForWorkers(NumBands, Config.MaxTileWorkers, [&](int32 Band)
+    {
+        for (int32 I = 1; I < N - 1; I++)
+        {
+            Field[GetIndex(0, I, Band)] = Field[GetIndex(1, I, Band)];
+            Field[GetIndex(N - 1, I, Band)] = Field[GetIndex(N - 2, I, Band)];
+            Field[GetIndex(I, 0, Band)] = Field[GetIndex(I, 1, Band)];
+            Field[GetIndex(I, N - 1, Band)] = Field[GetIndex(I, N - 2, Band)];
+        }
+
+        Field[GetIndex(0, 0, Band)] = 0.5f * (Field[GetIndex(1, 0, Band)] + Field[GetIndex(0, 1, Band)]);
+        Field[GetIndex(N - 1, 0, Band)] = 0.5f * (Field[GetIndex(N - 2, 0, Band)] + Field[GetIndex(N - 1, 1, Band)]);
+        Field[GetIndex(0, N - 1, Band)] = 0.5f * (Field[GetIndex(1, N - 1, Band)] + Field[GetIndex(0, N - 2, Band)]);
+        Field[GetIndex(N - 1, N - 1, Band)] = 0.5f * (Field[GetIndex(N - 2, N - 1, Band)] + Field[GetIndex(N - 1, N - 2, Band)]);
+    });
+}
+
+int32 FWindLayeredSolver::GetCellIndex(const FVector& LocalPosition) const
+{
+    const int32 X = FMath::FloorToInt(LocalPosition.X / CellSize);
+    const int32 Y = FMath::FloorToInt(LocalPosition.Y / CellSize);
+    const int32 Band = FMath::RoundToInt(LocalPosition.Z / BandHeight);
+    return IsValidIndex(X, Y, Band) ? GetIndex(X, Y, Band) : INDEX_NONE;
+}
+
+FVector FWindLayeredSolver::SampleVelocity(const FVector& LocalPosition) const
+{
+    if (!IsInitialized())
+    {
+        return FVector::ZeroVector;
+    }
+
+    const float GX = FMath::Clamp(static_cast<float>(LocalPosition.X / CellSize), 0.0f, Resolution - 1.0f);
+    const float GY = FMath::Clamp(static_cast<float>(LocalPosition.Y / CellSize), 0.0f, Resolution - 1.0f);
+    const float GB = FMath::Clamp(static_cast<float>(LocalPosition.Z / BandHeight), 0.0f, NumBands - 1.0f);
+
+    const int32 X0 = FMath::Min(FMath::FloorToInt(GX), Resolution - 2);
+    const int32 Y0 = FMath::Min(FMath::FloorToInt(GY), Resolution - 2);
+    const int32 B0 = FMath::FloorToInt(GB);
+    const int32 B1 = FMath::Min(B0 + 1, NumBands - 1);
+    const float S = GX - X0;
+    const float T = GY - Y0;
+    const float U = GB - B0;
+
+    auto SampleBand = [&](int32 Band)
+    {
+        const int32 Base = GetIndex(X0, Y0, Band);
+        return FMath::Lerp(
+            FMath::Lerp(Velocity[Base], Velocity[Base + 1], S),
+            FMath::Lerp(Velocity[Base + Resolution], Velocity[Base + Resolution + 1], S),
+            T);
+    };
+
+    const FVector2f Result = FMath::Lerp(SampleBand(B0), SampleBand(B1), U);
+    return FVector(Result.X, Result.Y, 0.0f);
+}
+
+bool FWindLayeredSolver::AddVelocity(const FVector& LocalPosition, const FVector& WorldVelocity)
+{
+    const int32 Cell = GetCellIndex(LocalPosition);
+    if (Cell == INDEX_NONE)
+    {
+        return false;
+    }
+
+    AddVelocityAtCell(Cell, WorldVelocity);
+    return true;
+}
+
+void FWindLayeredSolver::AddVelocityAtCell(int32 Cell, const FVector& WorldVelocity)
+{
+    if (SolidMask[Cell])
+    {
+        return;
+    }
+
+    // Vertical injection has nowhere to go in a layered model, so only the horizontal part is kept
+    FVector2f NewVelocity = Velocity[Cell] + FVector2f(WorldVelocity.X, WorldVelocity.Y);
+    if (NewVelocity.SizeSquared() > FMath::Square(Config.MaxVelocity))
+    {
+        NewVelocity = NewVelocity.GetSafeNormal() * Config.MaxVelocity;
+    }
+    Velocity[Cell] = NewVelocity;
+}
+
+bool FWindLayeredSolver::SetSolid(const FVector& LocalPosition, bool bSolid)
+{
+    const int32 X = FMath::FloorToInt(LocalPosition.X / CellSize);
+    const int32 Y = FMath::FloorToInt(LocalPosition.Y / CellSize);
+    const int32 Band = FMath::RoundToInt(LocalPosition.Z / BandHeight);
+
+    if (!IsValidIndex(X, Y, Band))
+    {
+        return false;
+    }
+
+    const int32 Cell = GetIndex(X, Y, Band);
+    SolidMask[Cell] = bSolid ? 1 : 0;
+    if (bSolid)
+    {
+        Velocity[Cell] = FVector2f::ZeroVector;
+    }
+    return true;
+}
+
+void FWindLayeredSolver::Shift(const FIntVector& CellOffset)
+{
+    if (!IsInitialized() || CellOffset == FIntVector::ZeroValue)
+    {
+        return;
+    }
+
+    const TArray<FVector2f> OldVelocity = Velocity;
+    const TArray<uint8> OldSolidMask = SolidMask;
+
+    FWindTileGraph::ParallelForWorkers(NumBands * Resolution, Config.MaxTileWorkers, [&](int32 Row)
+    {
+        const int32 Y = Row % Resolution;
+        const int32 Band = Row / Resolution;
+
+        for (int32 X = 0; X < Resolution; X++)
+        {
+            const int32 Cell = GetIndex(X, Y, Band);
+            const int32 OldX = X - CellOffset.X;
+            const int32 OldY = Y - CellOffset.Y;
+            const int32 OldBand = Band - CellOffset.Z;
+
+            if (IsValidIndex(OldX, OldY, OldBand))
+            {
+                const int32 OldCell = GetIndex(OldX, OldY, OldBand);
+                Velocity[Cell] = OldVelocity[OldCell];
+                SolidMask[Cell] = OldSolidMask[OldCell];
+            }
+            else
+            {
+                Velocity[Cell] = FVector2f::ZeroVector;
+                SolidMask[Cell] = 0;
+            }
+        }
+    });
+}
+
+void FWindLayeredSolver::ExportVelocity(TArray<FVector>& OutVelocity) const
+{
+    if (OutVelocity.Num() != NumCells())
+    {
+        OutVelocity.SetNumUninitialized(NumCells());
+    }
+
+    FWindTileGraph::ParallelForWorkers(NumBands * Resolution, Config.MaxTileWorkers, [&](int32 Row)
+    {
+        const int32 Begin = Row * Resolution;
+        for (int32 Cell = Begin; Cell < Begin + Resolution; Cell++)
+        {
+            OutVelocity[Cell] = FVector(Velocity[Cell].X, Velocity[Cell].Y, 0.0f);
+        }
+    });
+}
\ No newline at end of file
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WindSolverBackend.h"
+
+// 2.5D layered wind solver for large open worlds. Each altitude band runs its own 2D Stable Fluids
+// solve, bands are coupled by a cheap vertical exchange (diffusion) term, and queries interpolate
+// bilinearly within a band and linearly between bands. Band B sits at local height B * BandHeight.
+// Cells a freeze zone covers are held at rest and act as walls in the band solve; rows it covers
+// entirely skip the solve altogether.
+class JK_WINDSYSTEM_API FWindLayeredSolver : public IWindSolverBackend
+{
+public:
+    FWindLayeredSolver();
+
+    virtual const TCHAR* GetName() const override { return TEXT("Layered"); }
+
+    // Config.GridSize and Config.CellSize describe each band; the Layered fields set the bands.
+    virtual void Initialize(const FWindSolverConfig& InConfig) override;
+    virtual bool IsInitialized() const override { return Resolution > 0; }
+    virtual const FWindSolverConfig& GetConfig() const override { return Config; }
+    virtual void Resize(int32 NewGridSize, float NewCellSize) override;
+
+    virtual void Step(float DeltaTime) override;
+
+    // Only the horizontal part of injected velocity is kept
+    virtual bool AddVelocity(const FVector& LocalPosition, const FVector& Velocity) override;
+    virtual FVector SampleVelocity(const FVector& LocalPosition) const override;
+    virtual bool SetSolid(const FVector& LocalPosition, bool bSolid) override;
+    virtual int32 GetCellIndex(const FVector& LocalPosition) const override;
+    virtual void AddVelocityAtCell(int32 CellIndex, const FVector& Velocity) override;
+
+    // Moves the contents by whole cells horizontally and whole bands vertically
+    virtual void Shift(const FIntVector& CellOffset) override;
+    virtual void SetAmbientWind(const FVector& InAmbientVelocity) override { AmbientVelocity = FVector2f(InAmbientVelocity.X, InAmbientVelocity.Y); }
+
+    virtual FIntVector GetDimensions() const override { return FIntVector(Resolution, Resolution, NumBands); }
+    virtual FVector GetCellSpacing() const override { return FVector(CellSize, CellSize, BandHeight); }
+    virtual void ExportVelocity(TArray<FVector>& OutVelocity) const override;
+
+    int32 GetResolution() const { return Resolution; }
+    int32 GetNumBands() const { return NumBands; }
+
+private:
+    FWindSolverConfig Config;
+
+    TArray<FVector2f> Velocity;
+    TArray<FVector2f> TempVelocity;
+    TArray<float> Pressure;
+    TArray<float> Divergence;
+    TArray<uint8> SolidMask;
+    // Per row of a band, set when a freeze zone covers all of it. Refreshed at the start of a step.
+    TArray<uint8> FrozenRows;
+    bool bHasFrozenRows = false;
+    FVector2f AmbientVelocity;
+    TArray<float> SpongeBlend;
+
+    int32 Resolution;
+    int32 NumBands;
+    float CellSize;
+    float BandHeight;
+    float Viscosity;
+    float VerticalExchange;
+
+    void Diffuse(float DeltaTime);
+    void Project();
+    void Advect(float DeltaTime);
+    void ExchangeBands(float DeltaTime);
+    void SetBoundary(TArray<FVector2f>& Field) const;
+    void SetBoundary(TArray<float>& Field) const;
+    void ApplySponge(float DeltaTime);
+    void UpdateFrozenRows();
+    FORCEINLINE bool IsRowFrozen(int32 Row) const { return bHasFrozenRows && FrozenRows[Row] != 0; }
+    // The zone mask while it freezes anything, otherwise null so passes can skip the per-cell test
+    const FWindZoneMask* GetFrozenMask() const;
+    static bool IsCellFrozen(const FWindZoneMask* Frozen, int32 Cell);
+    // Zeroes a row of a field, for rows that are frozen
+    void ClearRow(TArray<FVector2f>& Field, int32 Row) const;
+    void ApplyZones();
+    void ApplySolids();
+
+    FORCEINLINE int32 GetIndex(int32 X, int32 Y, int32 Band) const { return X + Y * Resolution + Band * Resolution * Resolution; }
+    FORCEINLINE bool IsValidIndex(int32 X, int32 Y, int32 Band) const
+    {
+        return X >= 0 && X < Resolution && Y >= 0 && Y < Resolution && Band >= 0 && Band < NumBands;
+    }
+    FORCEINLINE int32 NumCells() const { return Resolution * Resolution * NumBands; }
+};
\ No newline at end of file
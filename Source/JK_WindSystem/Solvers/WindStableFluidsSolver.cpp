@@ -0,0 +1,764 @@
+#include "WindStableFluidsSolver.h"
+#include "WindZoneMask.h"
+
+namespace WindStableFluids
+{
+    // Per-step drag and a small constant push along +X, carried over from the original component
+    const float DecayFactor = 0.99f;
+    const float ForcingX = 0.1f;
+    const float MaxComponentSpeed = 1000.0f;
+
+    const int32 PressureIterations = 20;
+
+    // Time-sliced steps: diffuse and advect run in Z slabs, each projection as divergence, batches
+    // of pressure iterations and gradient subtraction, then one post pass
+    const int32 SlabsPerPass = 4;
+    const int32 PressureIterationsPerSlice = 4;
+    const int32 PressureSlices = (PressureIterations + PressureIterationsPerSlice - 1) / PressureIterationsPerSlice;
+    const int32 ProjectionSlices = PressureSlices + 2;
+    const int32 StepSlices = 2 * SlabsPerPass + 2 * ProjectionSlices + 1;
+}
+
+FWindStableFluidsSolver::FWindStableFluidsSolver()
+    : AmbientVelocity(FVector::ZeroVector)
+    , SliceCursor(WindStableFluids::StepSlices)
+    , SliceDeltaTime(0.0f)
+{
+}
+
+void FWindStableFluidsSolver::Initialize(const FWindSolverConfig& InConfig)
+{
+    Config = InConfig;
+    Config.GridSize = FMath::Max(Config.GridSize, 3);
+    Config.CellSize = FMath::Max(Config.CellSize, UE_KINDA_SMALL_NUMBER);
+
+    const int32 Size = Config.GridSize;
+    VelocityGrid = MakeShared<FWindGrid>(Size, Config.CellSize);
+    TempGrid = MakeShared<FWindGrid>(Size, Config.CellSize);
+    PressureGrid = MakeShared<FWindGrid>(Size, Config.CellSize);
+    DivergenceGrid = MakeShared<FWindGrid>(Size, Config.CellSize);
+    SolidMask.SetNumZeroed(Size * Size * Size);
+    SliceCursor = WindStableFluids::StepSlices;
+}
+
+void FWindStableFluidsSolver::Resize(int32 NewGridSize, float NewCellSize)
+{
+    const FWindStableFluidsSolver Previous = *this;
+
+    FWindSolverConfig NewConfig = Config;
+    NewConfig.GridSize = NewGridSize;
+    NewConfig.CellSize = NewCellSize;
+    Initialize(NewConfig);
+
+    if (Previous.IsInitialized())
+    {
+        WindSolverBackend::Resample(Previous, *this);
+    }
+}
+
+void FWindStableFluidsSolver::Step(float DeltaTime)
+{
+    if (!IsInitialized())
+    {
+        return;
+    }
+
+    // A full step supersedes any time-sliced step in progress
+    SliceCursor = WindStableFluids::StepSlices;
+
+    // The whole step is one graph; TempGrid holds the intermediate state
+    FWindTileGraph Graph = MakeGraph();
+    const int32 Size = VelocityGrid->GetSize();
+    AddDiffuseStage(Graph, TempGrid.Get(), VelocityGrid.Get(), Config.Viscosity, DeltaTime, 0, Size);
+    AddVelocityBoundaryStage(Graph, TempGrid.Get());
+    AddProjectStages(Graph, TempGrid.Get());
+    AddAdvectStage(Graph, VelocityGrid.Get(), TempGrid.Get(), TempGrid.Get(), DeltaTime, 0, Size);
+    AddVelocityBoundaryStage(Graph, VelocityGrid.Get());
+    AddProjectStages(Graph, VelocityGrid.Get());
+    AddPostStage(Graph, DeltaTime);
+    Graph.Execute();
+}
+
+void FWindStableFluidsSolver::BeginStep(float DeltaTime)
+{
+    SliceDeltaTime = DeltaTime;
+    SliceCursor = IsInitialized() ? 0 : WindStableFluids::StepSlices;
+}
+
+bool FWindStableFluidsSolver::StepSlice()
+{
+    using namespace WindStableFluids;
+
+    if (!IsInitialized() || SliceCursor >= StepSlices)
+    {
+        return true;
+    }
+
+    // Same sequence as Step, split at pass and slab boundaries. Each slice is its own graph.
+    FWindTileGraph Graph = MakeGraph();
+    const int32 Size = VelocityGrid->GetSize();
+    int32 Slice = SliceCursor++;
+    bool bComplete = false;
+
+    if (Slice < SlabsPerPass)
+    {
+        AddDiffuseStage(Graph, TempGrid.Get(), VelocityGrid.Get(), Config.Viscosity, SliceDeltaTime, GetSlabBegin(Size, Slice), GetSlabBegin(Size, Slice + 1));
+        if (Slice == SlabsPerPass - 1)
+        {
+            AddVelocityBoundaryStage(Graph, TempGrid.Get());
+        }
+    }
+    else if ((Slice -= SlabsPerPass) < ProjectionSlices)
+    {
+        AddProjectSliceStages(Graph, TempGrid.Get(), Slice);
+    }
+    else if ((Slice -= ProjectionSlices) < SlabsPerPass)
+    {
+        AddAdvectStage(Graph, VelocityGrid.Get(), TempGrid.Get(), TempGrid.Get(), SliceDeltaTime, GetSlabBegin(Size, Slice), GetSlabBegin(Size, Slice + 1));
+        if (Slice == SlabsPerPass - 1)
+        {
+            AddVelocityBoundaryStage(Graph, VelocityGrid.Get());
+        }
+    }
+    else if ((Slice -= SlabsPerPass) < ProjectionSlices)
+    {
+        AddProjectSliceStages(Graph, VelocityGrid.Get(), Slice);
+    }
+    else
+    {
+        AddPostStage(Graph, SliceDeltaTime);
+        bComplete = true;
+    }
+
+    Graph.Execute();
+    return bComplete;
+}
+
+float FWindStableFluidsSolver::GetStepProgress() const
+{
+    return static_cast<float>(SliceCursor) / WindStableFluids::StepSlices;
+}
+
+int32 FWindStableFluidsSolver::GetSlabBegin(int32 Size, int32 Slab)
+{
+    return Size * Slab / WindStableFluids::SlabsPerPass;
+}
+
+FWindTileGraph FWindStableFluidsSolver::MakeGraph() const
+{
+    return FWindTileGraph(Config.TileSize, Config.MaxTileWorkers);
+}
+
+const FWindZoneMask* FWindStableFluidsSolver::GetFrozenMask() const
+{
+    return ZoneMask.IsValid() && ZoneMask->HasFrozen() ? ZoneMask.Get() : nullptr;
+}
+
+bool FWindStableFluidsSolver::IsTileFrozen(const FWindZoneMask* Frozen, const FWindTile& Tile)
+{
+    return Frozen && Frozen->IsRegionFrozen(Tile.Begin, Tile.End);
+}
+
+FORCEINLINE bool FWindStableFluidsSolver::IsCellFrozen(const FWindZoneMask* Frozen, const FWindGrid& Field, int32 I, int32 J, int32 K)
+{
+    return Frozen && Field.IsValidIndex(I, J, K) && Frozen->IsCellFrozen(Field.GetIndex(I, J, K));
+}
+
+void FWindStableFluidsSolver::ClearTile(FWindGrid& Field, const FWindTile& Tile)
+{
+    for (int32 K = Tile.Begin.Z; K < Tile.End.Z; K++)
+    {
+        for (int32 J = Tile.Begin.Y; J < Tile.End.Y; J++)
+        {
+            for (int32 I = Tile.Begin.X; I < Tile.End.X; I++)
+            {
+                Field.SetCell(I, J, K, FVector::ZeroVector);
+            }
+        }
+    }
+}
+
+bool FWindStableFluidsSolver::AddVelocity(const FVector& LocalPosition, const FVector& Velocity)
+{
+    const int32 Cell = GetCellIndex(LocalPosition);
+    if (Cell == INDEX_NONE)
+    {
+        return false;
+    }
+
+    AddVelocityAtCell(Cell, Velocity);
+    return true;
+}
+
+void FWindStableFluidsSolver::AddVelocityAtCell(int32 CellIndex, const FVector& Velocity)
+{
+    FVector& CellVelocity = VelocityGrid->GetGridData()[CellIndex];
+    FVector NewVelocity = CellVelocity + Velocity;
+
+    // Clamp the new velocity to prevent extreme values
+    if (NewVelocity.SizeSquared() > FMath::Square(Config.MaxVelocity))
+    {
+        NewVelocity = NewVelocity.GetSafeNormal() * Config.MaxVelocity;
+    }
+
+    CellVelocity = NewVelocity;
+}
+
+int32 FWindStableFluidsSolver::GetCellIndex(const FVector& LocalPosition) const
+{
+    if (!IsInitialized())
+    {
+        return INDEX_NONE;
+    }
+
+    const FVector GridPos = LocalPosition / Config.CellSize;
+    const int32 X = FMath::FloorToInt(GridPos.X);
+    const int32 Y = FMath::FloorToInt(GridPos.Y);
+    const int32 Z = FMath::FloorToInt(GridPos.Z);
+    return VelocityGrid->IsValidIndex(X, Y, Z) ? VelocityGrid->GetIndex(X, Y, Z) : INDEX_NONE;
+}
+
+FVector FWindStableFluidsSolver::SampleVelocity(const FVector& LocalPosition) const
+{
+    return IsInitialized() ? InterpolateVelocity(LocalPosition / Config.CellSize) : FVector::ZeroVector;
+}
+
+bool FWindStableFluidsSolver::SetSolid(const FVector& LocalPosition, bool bSolid)
+{
+    if (!IsInitialized())
+    {
+        return false;
+    }
+
+    const FVector GridPos = LocalPosition / Config.CellSize;
+    const int32 X = FMath::FloorToInt(GridPos.X);
+    const int32 Y = FMath::FloorToInt(GridPos.Y);
+    const int32 Z = FMath::FloorToInt(GridPos.Z);
+
+    if (!VelocityGrid->IsValidIndex(X, Y, Z))
+    {
+        return false;
+    }
+
+    SolidMask[VelocityGrid->GetIndex(X, Y, Z)] = bSolid ? 1 : 0;
+    if (bSolid)
+    {
+        VelocityGrid->SetCell(X, Y, Z, FVector::ZeroVector);
+    }
+    return true;
+}
+
+void FWindStableFluidsSolver::Shift(const FIntVector& CellOffset)
+{
+    if (!IsInitialized() || CellOffset == FIntVector::ZeroValue)
+    {
+        return;
+    }
+
+    const int32 Size = VelocityGrid->GetSize();
+    TSharedPtr<FWindGrid> NewGrid = MakeShared<FWindGrid>(Size, Config.CellSize);
+    TArray<uint8> NewSolidMask;
+    NewSolidMask.SetNumZeroed(SolidMask.Num());
+
+    for (int32 x = 0; x < Size; ++x)
+    {
+        for (int32 y = 0; y < Size; ++y)
+        {
+            for (int32 z = 0; z < Size; ++z)
+            {
+                int32 OldX = x - CellOffset.X;
+                int32 OldY = y - CellOffset.Y;
+                int32 OldZ = z - CellOffset.Z;
+
+                if (VelocityGrid->IsValidIndex(OldX, OldY, OldZ))
+                {
+                    NewGrid->SetCell(x, y, z, VelocityGrid->GetCell(OldX, OldY, OldZ));
+                    NewSolidMask[NewGrid->GetIndex(x, y, z)] = SolidMask[VelocityGrid->GetIndex(OldX, OldY, OldZ)];
+                }
+            }
+        }
+    }
+
+    VelocityGrid = NewGrid;
+    SolidMask = MoveTemp(NewSolidMask);
+}
+
+FIntVector FWindStableFluidsSolver::GetDimensions() const
+{
+    return IsInitialized() ? VelocityGrid->GetBoundSize() : FIntVector::ZeroValue;
+}
+
+void FWindStableFluidsSolver::ExportVelocity(TArray<FVector>& OutVelocity) const
+{
+    if (IsInitialized())
+    {
+        OutVelocity = VelocityGrid->GetGridData();
+    }
+}
+
+void FWindStableFluidsSolver::AddDiffuseStage(FWindTileGraph& Graph, FWindGrid* Dst, const FWindGrid* Src, float Diff, float Dt, int32 ZBegin, int32 ZEnd) const
+{
+    const int32 Size = Src->GetSize();
+    const float a = Dt * Diff * (Size - 2) * (Size - 2);
+
+    const FWindZoneMask* Frozen = GetFrozenMask();
+
+    Graph.AddTiledStage(FIntVector(1, 1, ZBegin), FIntVector(Size - 1, Size - 1, ZEnd), [Dst, Src, a, Frozen](const FWindTile& Tile)
+    {
+        // Frozen tiles are solid: at rest, and read as such by the tiles around them
+        if (IsTileFrozen(Frozen, Tile))
+        {
+            ClearTile(*Dst, Tile);
+            return;
+        }
+
+        for (int32 K = Tile.Begin.Z; K < Tile.End.Z; K++)
+        {
+            for (int32 J = Tile.Begin.Y; J < Tile.End.Y; J++)
+            {
+                for (int32 I = Tile.Begin.X; I < Tile.End.X; I++)
+                {
+                    if (IsCellFrozen(Frozen, *Dst, I, J, K))
+                    {
+                        Dst->SetCell(I, J, K, FVector::ZeroVector);
+                        continue;
+                    }
+
+                    FVector NewValue = (Src->GetCell(I, J, K) +
+                        a * (Src->GetCell(I - 1, J, K) + Src->GetCell(I + 1, J, K) +
+                            Src->GetCell(I, J - 1, K) + Src->GetCell(I, J + 1, K) +
+                            Src->GetCell(I, J, K - 1) + Src->GetCell(I, J, K + 1))) / (1 + 6 * a);
+                    Dst->SetCell(I, J, K, NewValue);
+                }
+            }
+        }
+    });
+}
+
+void FWindStableFluidsSolver::AddProjectStages(FWindTileGraph& Graph, FWindGrid* Velocity)
+{
+    AddDivergenceStages(Graph, Velocity);
+    AddPressureStages(Graph, WindStableFluids::PressureIterations);
+    AddGradientStages(Graph, Velocity);
+}
+
+void FWindStableFluidsSolver::AddProjectSliceStages(FWindTileGraph& Graph, FWindGrid* Velocity, int32 Slice)
+{
+    using namespace WindStableFluids;
+
+    if (Slice == 0)
+    {
+        AddDivergenceStages(Graph, Velocity);
+    }
+    else if (Slice <= PressureSlices)
+    {
+        const int32 FirstIteration = (Slice - 1) * PressureIterationsPerSlice;
+        AddPressureStages(Graph, FMath::Min(PressureIterationsPerSlice, PressureIterations - FirstIteration));
+    }
+    else
+    {
+        AddGradientStages(Graph, Velocity);
+    }
+}
+
+void FWindStableFluidsSolver::AddDivergenceStages(FWindTileGraph& Graph, const FWindGrid* Velocity)
+{
+    const int32 Size = Velocity->GetSize();
+    const double H = 1.0 / (Size - 2);
+    FWindGrid* P = PressureGrid.Get();
+    FWindGrid* Div = DivergenceGrid.Get();
+
+    const FWindZoneMask* Frozen = GetFrozenMask();
+
+    Graph.AddTiledStage(FIntVector(1, 1, 0), FIntVector(Size - 1, Size - 1, Size), [Velocity, P, Div, H, Frozen](const FWindTile& Tile)
+    {
+        if (IsTileFrozen(Frozen, Tile))
+        {
+            ClearTile(*Div, Tile);
+            ClearTile(*P, Tile);
+            return;
+        }
+
+        for (int32 K = Tile.Begin.Z; K < Tile.End.Z; K++)
+        {
+            for (int32 J = Tile.Begin.Y; J < Tile.End.Y; J++)
+            {
+                for (int32 I = Tile.Begin.X; I < Tile.End.X; I++)
+                {
+                    if (IsCellFrozen(Frozen, *Div, I, J, K))
+                    {
+                        Div->SetCell(I, J, K, FVector::ZeroVector);
+                        P->SetCell(I, J, K, FVector::ZeroVector);
+                        continue;
+                    }
+
+                    double DivValue = -0.5 * H * (
+                        Velocity->GetCell(I + 1, J, K).X - Velocity->GetCell(I - 1, J, K).X +
+                        Velocity->GetCell(I, J + 1, K).Y - Velocity->GetCell(I, J - 1, K).Y +
+                        Velocity->GetCell(I, J, K + 1).Z - Velocity->GetCell(I, J, K - 1).Z
+                        );
+                    Div->SetCell(I, J, K, FVector(DivValue));
+                    P->SetCell(I, J, K, FVector::ZeroVector);
+                }
+            }
+        }
+    });
+
+    AddBoundaryStage(Graph, Div);
+    AddBoundaryStage(Graph, P);
+}
+
+void FWindStableFluidsSolver::AddPressureStages(FWindTileGraph& Graph, int32 NumIterations)
+{
+    const int32 Size = PressureGrid->GetSize();
+    FWindGrid* P = PressureGrid.Get();
+    const FWindGrid* Div = DivergenceGrid.Get();
+    const FWindZoneMask* Frozen = GetFrozenMask();
+
+    // Red-black Gauss-Seidel, as in FWindLayeredSolver::Project: each half-sweep only updates cells
+    // of one colour and only reads cells of the other, so tiles running side by side never see
+    // each other's writes and the result does not depend on the tile shape or worker count
+    for (int32 Iteration = 0; Iteration < NumIterations; Iteration++)
+    {
+        for (int32 Colour = 0; Colour < 2; Colour++)
+        {
+            AddPressureColourStage(Graph, P, Div, Frozen, Size, Colour);
+        }
+        AddBoundaryStage(Graph, P);
+    }
+}
+
+void FWindStableFluidsSolver::AddPressureColourStage(FWindTileGraph& Graph, FWindGrid* P, const FWindGrid* Div, const FWindZoneMask* Frozen, int32 Size, int32 Colour) const
+{
+    // Pressure in frozen cells stays at the zero the divergence pass left
+    Graph.AddTiledStage(FIntVector(1, 1, 0), FIntVector(Size - 1, Size - 1, Size), [P, Div, Frozen, Colour](const FWindTile& Tile)
+    {
+        if (IsTileFrozen(Frozen, Tile))
+        {
+            return;
+        }
+
+        for (int32 K = Tile.Begin.Z; K < Tile.End.Z; K++)
+        {
+            for (int32 J = Tile.Begin.Y; J < Tile.End.Y; J++)
+            {
+                // Cells whose coordinates sum to the colour's parity
+                for (int32 I = Tile.Begin.X + ((Tile.Begin.X + J + K + Colour) & 1); I < Tile.End.X; I += 2)
+                {
+                    if (!Frozen)
+                    {
+                        double PValue = (Div->GetCell(I, J, K).X +
+                            P->GetCell(I - 1, J, K).X + P->GetCell(I + 1, J, K).X +
+                            P->GetCell(I, J - 1, K).X + P->GetCell(I, J + 1, K).X +
+                            P->GetCell(I, J, K - 1).X + P->GetCell(I, J, K + 1).X) / 6.0;
+                        P->SetCell(I, J, K, FVector(PValue));
+                        continue;
+                    }
+
+                    if (IsCellFrozen(Frozen, *P, I, J, K))
+                    {
+                        continue;
+                    }
+
+                    // Frozen neighbours are walls with no pressure gradient into them, so they drop
+                    // out of the stencil
+                    double Sum = Div->GetCell(I, J, K).X;
+                    int32 NumOpen = 0;
+                    auto Gather = [P, Frozen, &Sum, &NumOpen](int32 NI, int32 NJ, int32 NK)
+                    {
+                        if (!IsCellFrozen(Frozen, *P, NI, NJ, NK))
+                        {
+                            Sum += P->GetCell(NI, NJ, NK).X;
+                            NumOpen++;
+                        }
+                    };
+                    Gather(I - 1, J, K);
+                    Gather(I + 1, J, K);
+                    Gather(I, J - 1, K);
+                    Gather(I, J + 1, K);
+                    Gather(I, J, K - 1);
+                    Gather(I, J, K + 1);
+                    P->SetCell(I, J, K, FVector(NumOpen > 0 ? Sum / NumOpen : 0.0));
+                }
+            }
+        }
+    });
+}
+
+void FWindStableFluidsSolver::AddGradientStages(FWindTileGraph& Graph, FWindGrid* Velocity)
+{
+    const int32 Size = Velocity->GetSize();
+    const double H = 1.0 / (Size - 2);
+    const FWindGrid* P = PressureGrid.Get();
+
+    const FWindZoneMask* Frozen = GetFrozenMask();
+
+    Graph.AddTiledStage(FIntVector(1, 1, 0), FIntVector(Size - 1, Size - 1, Size), [Velocity, P, H, Frozen](const FWindTile& Tile)
+    {
+        if (IsTileFrozen(Frozen, Tile))
+        {
+            return;
+        }
+
+        for (int32 K = Tile.Begin.Z; K < Tile.End.Z; K++)
+        {
+            for (int32 J = Tile.Begin.Y; J < Tile.End.Y; J++)
+            {
+                for (int32 I = Tile.Begin.X; I < Tile.End.X; I++)
+                {
+                    if (IsCellFrozen(Frozen, *Velocity, I, J, K))
+                    {
+                        continue;
+                    }
+
+                    // A frozen neighbour mirrors the cell's own pressure, as in the pressure solve
+                    const double Centre = P->GetCell(I, J, K).X;
+                    auto Pressure = [P, Frozen, Centre](int32 NI, int32 NJ, int32 NK)
+                    {
+                        return IsCellFrozen(Frozen, *P, NI, NJ, NK) ? Centre : P->GetCell(NI, NJ, NK).X;
+                    };
+
+                    FVector Vel = Velocity->GetCell(I, J, K);
+                    Vel.X -= 0.5 * (Pressure(I + 1, J, K) - Pressure(I - 1, J, K)) / H;
+                    Vel.Y -= 0.5 * (Pressure(I, J + 1, K) - Pressure(I, J - 1, K)) / H;
+                    Vel.Z -= 0.5 * (Pressure(I, J, K + 1) - Pressure(I, J, K - 1)) / H;
+                    Velocity->SetCell(I, J, K, Vel);
+                }
+            }
+        }
+    });
+
+    AddVelocityBoundaryStage(Graph, Velocity);
+}
+
+void FWindStableFluidsSolver::AddBoundaryStage(FWindTileGraph& Graph, FWindGrid* Field) const
+{
+    // The faces are a small fraction of the volume, so they run as one serial stage
+    Graph.AddSerialStage([Field]() { SetBoundary(*Field); });
+}
+
+void FWindStableFluidsSolver::AddVelocityBoundaryStage(FWindTileGraph& Graph, FWindGrid* Field) const
+{
+    Graph.AddSerialStage([this, Field]() { SetVelocityBoundary(*Field); });
+}
+
+void FWindStableFluidsSolver::SetBoundary(FWindGrid& Field)
+{
+    int32 Size = Field.GetSize();
+
+    for (int32 A = 0; A < Size; A++)
+    {
+        for (int32 B = 1; B < Size - 1; B++)
+        {
+            Field.SetCell(A, B, 0, Field.GetCell(A, B, 1));
+            Field.SetCell(A, B, Size - 1, Field.GetCell(A, B, Size - 2));
+            Field.SetCell(B, 0, A, Field.GetCell(B, 1, A));
+            Field.SetCell(B, Size - 1, A, Field.GetCell(B, Size - 2, A));
+            Field.SetCell(0, A, B, Field.GetCell(1, A, B));
+            Field.SetCell(Size - 1, A, B, Field.GetCell(Size - 2, A, B));
+        }
+    }
+
+    // Set corner values
+    Field.SetCell(0, 0, 0, (Field.GetCell(1, 0, 0) + Field.GetCell(0, 1, 0) + Field.GetCell(0, 0, 1)) / 3.0f);
+    Field.SetCell(0, Size - 1, 0, (Field.GetCell(1, Size - 1, 0) + Field.GetCell(0, Size - 2, 0) + Field.GetCell(0, Size - 1, 1)) / 3.0f);
+    Field.SetCell(0, 0, Size - 1, (Field.GetCell(1, 0, Size - 1) + Field.GetCell(0, 1, Size - 1) + Field.GetCell(0, 0, Size - 2)) / 3.0f);
+    Field.SetCell(0, Size - 1, Size - 1, (Field.GetCell(1, Size - 1, Size - 1) + Field.GetCell(0, Size - 2, Size - 1) + Field.GetCell(0, Size - 1, Size - 2)) / 3.0f);
+    Field.SetCell(Size - 1, 0, 0, (Field.GetCell(Size - 2, 0, 0) + Field.GetCell(Size - 1, 1, 0) + Field.GetCell(Size - 1, 0, 1)) / 3.0f);
+    Field.SetCell(Size - 1, Size - 1, 0, (Field.GetCell(Size - 2, Size - 1, 0) + Field.GetCell(Size - 1, Size - 2, 0) + Field.GetCell(Size - 1, Size - 1, 1)) / 3.0f);
+    Field.SetCell(Size - 1, 0, Size - 1, (Field.GetCell(Size - 2, 0, Size - 1) + Field.GetCell(Size - 1, 1, Size - 1) + Field.GetCell(Size - 1, 0, Size - 2)) / 3.0f);
+    Field.SetCell(Size - 1, Size - 1, Size - 1, (Field.GetCell(Size - 2, Size - 1, Size - 1) + Field.GetCell(Size - 1, Size - 2, Size - 1) + Field.GetCell(Size - 1, Size - 1, Size - 2)) / 3.0f);
+}
+
+void FWindStableFluidsSolver::SetVelocityBoundary(FWindGrid& Field) const
+{
+    SetBoundary(Field);
+
+    if (!Config.bOpenBoundaries || AmbientVelocity.IsNearlyZero())
+    {
+        return;
+    }
+
+    // Inflow faces hold the ambient wind so it is carried into the domain by advection
+    const int32 Size = Field.GetSize();
+    for (int32 Axis = 0; Axis < 3; Axis++)
+    {
+        for (int32 Side = -1; Side <= 1; Side += 2)
+        {
+            if (!WindSolverBackend::IsInflowFace(Config, AmbientVelocity, Axis, Side))
+            {
+                continue;
+            }
+
+            const int32 Face = Side < 0 ? 0 : Size - 1;
+            for (int32 A = 0; A < Size; A++)
+            {
+                for (int32 B = 0; B < Size; B++)
+                {
+                    FIntVector Cell;
+                    Cell[Axis] = Face;
+                    Cell[(Axis + 1) % 3] = A;
+                    Cell[(Axis + 2) % 3] = B;
+                    Field.SetCell(Cell.X, Cell.Y, Cell.Z, AmbientVelocity);
+                }
+            }
+        }
+    }
+}
+
+void FWindStableFluidsSolver::AddAdvectStage(FWindTileGraph& Graph, FWindGrid* Dst, const FWindGrid* Src, const FWindGrid* Velocity, float Dt, int32 ZBegin, int32 ZEnd) const
+{
+    const int32 Size = Src->GetSize();
+    const float Dt0 = Dt * (Size - 2);
+
+    const FWindZoneMask* Frozen = GetFrozenMask();
+
+    Graph.AddTiledStage(FIntVector(1, 1, ZBegin), FIntVector(Size - 1, Size - 1, ZEnd), [Dst, Src, Velocity, Size, Dt0, Frozen](const FWindTile& Tile)
+    {
+        if (IsTileFrozen(Frozen, Tile))
+        {
+            ClearTile(*Dst, Tile);
+            return;
+        }
+
+        for (int32 K = Tile.Begin.Z; K < Tile.End.Z; K++)
+        {
+            for (int32 J = Tile.Begin.Y; J < Tile.End.Y; J++)
+            {
+                for (int32 I = Tile.Begin.X; I < Tile.End.X; I++)
+                {
+                    if (IsCellFrozen(Frozen, *Dst, I, J, K))
+                    {
+                        Dst->SetCell(I, J, K, FVector::ZeroVector);
+                        continue;
+                    }
+
+                    FVector Pos = FVector(I, J, K) - Dt0 * Velocity->GetCell(I, J, K);
+
+                    Pos.X = FMath::Clamp(Pos.X, 0.5f, Size - 1.5f);
+                    int32 I0 = FMath::FloorToInt(Pos.X);
+                    int32 I1 = I0 + 1;
+
+                    Pos.Y = FMath::Clamp(Pos.Y, 0.5f, Size - 1.5f);
+                    int32 J0 = FMath::FloorToInt(Pos.Y);
+                    int32 J1 = J0 + 1;
+
+                    Pos.Z = FMath::Clamp(Pos.Z, 0.5f, Size - 1.5f);
+                    int32 K0 = FMath::FloorToInt(Pos.Z);
+                    int32 K1 = K0 + 1;
+
+                    float S1 = Pos.X - I0;
+                    float S0 = 1 - S1;
+                    float T1 = Pos.Y - J0;
+                    float T0 = 1 - T1;
+                    float U1 = Pos.Z - K0;
+                    float U0 = 1 - U1;
+
+                    Dst->SetCell(I, J, K,
+                        S0 * (T0 * (U0 * Src->GetCell(I0, J0, K0) + U1 * Src->GetCell(I0, J0, K1)) +
+                              T1 * (U0 * Src->GetCell(I0, J1, K0) + U1 * Src->GetCell(I0, J1, K1))) +
+                        S1 * (T0 * (U0 * Src->GetCell(I1, J0, K0) + U1 * Src->GetCell(I1, J0, K1)) +
+                              T1 * (U0 * Src->GetCell(I1, J1, K0) + U1 * Src->GetCell(I1, J1, K1)))
+                    );
+                }
+            }
+        }
+    });
+}
+
+void FWindStableFluidsSolver::AddPostStage(FWindTileGraph& Graph, float DeltaTime)
+{
+    using namespace WindStableFluids;
+
+    WindSolverBackend::GetSpongeBlend(Config, DeltaTime, SpongeBlend);
+
+    FWindGrid* Grid = VelocityGrid.Get();
+    const int32 Size = Grid->GetSize();
+    const double ForcingStep = ForcingX * DeltaTime;
+
+    // Every cell is independent here, so the passes fuse into one sweep per tile
+    const FWindZoneMask* Mask = ZoneMask.Get();
+    const FWindZoneMask* Frozen = GetFrozenMask();
+    Graph.AddTiledStage(FIntVector::ZeroValue, FIntVector(Size), [this, Grid, Size, ForcingStep, Mask, Frozen](const FWindTile& Tile)
+    {
+        if (IsTileFrozen(Frozen, Tile))
+        {
+            ClearTile(*Grid, Tile);
+            return;
+        }
+
+        TArray<FVector>& GridData = Grid->GetGridData();
+        const int32 Width = SpongeBlend.Num();
+
+        for (int32 K = Tile.Begin.Z; K < Tile.End.Z; K++)
+        {
+            for (int32 J = Tile.Begin.Y; J < Tile.End.Y; J++)
+            {
+                const int32 DistanceYZ = FMath::Min(FMath::Min(K, Size - 1 - K), FMath::Min(J, Size - 1 - J));
+                for (int32 I = Tile.Begin.X; I < Tile.End.X; I++)
+                {
+                    const int32 Index = Grid->GetIndex(I, J, K);
+                    FVector& WindVelocity = GridData[Index];
+
+                    // Apply decay (simulate drag)
+                    WindVelocity *= DecayFactor;
+
+                    // Apply global wind force
+                    WindVelocity.X += ForcingStep;
+
+                    // Clamp velocities to prevent extreme values
+                    WindVelocity.X = FMath::Clamp(WindVelocity.X, -MaxComponentSpeed, MaxComponentSpeed);
+                    WindVelocity.Y = FMath::Clamp(WindVelocity.Y, -MaxComponentSpeed, MaxComponentSpeed);
+                    WindVelocity.Z = FMath::Clamp(WindVelocity.Z, -MaxComponentSpeed, MaxComponentSpeed);
+
+                    const int32 Distance = FMath::Min(DistanceYZ, FMath::Min(I, Size - 1 - I));
+                    if (Distance < Width)
+                    {
+                        WindVelocity += (AmbientVelocity - WindVelocity) * SpongeBlend[Distance];
+                    }
+
+                    if (SolidMask[Index] || (Mask && Mask->IsCellBlocked(Index)))
+                    {
+                        WindVelocity = FVector::ZeroVector;
+                    }
+                }
+            }
+        }
+    });
+}
+
+FVector FWindStableFluidsSolver::InterpolateVelocity(const FVector& Position) const
+{
+    int32 Size = VelocityGrid->GetSize();
+    int32 X0 = FMath::FloorToInt(Position.X);
+    int32 Y0 = FMath::FloorToInt(Position.Y);
+    int32 Z0 = FMath::FloorToInt(Position.Z);
+    int32 X1 = FMath::Min(X0 + 1, Size - 1);
+    int32 Y1 = FMath::Min(Y0 + 1, Size - 1);
+    int32 Z1 = FMath::Min(Z0 + 1, Size - 1);
+
+    float Sx = Position.X - X0;
+    float Sy = Position.Y - Y0;
+    float Sz = Position.Z - Z0;
+
+    FVector C000 = VelocityGrid->GetCell(X0, Y0, Z0);
+    FVector C100 = VelocityGrid->GetCell(X1, Y0, Z0);
+    FVector C010 = VelocityGrid->GetCell(X0, Y1, Z0);
+    FVector C110 = VelocityGrid->GetCell(X1, Y1, Z0);
+    FVector C001 = VelocityGrid->GetCell(X0, Y0, Z1);
+    FVector C101 = VelocityGrid->GetCell(X1, Y0, Z1);
+    FVector C011 = VelocityGrid->GetCell(X0, Y1, Z1);
+    FVector C111 = VelocityGrid->GetCell(X1, Y1, Z1);
+
+    return FMath::Lerp(
+        FMath::Lerp(
+            FMath::Lerp(C000, C100, Sx),
+            FMath::Lerp(C010, C110, Sx),
+            Sy),
+        FMath::Lerp(
+            FMath::Lerp(C001, C101, Sx),
+            FMath::Lerp(C011, C111, Sx),
+            Sy),
+        Sz
+    );
+}
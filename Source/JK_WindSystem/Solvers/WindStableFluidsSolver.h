@@ -0,0 +1,85 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WindSolverBackend.h"
+#include "WindGrid.h"
+#include "WindTileGraph.h"
+
+// Reference backend: Jos Stam's Stable Fluids on a dense cubic grid (diffuse, project, advect,
+// project). Obstacle cells have no boundary treatment and are simply held at rest. Tiles a freeze
+// zone covers entirely are held at rest the same way and skip every pass.
+class JK_WINDSYSTEM_API FWindStableFluidsSolver : public IWindSolverBackend
+{
+public:
+    FWindStableFluidsSolver();
+
+    virtual const TCHAR* GetName() const override { return TEXT("StableFluids"); }
+
+    virtual void Initialize(const FWindSolverConfig& InConfig) override;
+    virtual bool IsInitialized() const override { return VelocityGrid.IsValid(); }
+    virtual const FWindSolverConfig& GetConfig() const override { return Config; }
+    virtual void Resize(int32 NewGridSize, float NewCellSize) override;
+
+    virtual void Step(float DeltaTime) override;
+    virtual void BeginStep(float DeltaTime) override;
+    virtual bool StepSlice() override;
+    virtual float GetStepProgress() const override;
+
+    virtual bool AddVelocity(const FVector& LocalPosition, const FVector& Velocity) override;
+    virtual FVector SampleVelocity(const FVector& LocalPosition) const override;
+    virtual bool SetSolid(const FVector& LocalPosition, bool bSolid) override;
+    virtual int32 GetCellIndex(const FVector& LocalPosition) const override;
+    virtual void AddVelocityAtCell(int32 CellIndex, const FVector& Velocity) override;
+
+    virtual void Shift(const FIntVector& CellOffset) override;
+    virtual void SetAmbientWind(const FVector& InAmbientVelocity) override { AmbientVelocity = InAmbientVelocity; }
+
+    virtual FIntVector GetDimensions() const override;
+    virtual FVector GetCellSpacing() const override { return FVector(Config.CellSize); }
+    virtual void ExportVelocity(TArray<FVector>& OutVelocity) const override;
+
+private:
+    FWindSolverConfig Config;
+
+    TSharedPtr<FWindGrid> VelocityGrid;
+    TSharedPtr<FWindGrid> TempGrid;
+    TSharedPtr<FWindGrid> PressureGrid;
+    TSharedPtr<FWindGrid> DivergenceGrid;
+    TArray<uint8> SolidMask;
+    FVector AmbientVelocity;
+    TArray<float> SpongeBlend;
+
+    // Next slice of the time-sliced step, WindStableFluids::StepSlices when idle
+    int32 SliceCursor;
+    float SliceDeltaTime;
+
+    static int32 GetSlabBegin(int32 Size, int32 Slab);
+
+    // Zone mask when it freezes anything, otherwise null
+    const FWindZoneMask* GetFrozenMask() const;
+    static bool IsTileFrozen(const FWindZoneMask* Frozen, const FWindTile& Tile);
+    // Frozen cells are solid in every pass: held at rest and a wall to the pressure solve. Cells
+    // outside the grid are not frozen.
+    static bool IsCellFrozen(const FWindZoneMask* Frozen, const FWindGrid& Field, int32 I, int32 J, int32 K);
+    static void ClearTile(FWindGrid& Field, const FWindTile& Tile);
+
+    // The Add*Stages functions queue work on a step graph; nothing runs until it executes
+    FWindTileGraph MakeGraph() const;
+    void AddDiffuseStage(FWindTileGraph& Graph, FWindGrid* Dst, const FWindGrid* Src, float Diff, float Dt, int32 ZBegin, int32 ZEnd) const;
+    void AddAdvectStage(FWindTileGraph& Graph, FWindGrid* Dst, const FWindGrid* Src, const FWindGrid* Velocity, float Dt, int32 ZBegin, int32 ZEnd) const;
+    void AddProjectStages(FWindTileGraph& Graph, FWindGrid* Velocity);
+    void AddProjectSliceStages(FWindTileGraph& Graph, FWindGrid* Velocity, int32 Slice);
+    void AddDivergenceStages(FWindTileGraph& Graph, const FWindGrid* Velocity);
+    void AddPressureStages(FWindTileGraph& Graph, int32 NumIterations);
+    // One half-sweep of the red-black pressure solve over the cells of one colour
+    void AddPressureColourStage(FWindTileGraph& Graph, FWindGrid* P, const FWindGrid* Div, const FWindZoneMask* Frozen, int32 Size, int32 Colour) const;
+    void AddGradientStages(FWindTileGraph& Graph, FWindGrid* Velocity);
+    void AddBoundaryStage(FWindTileGraph& Graph, FWindGrid* Field) const;
+    void AddVelocityBoundaryStage(FWindTileGraph& Graph, FWindGrid* Field) const;
+    // Drag, forcing, sponge layer, zones and obstacles in a single pass
+    void AddPostStage(FWindTileGraph& Graph, float DeltaTime);
+
+    static void SetBoundary(FWindGrid& Field);
+    void SetVelocityBoundary(FWindGrid& Field) const;
+    FVector InterpolateVelocity(const FVector& Position) const;
+};
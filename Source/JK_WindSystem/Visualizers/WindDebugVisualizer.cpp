@@ -15,6 +15,7 @@ public:
     FWindDebugSceneProxy(const UWindDebugVisualizer* InComponent)
         : FPrimitiveSceneProxy(InComponent)
         , DebugArrows(InComponent->DebugArrows)
+        , StreamlineSegments(InComponent->StreamlineSegments)
     {
         bWillEverBeLit = false;
     }
@@ -44,6 +45,11 @@ public:
                     PDI->DrawLine(Arrow.End, Arrow.End - ArrowDirection * 20 + Up * 10, Arrow.Color, SDPG_World, 2.0f);
                     PDI->DrawLine(Arrow.End, Arrow.End - ArrowDirection * 20 - Up * 10, Arrow.Color, SDPG_World, 2.0f);
                 }
+
+                for (const FWindDebugArrow& Segment : StreamlineSegments)
+                {
+                    PDI->DrawLine(Segment.Start, Segment.End, Segment.Color, SDPG_World, 1.0f);
+                }
             }
         }
     }
@@ -63,6 +69,7 @@ public:
 
 private:
     TArray<FWindDebugArrow> DebugArrows;
+    TArray<FWindDebugArrow> StreamlineSegments;
 };
 
 UWindDebugVisualizer::UWindDebugVisualizer()
@@ -104,6 +111,11 @@ FBoxSphereBounds UWindDebugVisualizer::CalcBounds(const FTransform& LocalToWorld
         BoundingBox += Arrow.Start;
         BoundingBox += Arrow.End;
     }
+    for (const FWindDebugArrow& Segment : StreamlineSegments)
+    {
+        BoundingBox += Segment.Start;
+        BoundingBox += Segment.End;
+    }
     return FBoxSphereBounds(BoundingBox);
 }
 
@@ -146,5 +158,53 @@ void UWindDebugVisualizer::UpdateDebugArrows()
         }
     }
 
+    UpdateStreamlines(*WindSubsystem);
     MarkRenderStateDirty();
 }
+
+void UWindDebugVisualizer::UpdateStreamlines(const UWindSimulationSubsystem& WindSubsystem)
+{
+    StreamlineSegments.Reset();
+    if (!bDrawStreamlines || StreamlineSeedResolution <= 0)
+    {
+        return;
+    }
+
+    // Seeds at the centres of a coarser copy of the arrow grid, all traced in one pass
+    const FVector Origin = GetComponentLocation();
+    const FVector SeedSpacing = VisualizationExtent / StreamlineSeedResolution;
+    TArray<FVector> Seeds;
+    for (int32 x = 0; x < StreamlineSeedResolution; ++x)
+    {
+        for (int32 y = 0; y < StreamlineSeedResolution; ++y)
+        {
+            for (int32 z = 0; z < StreamlineSeedResolution; ++z)
+            {
+                Seeds.Add(Origin - VisualizationExtent * 0.5f + (FVector(x, y, z) + 0.5f) * SeedSpacing);
+            }
+        }
+    }
+
+    const int32 NumPoints = StreamlineSettings.GetNumPoints();
+    TArray<FVector> Points;
+    Points.SetNumUninitialized(Seeds.Num() * NumPoints);
+    WindSubsystem.TraceWindStreamlines(Seeds, StreamlineSettings, Points);
+
+    // Colour each segment by the speed it was covered at
+    const float StepTime = FMath::Max(StreamlineSettings.StepTime, KINDA_SMALL_NUMBER);
+    for (int32 Seed = 0; Seed < Seeds.Num(); ++Seed)
+    {
+        for (int32 Point = 1; Point < NumPoints; ++Point)
+        {
+            FWindDebugArrow Segment;
+            Segment.Start = Points[Seed * NumPoints + Point - 1];
+            Segment.End = Points[Seed * NumPoints + Point];
+            if (Segment.Start.Equals(Segment.End))
+            {
+                continue;
+            }
+            Segment.Color = FColor::MakeRedToGreenColorFromScalar(FVector::Dist(Segment.Start, Segment.End) / StepTime / 100.0f);
+            StreamlineSegments.Add(Segment);
+        }
+    }
+}
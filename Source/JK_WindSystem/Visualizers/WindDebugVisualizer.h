@@ -3,9 +3,11 @@
 #include "CoreMinimal.h"
 #include "Components/PrimitiveComponent.h"
 #include "WindSystemComponent.h"
+#include "WindStreamlines.h"
 #include "WindDebugVisualizer.generated.h"
 
 class FWindDebugSceneProxy;
+class UWindSimulationSubsystem;
 
 USTRUCT()
 struct FWindDebugArrow
@@ -38,12 +40,25 @@ public:
     UPROPERTY(EditAnywhere, Category = "Debug")
     int32 GridResolution = 10;
 
+    // Streamlines traced from a grid of seeds across the visualization extent
+    UPROPERTY(EditAnywhere, Category = "Debug")
+    bool bDrawStreamlines = false;
+
+    UPROPERTY(EditAnywhere, Category = "Debug", meta = (EditCondition = "bDrawStreamlines", ClampMin = "1"))
+    int32 StreamlineSeedResolution = 4;
+
+    UPROPERTY(EditAnywhere, Category = "Debug", meta = (EditCondition = "bDrawStreamlines"))
+    FWindTraceSettings StreamlineSettings;
+
     void SetVisualizationExtent(const FVector& Extent);
 private:
     TArray<FWindDebugArrow> DebugArrows;
+    // Streamline segments, drawn without arrowheads
+    TArray<FWindDebugArrow> StreamlineSegments;
     float TimeSinceLastUpdate = 0.0f;
 
     void UpdateDebugArrows();
+    void UpdateStreamlines(const UWindSimulationSubsystem& WindSubsystem);
 
     FVector VisualizationExtent;
     
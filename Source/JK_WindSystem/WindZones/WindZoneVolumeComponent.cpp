@@ -18,6 +18,8 @@ void UWindZoneVolumeComponent::BeginPlay()
         if (WindSubsystem)
         {
             WindSubsystem->RegisterWindZone(this);
+            // Keeps the subsystem's zone index in step with moving zones
+            TransformUpdated.AddUObject(this, &UWindZoneVolumeComponent::OnZoneTransformUpdated);
         }
     }
 }
@@ -26,6 +28,7 @@ void UWindZoneVolumeComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
     if (WindSubsystem)
     {
+        TransformUpdated.RemoveAll(this);
         WindSubsystem->UnregisterWindZone(this);
     }
     Super::EndPlay(EndPlayReason);
@@ -41,6 +44,94 @@ bool UWindZoneVolumeComponent::IsPointInside(const FVector& Point) const
         FMath::Abs(LocalPoint.Z) <= Extent.Z;
 }
 
+FBox UWindZoneVolumeComponent::GetZoneBounds() const
+{
+    return CalcBounds(GetComponentTransform()).GetBox();
+}
+
+FWindZoneModifier UWindZoneVolumeComponent::GetZoneModifier() const
+{
+    FWindZoneModifier Modifier;
+    switch (ModifierType)
+    {
+        case EWindZoneType::FreezeSimulation:
+            Modifier.VelocityMap = FMatrix(ForceInit);
+            Modifier.bBlocksFlow = true;
+            Modifier.bFreeze = true;
+            break;
+        case EWindZoneType::ZeroWind:
+            Modifier.VelocityMap = FMatrix(ForceInit);
+            Modifier.bBlocksFlow = true;
+            break;
+        case EWindZoneType::Redirection:
+            Modifier.VelocityMap = RedirectionTransform.ToMatrixWithScale().RemoveTranslation();
+            break;
+        default:
+            break;
+    }
+    return Modifier;
+}
+
+void UWindZoneVolumeComponent::OnZoneTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
+{
+    if (WindSubsystem)
+    {
+        WindSubsystem->UpdateWindZone(this);
+    }
+}
+
+void UWindZoneVolumeComponent::ModifyPoint(const FTransform& ZoneTransform, const FVector& Extent, const FBox& WorldBounds, const FVector& Location, FVector& InOutVelocity) const
+{
+    // Most points of a batch miss any one zone, which the world bounds reject cheaply
+    if (!WorldBounds.IsInsideOrOn(Location))
+    {
+        return;
+    }
+
+    const FVector LocalPoint = ZoneTransform.InverseTransformPosition(Location);
+    if (FMath::Abs(LocalPoint.X) > Extent.X || FMath::Abs(LocalPoint.Y) > Extent.Y || FMath::Abs(LocalPoint.Z) > Extent.Z)
+    {
+        return;
+    }
+
+    switch (ModifierType)
+    {
+        case EWindZoneType::FreezeSimulation:
+        case EWindZoneType::ZeroWind:
+            InOutVelocity = FVector::ZeroVector;
+            break;
+        case EWindZoneType::Redirection:
+            InOutVelocity = RedirectionTransform.TransformVector(InOutVelocity);
+            break;
+        default:
+            break;
+    }
+}
+
+void UWindZoneVolumeComponent::ModifyWindVelocities(TConstArrayView<FVector> Locations, TArrayView<FVector> InOutVelocities) const
+{
+    const FTransform& ZoneTransform = GetComponentTransform();
+    const FVector Extent = GetUnscaledBoxExtent();
+    const FBox WorldBounds = Bounds.GetBox();
+
+    for (int32 Index = 0; Index < Locations.Num(); Index++)
+    {
+        ModifyPoint(ZoneTransform, Extent, WorldBounds, Locations[Index], InOutVelocities[Index]);
+    }
+}
+
+void UWindZoneVolumeComponent::ModifyWindVelocities(TConstArrayView<int32> Indices, TConstArrayView<FVector> Locations, TArrayView<FVector> InOutVelocities) const
+{
+    const FTransform& ZoneTransform = GetComponentTransform();
+    const FVector Extent = GetUnscaledBoxExtent();
+    const FBox WorldBounds = Bounds.GetBox();
+
+    for (const int32 Index : Indices)
+    {
+        ModifyPoint(ZoneTransform, Extent, WorldBounds, Locations[Index], InOutVelocities[Index]);
+    }
+}
+
 FVector UWindZoneVolumeComponent::ModifyWindVelocity(const FVector& OriginalVelocity, const FVector& Location) const
 {
     if (!IsPointInside(Location))
@@ -2,6 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "Components/BoxComponent.h"
+#include "WindZoneMask.h"
 #include "WindZoneVolumeComponent.generated.h"
 
 UENUM(BlueprintType)
@@ -32,10 +33,23 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Wind Modifier")
     bool IsPointInside(const FVector& Point) const;
 
+    // ModifyWindVelocity over a batch
+    void ModifyWindVelocities(TConstArrayView<FVector> Locations, TArrayView<FVector> InOutVelocities) const;
+    // ModifyWindVelocity for the given entries of a batch only
+    void ModifyWindVelocities(TConstArrayView<int32> Indices, TConstArrayView<FVector> Locations, TArrayView<FVector> InOutVelocities) const;
+
+    // World box the zone's volume fits in, as indexed by the subsystem
+    FBox GetZoneBounds() const;
+    // The zone's effect as voxelized into the simulation's zone mask
+    FWindZoneModifier GetZoneModifier() const;
+
 protected:
     virtual void BeginPlay() override;
     virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 private:
     class UWindSimulationSubsystem* WindSubsystem;
+
+    void OnZoneTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport);
+    FORCEINLINE void ModifyPoint(const FTransform& ZoneTransform, const FVector& Extent, const FBox& WorldBounds, const FVector& Location, FVector& InOutVelocity) const;
 };
\ No newline at end of file
@@ -26,6 +26,7 @@ void FWindSystemDebugRenderer::DrawDebug(UCanvas* Canvas, APlayerController* PC)
     DrawWindSystemInfo(Canvas, WindSystem);
     DrawWindSourcesList(Canvas, WindSystem);
     DrawWindVectorGrid(Canvas, WindSystem);
+    DrawWindStreamlines(Canvas, WindSystem);
 }
 
 void FWindSystemDebugRenderer::DrawDebugHeader(UCanvas* Canvas, APlayerController* PC)
@@ -128,6 +129,54 @@ void FWindSystemDebugRenderer::DrawWindVectorGrid(UCanvas* Canvas, UWindSimulati
     }
 }
 
+void FWindSystemDebugRenderer::DrawWindStreamlines(UCanvas* Canvas, UWindSimulationSubsystem* WindSystem)
+{
+    APawn* PlayerPawn = Cast<APawn>(WindSystem->GetWorld()->GetFirstPlayerController()->GetPawn());
+    APlayerController* PC = WindSystem->GetWorld()->GetFirstPlayerController();
+    if (!PlayerPawn || !PC)
+    {
+        return;
+    }
+
+    // Seeds on a horizontal grid through the player, all traced in one pass
+    FVector PlayerLocation = PlayerPawn->GetActorLocation();
+    float CellSize = WindSystem->GetWindSystemActor()->WindSimulationComponent->GetCellSize();
+    TArray<FVector> Seeds;
+    for (int32 x = -GridVisualizationSize; x <= GridVisualizationSize; x += StreamlineSeedSpacing)
+    {
+        for (int32 y = -GridVisualizationSize; y <= GridVisualizationSize; y += StreamlineSeedSpacing)
+        {
+            Seeds.Add(PlayerLocation + FVector(x, y, 0) * CellSize);
+        }
+    }
+
+    FWindTraceSettings Settings;
+    Settings.Integrator = EWindTraceIntegrator::RK2;
+    Settings.NumSteps = StreamlineSteps;
+    Settings.StepTime = StreamlineStepTime;
+
+    const int32 NumPoints = Settings.GetNumPoints();
+    TArray<FVector> Points;
+    Points.SetNumUninitialized(Seeds.Num() * NumPoints);
+    WindSystem->TraceWindStreamlines(Seeds, Settings, Points);
+
+    for (int32 Seed = 0; Seed < Seeds.Num(); Seed++)
+    {
+        for (int32 Point = 1; Point < NumPoints; Point++)
+        {
+            const FVector& Start = Points[Seed * NumPoints + Point - 1];
+            const FVector& End = Points[Seed * NumPoints + Point];
+
+            FVector2D ScreenStart;
+            FVector2D ScreenEnd;
+            if (PC->ProjectWorldLocationToScreen(Start, ScreenStart) && PC->ProjectWorldLocationToScreen(End, ScreenEnd))
+            {
+                Canvas->K2_DrawLine(ScreenStart, ScreenEnd, 1.0f, GetWindSpeedColor(FVector::Dist(Start, End) / StreamlineStepTime));
+            }
+        }
+    }
+}
+
 void FWindSystemDebugRenderer::DrawWindGeneratorDebug(UCanvas* Canvas, UWindGeneratorComponent* WindSource)
 {
     // Draw influence radius
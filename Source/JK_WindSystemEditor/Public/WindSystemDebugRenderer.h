@@ -29,6 +29,7 @@ private:
 	static void DrawWindSystemInfo(UCanvas* Canvas, UWindSimulationSubsystem* WindSystem);
 	static void DrawWindSourcesList(UCanvas* Canvas, UWindSimulationSubsystem* WindSystem);
 	static void DrawWindVectorGrid(UCanvas* Canvas, UWindSimulationSubsystem* WindSystem);
+	static void DrawWindStreamlines(UCanvas* Canvas, UWindSimulationSubsystem* WindSystem);
 	static void DrawWindGeneratorDebug(UCanvas* Canvas, UWindGeneratorComponent* WindSource);
 	static float DrawDebugString(UCanvas* Canvas, const FDebugText& DebugText);
 
@@ -43,4 +44,7 @@ private:
 	static constexpr float MaxWindSpeed = 1000.0f; // For color normalization
 	static constexpr int32 GridVisualizationSize = 5; // Number of cells to visualize in each direction
 	static constexpr float ArrowScale = 0.5f;
+	static constexpr int32 StreamlineSeedSpacing = 2; // Cells between streamline seeds around the player
+	static constexpr int32 StreamlineSteps = 20;
+	static constexpr float StreamlineStepTime = 0.1f;
 };
\ No newline at end of file
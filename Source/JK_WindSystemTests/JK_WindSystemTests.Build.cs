@@ -8,7 +8,8 @@ public class JK_WindSystemTests : ModuleRules
 		PrivateIncludePaths.AddRange(
 			new string[] {
 				"JK_WindSystem/WindGenerators",
-				"JK_WindSystem/Visualizers"
+				"JK_WindSystem/Visualizers",
+				"JK_WindSystem/Solvers"
 				// ... add other private include paths required here ...
 			}
         );
@@ -1,5 +1,6 @@
 #include "WindSystemTestCommon.h"
 #include "Math/UnrealMathUtility.h"
+#include "WindForcingGrid.h"
 
 #if WITH_DEV_AUTOMATION_TESTS
 
@@ -7,6 +8,7 @@ IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPointWindGeneratorTest, "JK_WindSystem.Generat
 IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDirectionalWindGeneratorTest, "JK_WindSystem.Generators.DirectionalWindGenerator", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
 IMPLEMENT_SIMPLE_AUTOMATION_TEST(FVortexWindGeneratorTest, "JK_WindSystem.Generators.VortexWindGenerator", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
 IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSplineWindGeneratorTest, "JK_WindSystem.Generators.SplineWindGenerator", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWindGeneratorRasterizationTest, "JK_WindSystem.Generators.Rasterization", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
 IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWindGeneratorSimulationIntegrationTest, "JK_WindSystem.Integration.GeneratorToSimulation", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
 
 bool FPointWindGeneratorTest::RunTest(const FString& Parameters)
@@ -161,6 +163,73 @@ bool FSplineWindGeneratorTest::RunTest(const FString& Parameters)
     return true;
 }
 
+bool FWindGeneratorRasterizationTest::RunTest(const FString& Parameters)
+{
+    UWorld* TestWorld = CreateTestWorld();
+
+    const FVector CellSpacing(100.0f);
+    const FIntVector Dimensions(32, 32, 16);
+    const FVector Origin(-1600.0f, -1600.0f, -800.0f);
+    UPointWindGeneratorComponent* WindGenerator = CreatePointWindGenerator(TestWorld, FVector(30.0f, -20.0f, 10.0f), WindTestConstants::DEFAULT_WIND_STRENGTH, WindTestConstants::DEFAULT_WIND_RADIUS);
+
+    FWindForcingGrid First;
+    FWindForcingGrid Second;
+    First.Initialize(Origin, Dimensions, CellSpacing);
+    Second.Initialize(Origin, Dimensions, CellSpacing);
+    WindGenerator->RasterizeWind(First);
+    WindGenerator->RasterizeWind(Second);
+
+    TestFalse("The generator writes forcing", First.IsEmpty());
+    TestTrue("Rasterizing twice gives identical forcing", First.GetVelocity() == Second.GetVelocity());
+
+    // Only nodes the bounds touch are visited
+    FIntVector NodeMin;
+    FIntVector NodeMax;
+    TestTrue("The generator bounds overlap the grid", First.GetNodeRange(WindGenerator->GetWindBounds(), NodeMin, NodeMax));
+    TestTrue("Writes stay inside the bounds",
+        First.GetDirtyMin().X >= NodeMin.X && First.GetDirtyMin().Y >= NodeMin.Y && First.GetDirtyMin().Z >= NodeMin.Z &&
+        First.GetDirtyMax().X <= NodeMax.X && First.GetDirtyMax().Y <= NodeMax.Y && First.GetDirtyMax().Z <= NodeMax.Z);
+
+    // A generator spanning many cells is sampled once per node
+    bool bMatchesNodes = true;
+    for (int32 Z = NodeMin.Z; Z <= NodeMax.Z; Z++)
+    {
+        for (int32 Y = NodeMin.Y; Y <= NodeMax.Y; Y++)
+        {
+            for (int32 X = NodeMin.X; X <= NodeMax.X; X++)
+            {
+                const FVector Expected = WindGenerator->GetWindVelocityAtLocation(First.GetNodePosition(X, Y, Z));
+                bMatchesNodes &= First.GetVelocity()[First.GetIndex(X, Y, Z)].Equals(Expected, 0.001f);
+            }
+        }
+    }
+    TestTrue("Node values are the generator evaluated at the node", bMatchesNodes);
+
+    // A generator smaller than a cell sits between nodes and is splatted onto them
+    WindGenerator->Radius = 40.0f;
+    WindGenerator->SetWorldLocation(FVector(50.0f, 50.0f, 50.0f));
+    First.Reset();
+    TestTrue("Reset clears the forcing", First.IsEmpty());
+    WindGenerator->RasterizeWind(First);
+    TestFalse("A sub-cell generator still reaches the grid", First.IsEmpty());
+
+    FVector Total = FVector::ZeroVector;
+    for (const FVector& Value : First.GetVelocity())
+    {
+        Total += Value;
+    }
+    TestTrue("Sub-cell forcing is finite", !Total.ContainsNaN());
+
+    // Accumulating merges two grids with the same layout
+    Second.Accumulate(First);
+    TestTrue("Accumulate widens the written range", Second.GetDirtyMin().X <= First.GetDirtyMin().X && Second.GetDirtyMax().X >= First.GetDirtyMax().X);
+
+    TestWorld->DestroyActor(WindGenerator->GetOwner());
+    DestroyTestWorld(TestWorld);
+
+    return true;
+}
+
 bool FWindGeneratorSimulationIntegrationTest::RunTest(const FString& Parameters)
 {
     UWorld* TestWorld = CreateTestWorld();
@@ -1,10 +1,46 @@
 #include "WindSystemTestCommon.h"
+#include "WindLayeredSolver.h"
+#include "WindSolverBackend.h"
+#include "WindSimulationScheduler.h"
+#include "WindSnapshot.h"
+#include "WindTileGraph.h"
+#include "WindInjectionQueue.h"
+#include "WindWorkerPool.h"
+#include "WindZoneIndex.h"
+#include "WindZoneMask.h"
+#include "WindVelocityDerivatives.h"
+#include "WindStreamlines.h"
+#include "WindQueryView.h"
+#include "Tasks/Task.h"
+#include "HAL/PlatformProcess.h"
 
 #if WITH_DEV_AUTOMATION_TESTS
 
 IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWindSystemComponentInitializationTest, "JK_WindSystem.Component.Initialization", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
 IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWindSystemComponentVelocityTest, "JK_WindSystem.Component.VelocityCalculation", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
 IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWindSystemComponentSimulationStepTest, "JK_WindSystem.Component.SimulationStep", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWindTurbulenceFieldTest, "JK_WindSystem.Component.TurbulenceField", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWindLayeredSolverTest, "JK_WindSystem.Component.LayeredSolver", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWindSolverBackendTest, "JK_WindSystem.Component.SolverBackends", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWindSpongeBoundaryTest, "JK_WindSystem.Component.SpongeBoundaries", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWindSimulationSchedulerTest, "JK_WindSystem.Component.Scheduler", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWindSnapshotChannelTest, "JK_WindSystem.Component.SnapshotChannel", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWindTimeSlicedStepTest, "JK_WindSystem.Component.TimeSlicedStep", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWindTemporalSamplingTest, "JK_WindSystem.Component.TemporalSampling", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWindTileGraphTest, "JK_WindSystem.Component.TileGraph", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWindInjectionQueueTest, "JK_WindSystem.Component.InjectionQueue", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWindPipelinedSchedulerTest, "JK_WindSystem.Component.PipelinedScheduler", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWindWorkerPoolTest, "JK_WindSystem.Component.WorkerPool", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWindBatchedQueryTest, "JK_WindSystem.Component.BatchedQueries", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWindQueryHandleTest, "JK_WindSystem.Component.QueryHandles", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWindZoneIndexTest, "JK_WindSystem.Component.ZoneIndex", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWindZoneMaskTest, "JK_WindSystem.Component.ZoneMask", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWindFrozenZoneTest, "JK_WindSystem.Component.FrozenZones", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWindMipPyramidTest, "JK_WindSystem.Component.MipPyramid", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWindBoxAverageTest, "JK_WindSystem.Component.BoxAverage", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWindDerivativeQueryTest, "JK_WindSystem.Component.DerivativeQueries", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWindStreamlineTest, "JK_WindSystem.Component.Streamlines", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWindQueryViewTest, "JK_WindSystem.Component.QueryView", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
 
 bool FWindSystemComponentInitializationTest::RunTest(const FString& Parameters)
 {
@@ -133,4 +169,1417 @@ bool FWindSystemComponentSimulationStepTest::RunTest(const FString& Parameters)
     return true;
 }
 
+bool FWindTurbulenceFieldTest::RunTest(const FString& Parameters)
+{
+    FWindTurbulenceField TurbulenceField;
+    TestFalse("Uninitialized field reports not initialized", TurbulenceField.IsInitialized());
+    TestTrue("Uninitialized field samples zero", TurbulenceField.Sample(FVector(0.3f)).IsZero());
+
+    TurbulenceField.Initialize(32, 8, 1337);
+    TestTrue("Field is initialized", TurbulenceField.IsInitialized());
+
+    // The volume must tile seamlessly so it can be repeated across the whole domain
+    const FVector SamplePoints[] = { FVector(0.1f, 0.2f, 0.3f), FVector(0.77f, 0.05f, 0.5f), FVector(0.99f, 0.99f, 0.01f) };
+    double SumSquared = 0.0;
+    for (const FVector& Point : SamplePoints)
+    {
+        FVector Value = TurbulenceField.Sample(Point);
+        FVector Wrapped = TurbulenceField.Sample(Point + FVector(1.0f, -2.0f, 3.0f));
+        TestTrue(FString::Printf(TEXT("Noise tiles at %s"), *Point.ToString()), Value.Equals(Wrapped, 0.001f));
+        TestFalse("Noise is finite", Value.ContainsNaN());
+        SumSquared += Value.SizeSquared();
+    }
+    TestTrue("Noise is not degenerate", SumSquared > 0.0);
+
+    // Same seed gives the same field
+    FWindTurbulenceField OtherField;
+    OtherField.Initialize(32, 8, 1337);
+    TestTrue("Noise is deterministic", OtherField.Sample(SamplePoints[0]).Equals(TurbulenceField.Sample(SamplePoints[0]), 0.0001f));
+
+    return true;
+}
+
+bool FWindLayeredSolverTest::RunTest(const FString& Parameters)
+{
+    FWindLayeredSolver Solver;
+    TestFalse("Uninitialized solver reports not initialized", Solver.IsInitialized());
+
+    FWindSolverConfig Config;
+    Config.GridSize = 32;
+    Config.CellSize = 100.0f;
+    Config.NumBands = 4;
+    Config.BandHeight = 200.0f;
+    Config.VerticalExchange = 2.0f;
+    Config.MaxVelocity = 1000.0f;
+    Solver.Initialize(Config);
+    TestTrue("Solver is initialized", Solver.IsInitialized());
+    TestTrue("Dimensions cover the bands", Solver.GetDimensions() == FIntVector(32, 32, 4));
+
+    // Inject a horizontal gust into the lowest band
+    const FVector Source(16.0f * Config.CellSize, 16.0f * Config.CellSize, 0.0f);
+    TestTrue("Injection inside the domain succeeds", Solver.AddVelocity(Source, FVector(500.0f, 0.0f, 300.0f)));
+    TestFalse("Injection outside the domain is rejected", Solver.AddVelocity(FVector(-Config.CellSize, 0.0f, 0.0f), FVector(500.0f, 0.0f, 0.0f)));
+
+    const FVector Injected = Solver.SampleVelocity(Source);
+    TestTrue("Injected wind is stored", Injected.X > 0.0f);
+    TestEqual("Layered wind has no vertical component", Injected.Z, 0.0);
+
+    for (int32 i = 0; i < 30; ++i)
+    {
+        Solver.Step(1.0f / 60.0f);
+    }
+
+    const FVector Ground = Solver.SampleVelocity(Source);
+    const FVector Above = Solver.SampleVelocity(Source + FVector(0.0f, 0.0f, Config.BandHeight));
+    TestFalse("Layered wind stays finite", Ground.ContainsNaN() || Above.ContainsNaN());
+    TestTrue("Vertical exchange carries wind into the next band", Above.SizeSquared() > 0.0);
+
+    // Solid cells are held at rest
+    TestTrue("Solid cell inside the domain is accepted", Solver.SetSolid(Source, true));
+    TestTrue("Solid cell has no wind", Solver.SampleVelocity(Source).IsNearlyZero());
+
+    // Shifting by whole bands moves the contents upwards
+    Solver.SetSolid(Source, false);
+    Solver.AddVelocity(Source, FVector(0.0f, 400.0f, 0.0f));
+    const FVector BeforeShift = Solver.SampleVelocity(Source);
+    Solver.Shift(FIntVector(0, 0, 1));
+    TestTrue("Shift moves band contents", Solver.SampleVelocity(Source + FVector(0.0f, 0.0f, Config.BandHeight)).Equals(BeforeShift, 0.001f));
+
+    return true;
+}
+
+bool FWindSolverBackendTest::RunTest(const FString& Parameters)
+{
+    // Every backend honours the same contract without a world or component
+    const EWindSolverBackend Backends[] = { EWindSolverBackend::StableFluids, EWindSolverBackend::LatticeBoltzmann, EWindSolverBackend::Layered };
+
+    for (EWindSolverBackend Backend : Backends)
+    {
+        TSharedPtr<IWindSolverBackend> Solver = WindSolverBackend::Create(Backend);
+        if (!TestTrue(TEXT("Backend is created"), Solver.IsValid()))
+        {
+            continue;
+        }
+
+        const FString Name = Solver->GetName();
+        TestFalse(FString::Printf(TEXT("%s starts uninitialized"), *Name), Solver->IsInitialized());
+
+        FWindSolverConfig Config;
+        Config.GridSize = 16;
+        Config.CellSize = 100.0f;
+        Config.NumBands = 4;
+        Config.BandHeight = 100.0f;
+        Solver->Initialize(Config);
+        TestTrue(FString::Printf(TEXT("%s is initialized"), *Name), Solver->IsInitialized());
+
+        const FVector Centre = FVector(Solver->GetDimensions()) * Solver->GetCellSpacing() * 0.5f;
+        TestTrue(FString::Printf(TEXT("%s accepts injection inside the domain"), *Name), Solver->AddVelocity(Centre, FVector(200.0f, 0.0f, 0.0f)));
+        TestFalse(FString::Printf(TEXT("%s rejects injection outside the domain"), *Name), Solver->AddVelocity(FVector(-1000.0f), FVector(200.0f, 0.0f, 0.0f)));
+        TestTrue(FString::Printf(TEXT("%s stores injected wind"), *Name), Solver->SampleVelocity(Centre).X > 0.0f);
+
+        for (int32 i = 0; i < 10; ++i)
+        {
+            Solver->Step(1.0f / 60.0f);
+        }
+        TestFalse(FString::Printf(TEXT("%s stays finite"), *Name), Solver->SampleVelocity(Centre).ContainsNaN());
+
+        TArray<FVector> Exported;
+        Solver->ExportVelocity(Exported);
+        const FIntVector Dimensions = Solver->GetDimensions();
+        TestEqual(FString::Printf(TEXT("%s exports one velocity per cell"), *Name), Exported.Num(), Dimensions.X * Dimensions.Y * Dimensions.Z);
+
+        // Resizing keeps the wind that was already there
+        Solver->AddVelocity(Centre, FVector(200.0f, 0.0f, 0.0f));
+        Solver->Resize(24, 100.0f);
+        TestEqual(FString::Printf(TEXT("%s resizes"), *Name), Solver->GetDimensions().X, 24);
+        TestTrue(FString::Printf(TEXT("%s keeps wind across a resize"), *Name), Solver->SampleVelocity(Centre).X > 0.0f);
+    }
+
+    return true;
+}
+
+bool FWindSpongeBoundaryTest::RunTest(const FString& Parameters)
+{
+    const EWindSolverBackend Backends[] = { EWindSolverBackend::StableFluids, EWindSolverBackend::LatticeBoltzmann, EWindSolverBackend::Layered };
+    const FVector AmbientWind(300.0f, 0.0f, 0.0f);
+
+    for (EWindSolverBackend Backend : Backends)
+    {
+        for (bool bSponge : { false, true })
+        {
+            TSharedPtr<IWindSolverBackend> Solver = WindSolverBackend::Create(Backend);
+
+            FWindSolverConfig Config;
+            Config.GridSize = 16;
+            Config.CellSize = 100.0f;
+            Config.NumBands = 4;
+            Config.BandHeight = 100.0f;
+            Config.SpongeWidth = bSponge ? 4 : 0;
+            Config.SpongeStrength = 10.0f;
+            Config.bOpenBoundaries = bSponge;
+            Solver->Initialize(Config);
+            Solver->SetAmbientWind(AmbientWind);
+
+            for (int32 i = 0; i < 60; ++i)
+            {
+                Solver->Step(1.0f / 60.0f);
+            }
+
+            // Probe just inside the upwind face, half way across the other axes
+            const FVector Spacing = Solver->GetCellSpacing();
+            const FVector Probe = FVector(1.0f, 8.0f, Solver->GetDimensions().Z * 0.5f) * Spacing;
+            const FVector Velocity = Solver->SampleVelocity(Probe);
+            const FString Name = Solver->GetName();
+
+            TestFalse(FString::Printf(TEXT("%s stays finite"), *Name), Velocity.ContainsNaN());
+            if (bSponge)
+            {
+                TestTrue(FString::Printf(TEXT("%s pulls the upwind face toward the ambient wind"), *Name), Velocity.X > 0.5f * AmbientWind.X);
+            }
+            else
+            {
+                TestTrue(FString::Printf(TEXT("%s leaves a closed domain at rest"), *Name), Velocity.Size() < 0.1f * AmbientWind.X);
+            }
+        }
+    }
+
+    return true;
+}
+
+bool FWindSimulationSchedulerTest::RunTest(const FString& Parameters)
+{
+    const float FixedStep = 1.0f / 60.0f;
+    int32 NumStepFunctionCalls = 0;
+    bool bStepTimeIsFixed = true;
+
+    FWindSimulationScheduler Scheduler;
+    Scheduler.Configure(EWindSchedulerMode::GameThread, FixedStep, [&](float StepTime)
+    {
+        NumStepFunctionCalls++;
+        bStepTimeIsFixed &= FMath::IsNearlyEqual(StepTime, FixedStep);
+    });
+    Scheduler.Start();
+    TestFalse("Game thread mode does not start a thread", Scheduler.IsThreadRunning());
+
+    // One second of frames at the simulation rate steps exactly once per frame
+    for (int32 Frame = 0; Frame < 60; Frame++)
+    {
+        Scheduler.Advance(FixedStep, false);
+    }
+    TestEqual("One step per frame at the simulation rate", NumStepFunctionCalls, 60);
+
+    // Paused frames neither step nor bank time for later
+    for (int32 Frame = 0; Frame < 30; Frame++)
+    {
+        Scheduler.Advance(FixedStep, true);
+    }
+    TestEqual("No steps while paused", NumStepFunctionCalls, 60);
+    Scheduler.Advance(0.0f, false);
+    TestEqual("Paused time is not caught up", NumStepFunctionCalls, 60);
+
+    // Slow frames run several fixed steps, fast frames accumulate
+    Scheduler.Advance(FixedStep * 2.0f, false);
+    TestEqual("A double-length frame runs two steps", NumStepFunctionCalls, 62);
+    Scheduler.Advance(FixedStep * 0.5f, false);
+    TestEqual("A half-length frame runs no step", NumStepFunctionCalls, 62);
+    Scheduler.Advance(FixedStep * 0.5f, false);
+    TestEqual("The remainder carries over to the next frame", NumStepFunctionCalls, 63);
+
+    // A long hitch is capped instead of stalling the frame with dozens of steps
+    Scheduler.Advance(1.0f, false);
+    const FWindSchedulerStats Stats = Scheduler.GetStats();
+    TestTrue("A hitch runs a bounded number of steps", NumStepFunctionCalls - 63 < 10);
+    TestTrue("Dropped steps are counted", Stats.NumDroppedSteps > 0);
+    TestEqual("Every executed step is counted", Stats.NumSteps, NumStepFunctionCalls);
+    TestTrue("Steps always advance by the fixed period", bStepTimeIsFixed);
+
+    Scheduler.Shutdown();
+    return true;
+}
+
+bool FWindPipelinedSchedulerTest::RunTest(const FString& Parameters)
+{
+    const float FixedStep = 1.0f / 60.0f;
+    std::atomic<bool> bReleaseStep(false);
+    std::atomic<int32> NumSteps(0);
+    std::atomic<int32> NumSealsSeenByStep(0);
+    int32 NumSeals = 0;
+
+    // Steps block until released, standing in for a solve that outlasts the frame
+    FWindSimulationScheduler Scheduler;
+    Scheduler.Configure(EWindSchedulerMode::Pipelined, FixedStep, [&](float)
+    {
+        NumSealsSeenByStep = NumSeals;
+        while (!bReleaseStep)
+        {
+            FPlatformProcess::YieldThread();
+        }
+        NumSteps++;
+    });
+    Scheduler.ConfigurePipeline([&]() { NumSeals++; });
+
+    auto WaitForStep = [&Scheduler]()
+    {
+        const double Deadline = FPlatformTime::Seconds() + 5.0;
+        while (Scheduler.IsStepInFlight() && FPlatformTime::Seconds() < Deadline)
+        {
+            FPlatformProcess::YieldThread();
+        }
+    };
+
+    Scheduler.Advance(FixedStep, false);
+    TestEqual("Inputs are sealed when a step launches", NumSeals, 1);
+    TestTrue("Advance returns while the step is still solving", Scheduler.IsStepInFlight());
+    TestEqual("The step runs on the shared worker pool", FWindWorkerPool::Get().GetNumDomains(), 1);
+
+    // The next frame gathers while step N runs and does not seal into it
+    Scheduler.Advance(FixedStep, false);
+    TestEqual("No inputs are sealed while a step is in flight", NumSeals, 1);
+
+    bReleaseStep = true;
+    WaitForStep();
+    TestEqual("The step completes in the background", NumSteps.load(), 1);
+    TestEqual("The step ran on the inputs sealed before it", NumSealsSeenByStep.load(), 1);
+
+    // The time banked while step N ran launches step N+1 with the inputs gathered meanwhile
+    Scheduler.Advance(0.0f, false);
+    TestEqual("The next step seals the inputs gathered meanwhile", NumSeals, 2);
+    WaitForStep();
+    TestEqual("Banked time is stepped", NumSteps.load(), 2);
+
+    Scheduler.Shutdown();
+    TestEqual("Shutdown leaves the worker pool", FWindWorkerPool::Get().GetNumDomains(), 0);
+    return true;
+}
+
+bool FWindWorkerPoolTest::RunTest(const FString& Parameters)
+{
+    FWindWorkerPool& Pool = FWindWorkerPool::Get();
+    if (!TestEqual("No other simulation is using the pool", Pool.GetNumDomains(), 0))
+    {
+        return false;
+    }
+
+    UWindSystemSettings* WindSettings = GetMutableDefault<UWindSystemSettings>();
+    const int32 OriginalThreads = WindSettings->SimulationWorkerThreads;
+    WindSettings->SimulationWorkerThreads = 2;
+
+    // Six domains at 60 Hz whose steps each cost at least a millisecond, one of them limited to
+    // 3% of a worker, which covers at most a step every 33 ms rather than every 16.7 ms
+    const float FixedStep = 1.0f / 60.0f;
+    const int32 NumDomains = 6;
+    TArray<TUniquePtr<FWindSimulationScheduler>> Schedulers;
+    TArray<TUniquePtr<std::atomic<int32>>> StepCounts;
+    std::atomic<int32> NumConcurrent(0);
+    std::atomic<int32> MaxConcurrent(0);
+    for (int32 Index = 0; Index < NumDomains; Index++)
+    {
+        std::atomic<int32>* StepCount = StepCounts.Add_GetRef(MakeUnique<std::atomic<int32>>(0)).Get();
+        TUniquePtr<FWindSimulationScheduler>& Scheduler = Schedulers.Add_GetRef(MakeUnique<FWindSimulationScheduler>());
+        Scheduler->Configure(EWindSchedulerMode::DedicatedThread, FixedStep, [StepCount, &NumConcurrent, &MaxConcurrent](float)
+        {
+            const int32 Concurrent = ++NumConcurrent;
+            int32 Observed = MaxConcurrent.load();
+            while (Concurrent > Observed && !MaxConcurrent.compare_exchange_weak(Observed, Concurrent))
+            {
+            }
+            FPlatformProcess::Sleep(0.001f);
+            --NumConcurrent;
+            ++(*StepCount);
+        });
+        Scheduler->ConfigurePool(Index, Index == 0 ? 0.03f : 0.0f);
+        Scheduler->Start();
+    }
+
+    TestEqual("Every domain joins the shared pool", Pool.GetNumDomains(), NumDomains);
+    TestEqual("The pool has the configured number of threads however many domains exist", Pool.GetNumWorkers(), 2);
+
+    FPlatformProcess::Sleep(1.0f);
+    for (TUniquePtr<FWindSimulationScheduler>& Scheduler : Schedulers)
+    {
+        Scheduler->Shutdown();
+    }
+
+    TestTrue("Steps never run on more threads than the pool has", MaxConcurrent.load() <= 2);
+    for (int32 Index = 1; Index < NumDomains; Index++)
+    {
+        TestTrue(FString::Printf(TEXT("Domain %d steps at its rate"), Index), StepCounts[Index]->load() > 45);
+    }
+    TestTrue("The budgeted domain is held below its rate", StepCounts[0]->load() < StepCounts[1]->load());
+    TestTrue("Steps skipped for budget are counted as dropped", Schedulers[0]->GetStats().NumDroppedSteps > 0);
+    TestEqual("The pool stops its threads with the last domain", Pool.GetNumWorkers(), 0);
+
+    WindSettings->SimulationWorkerThreads = OriginalThreads;
+    return true;
+}
+
+bool FWindBatchedQueryTest::RunTest(const FString& Parameters)
+{
+    UWorld* TestWorld = CreateTestWorld();
+    UWindSimulationComponent* WindComponent = SetupWindSimulation(TestWorld);
+    if (!TestNotNull("WindComponent is valid", WindComponent))
+    {
+        DestroyTestWorld(TestWorld);
+        return false;
+    }
+
+    const FVector Extent = FVector(WindComponent->GetGridSize() * WindComponent->GetCellSize());
+    FRandomStream Random(42);
+    for (int32 i = 0; i < 50; ++i)
+    {
+        WindComponent->AddWindAtLocation(FVector(Random.FRandRange(0.0f, Extent.X), Random.FRandRange(0.0f, Extent.Y), Random.FRandRange(0.0f, Extent.Z)), Random.VRand() * 300.0f);
+    }
+    for (int32 i = 0; i < 3; ++i)
+    {
+        WindComponent->SimulationStep(WindTestConstants::DEFAULT_SIMULATION_DELTA_TIME);
+    }
+
+    // Small batches run inline, large ones are split across workers; both must match the
+    // single-point query, including points outside the grid
+    for (int32 NumPoints : { 1000, 20000 })
+    {
+        TArray<FVector> Locations;
+        for (int32 i = 0; i < NumPoints; ++i)
+        {
+            Locations.Add(FVector(Random.FRandRange(-0.2f, 1.2f) * Extent.X, Random.FRandRange(-0.2f, 1.2f) * Extent.Y, Random.FRandRange(-0.2f, 1.2f) * Extent.Z));
+        }
+
+        TArray<FVector> Batched;
+        Batched.SetNumUninitialized(NumPoints);
+        WindComponent->GetWindVelocitiesAtLocations(Locations, Batched);
+
+        double MaxDifference = 0.0;
+        for (int32 i = 0; i < NumPoints; ++i)
+        {
+            MaxDifference = FMath::Max(MaxDifference, (Batched[i] - WindComponent->GetWindVelocityAtLocation(Locations[i])).Size());
+        }
+        TestTrue(FString::Printf(TEXT("A batch of %d matches single queries"), NumPoints), MaxDifference < 0.01);
+    }
+
+    TestWorld->DestroyActor(WindComponent->GetOwner());
+    DestroyTestWorld(TestWorld);
+    return true;
+}
+
+bool FWindQueryHandleTest::RunTest(const FString& Parameters)
+{
+    UWorld* TestWorld = CreateTestWorld();
+    UWindSimulationSubsystem* WindSubsystem = TestWorld->GetSubsystem<UWindSimulationSubsystem>();
+    if (!TestNotNull("Wind Subsystem exists", WindSubsystem))
+    {
+        DestroyTestWorld(TestWorld);
+        return false;
+    }
+    // Ticking spawns the subsystem's simulation
+    WindSubsystem->Tick(WindTestConstants::DEFAULT_SIMULATION_DELTA_TIME);
+
+    const FVector FixedLocation(100.0f, 200.0f, 50.0f);
+    FVector MovingLocation(-300.0f, 0.0f, 100.0f);
+    FWindQueryHandle Fixed = WindSubsystem->RegisterWindQuery([FixedLocation]() { return FixedLocation; });
+    FWindQueryHandle Moving = WindSubsystem->RegisterWindQuery([&MovingLocation]() { return MovingLocation; });
+    TestTrue("Handles are valid", WindSubsystem->IsWindQueryValid(Fixed) && WindSubsystem->IsWindQueryValid(Moving));
+    TestEqual("Both queries are registered", WindSubsystem->GetNumWindQueries(), 2);
+
+    for (int32 i = 0; i < 5; ++i)
+    {
+        WindSubsystem->AddWindAtLocation(FixedLocation, FVector(500.0f, 0.0f, 0.0f));
+        MovingLocation += FVector(40.0f, 0.0f, 0.0f);
+        WindSubsystem->Tick(WindTestConstants::DEFAULT_SIMULATION_DELTA_TIME);
+
+        // Nothing publishes between the resolve and these queries, so they read the same snapshot
+        TestTrue("Fixed query matches a direct query", WindSubsystem->GetQueriedWindVelocity(Fixed).Equals(WindSubsystem->GetWindVelocityAtLocation(FixedLocation), 0.01));
+        TestTrue("Moving query follows its provider", WindSubsystem->GetQueriedWindVelocity(Moving).Equals(WindSubsystem->GetWindVelocityAtLocation(MovingLocation), 0.01));
+    }
+
+    // A reused slot must not answer for the handle it replaced
+    const FWindQueryHandle Stale = Fixed;
+    WindSubsystem->UnregisterWindQuery(Fixed);
+    TestFalse("Unregistering invalidates the handle", Fixed.IsValid());
+    FWindQueryHandle Replacement = WindSubsystem->RegisterWindQuery([]() { return FVector::ZeroVector; });
+    TestEqual("The freed slot is reused", Replacement.Index, Stale.Index);
+    TestFalse("The stale handle is rejected", WindSubsystem->IsWindQueryValid(Stale));
+    TestTrue("The stale handle reads zero", WindSubsystem->GetQueriedWindVelocity(Stale).IsZero());
+    TestTrue("The handle reaches its subsystem", Replacement.Subsystem.Get() == WindSubsystem);
+
+    // Providers may register and unregister queries while the resolve runs
+    TArray<FWindQueryHandle> Spawned;
+    FWindQueryHandle Spawner = WindSubsystem->RegisterWindQuery([WindSubsystem, &Spawned]()
+    {
+        for (int32 i = 0; i < 32; ++i)
+        {
+            Spawned.Add(WindSubsystem->RegisterWindQuery([]() { return FVector::ZeroVector; }));
+        }
+        return FVector::ZeroVector;
+    });
+    FWindQueryHandle SelfRemoving;
+    SelfRemoving = WindSubsystem->RegisterWindQuery([WindSubsystem, &SelfRemoving]()
+    {
+        WindSubsystem->UnregisterWindQuery(SelfRemoving);
+        return FVector::ZeroVector;
+    });
+    WindSubsystem->Tick(WindTestConstants::DEFAULT_SIMULATION_DELTA_TIME);
+    TestFalse("A provider can unregister its own query", SelfRemoving.IsValid());
+    TestTrue("A provider can register queries", Spawned.Num() >= 32 && WindSubsystem->IsWindQueryValid(Spawner));
+    WindSubsystem->UnregisterWindQuery(Spawner);
+    for (FWindQueryHandle& Handle : Spawned)
+    {
+        WindSubsystem->UnregisterWindQuery(Handle);
+    }
+
+    WindSubsystem->UnregisterWindQuery(Replacement);
+    WindSubsystem->UnregisterWindQuery(Moving);
+    TestEqual("No queries remain", WindSubsystem->GetNumWindQueries(), 0);
+
+    DestroyTestWorld(TestWorld);
+    return true;
+}
+
+bool FWindZoneIndexTest::RunTest(const FString& Parameters)
+{
+    FWindZoneIndex Index(1000.0f);
+    TArray<int32, TInlineAllocator<16>> Candidates;
+
+    // Two overlapping zones, one far away and one too large to hash
+    Index.Update(0, FBox(FVector(0.0f), FVector(1500.0f)));
+    Index.Update(1, FBox(FVector(1000.0f), FVector(2500.0f)));
+    Index.Update(2, FBox(FVector(50000.0f), FVector(50500.0f)));
+    Index.Update(3, FBox(FVector(-100000.0f), FVector(100000.0f)));
+    TestEqual("Every zone is indexed", Index.Num(), 4);
+
+    Index.Query(FVector(1200.0f), Candidates);
+    TestTrue("Overlapping zones come back in id order", Candidates.Num() == 3 && Candidates[0] == 0 && Candidates[1] == 1 && Candidates[2] == 3);
+
+    Index.Query(FVector(200.0f), Candidates);
+    TestTrue("Only zones containing the point are returned", Candidates.Num() == 2 && Candidates[0] == 0 && Candidates[1] == 3);
+
+    Index.Query(FVector(50200.0f), Candidates);
+    TestTrue("A distant zone is found", Candidates.Num() == 2 && Candidates[0] == 2);
+
+    // Moving a zone takes it out of the cells it left
+    Index.Update(0, FBox(FVector(20000.0f), FVector(20500.0f)));
+    Index.Query(FVector(200.0f), Candidates);
+    TestTrue("A moved zone leaves its old cells", Candidates.Num() == 1 && Candidates[0] == 3);
+    Index.Query(FVector(20200.0f), Candidates);
+    TestTrue("A moved zone is found at its new place", Candidates.Num() == 2 && Candidates[0] == 0);
+    TestEqual("Moving keeps the count", Index.Num(), 4);
+
+    // An invalid box removes the zone
+    Index.Update(3, FBox(ForceInit));
+    TestEqual("Removing drops the count", Index.Num(), 3);
+
+    // Every point of a batch is visited once, together with the candidates of its cell
+    TArray<FVector> Points = { FVector(1200.0f), FVector(200000.0f), FVector(1100.0f), FVector(20100.0f) };
+    TArray<int32> VisitCount;
+    VisitCount.SetNumZeroed(Points.Num());
+    bool bCandidatesCovered = true;
+    Index.ForEachCell(Points, [&](TConstArrayView<int32> PointIndices, TConstArrayView<int32> CandidateIds)
+    {
+        for (const int32 PointIndex : PointIndices)
+        {
+            VisitCount[PointIndex]++;
+            TArray<int32, TInlineAllocator<16>> Exact;
+            Index.Query(Points[PointIndex], Exact);
+            for (const int32 Id : Exact)
+            {
+                bCandidatesCovered &= CandidateIds.Contains(Id);
+            }
+        }
+    });
+    TestTrue("Points inside a zone are visited once", VisitCount[0] == 1 && VisitCount[2] == 1 && VisitCount[3] == 1);
+    TestEqual("Points outside every zone's cells are skipped", VisitCount[1], 0);
+    TestTrue("Cell candidates include every zone containing the point", bCandidatesCovered);
+
+    Index.Reset();
+    Index.Query(FVector(1200.0f), Candidates);
+    TestTrue("Reset empties the index", Index.Num() == 0 && Candidates.Num() == 0);
+    return true;
+}
+
+bool FWindZoneMaskTest::RunTest(const FString& Parameters)
+{
+    FWindZoneMask Mask;
+    Mask.Initialize(FVector::ZeroVector, FIntVector(16), FVector(100.0f));
+    TestTrue("A new mask is empty", Mask.IsValid() && Mask.IsEmpty());
+
+    // A still-air box over nodes 2-5 and a redirection turning +X into +Y over nodes 4-10, whose
+    // faces pass through nodes 4 and 10
+    FWindZoneModifier Still;
+    Still.VelocityMap = FMatrix(ForceInit);
+    Still.bBlocksFlow = true;
+    FWindZoneModifier Turn;
+    Turn.VelocityMap = FRotationMatrix(FRotator(0.0f, 90.0f, 0.0f));
+    Mask.AddZone(FTransform(FVector(350.0f)), FVector(200.0f), Still);
+    Mask.AddZone(FTransform(FVector(700.0f)), FVector(300.0f), Turn);
+    Mask.Finalize();
+    TestFalse("Zones cover nodes", Mask.IsEmpty());
+
+    // Zones that stop the flow are applied by the solver alone, the rest by queries alone
+    const FVector Wind(100.0f, 0.0f, 0.0f);
+    const int32 StillCell = Mask.GetCellAt(FVector(300.0f));
+    const int32 TurnCell = Mask.GetCellAt(FVector(800.0f));
+    TestTrue("Solvers hold still cells at rest", Mask.IsCellBlocked(StillCell));
+    TestTrue("Queries leave still cells to the solver", Mask.Apply(FVector(300.0f), Wind).Equals(Wind));
+    TestFalse("Solvers leave redirection to queries", Mask.IsCellBlocked(TurnCell));
+    TestTrue("Redirection turns the wind", Mask.Apply(FVector(800.0f), Wind).Equals(FVector(0.0f, 100.0f, 0.0f), 1e-2));
+    TestTrue("Overlapping zones compose", Mask.IsCellBlocked(Mask.GetCellAt(FVector(500.0f))));
+    TestTrue("Wind outside the zones is unchanged", Mask.Apply(FVector(1300.0f), Wind).Equals(Wind));
+    TestTrue("Wind outside the grid is unchanged", Mask.Apply(FVector(-500.0f), Wind).Equals(Wind));
+
+    // A still slab a fifth of a cell thick is too thin for the solver to block a cell with, so
+    // queries scale the wind through it down by its coverage instead of ignoring it
+    FWindZoneMask Slab;
+    Slab.Initialize(FVector::ZeroVector, FIntVector(16), FVector(100.0f));
+    Slab.AddZone(FTransform(FVector(1000.0f, 800.0f, 800.0f)), FVector(10.0f, 400.0f, 400.0f), Still);
+    Slab.Finalize();
+    const int32 SlabCell = Slab.GetCellAt(FVector(1000.0f, 800.0f, 800.0f));
+    TestTrue("A zone thinner than a cell still covers it", SlabCell != INDEX_NONE && Slab.GetWeight(SlabCell) > 0.0f && Slab.GetWeight(SlabCell) < 0.5f);
+    TestFalse("Solvers do not block a thinly covered cell", Slab.IsCellBlocked(SlabCell));
+    TestTrue("Queries attenuate the wind through it", Slab.Apply(FVector(1000.0f, 800.0f, 800.0f), Wind).Equals(Wind * (1.0f - Slab.GetWeight(SlabCell)), 1e-3));
+
+    // A node on the zone's face is half covered
+    const int32 EdgeCell = Mask.GetCellAt(FVector(1000.0f, 700.0f, 700.0f));
+    TestTrue("Partly covered cells get a partial weight", Mask.GetWeight(EdgeCell) > 0.0f && Mask.GetWeight(EdgeCell) < 1.0f);
+
+    TestTrue("The mask lines up with its own layout", Mask.IsAlignedWith(FVector::ZeroVector, FIntVector(16), FVector(100.0f)));
+    TestFalse("A moved grid no longer lines up", Mask.IsAlignedWith(FVector(100.0f, 0.0f, 0.0f), FIntVector(16), FVector(100.0f)));
+
+    // A grid moved by whole cells takes the mask along instead of dropping it
+    FIntVector CellOffset;
+    TestFalse("A move by part of a cell cannot be shifted onto", Mask.GetShiftTo(FVector(150.0f, 0.0f, 0.0f), FIntVector(16), FVector(100.0f), CellOffset));
+    TestTrue("A move by whole cells can", Mask.GetShiftTo(FVector(200.0f, 0.0f, 0.0f), FIntVector(16), FVector(100.0f), CellOffset));
+    FWindZoneMask Moved = Mask;
+    Moved.Shift(CellOffset);
+    TestTrue("The shifted mask lines up with the moved grid", Moved.IsAlignedWith(FVector(200.0f, 0.0f, 0.0f), FIntVector(16), FVector(100.0f)));
+    TestTrue("Still air stays where it is in the world", Moved.IsCellBlocked(Moved.GetCellAt(FVector(300.0f))));
+    TestTrue("So does the redirection", Moved.Apply(FVector(800.0f), Wind).Equals(FVector(0.0f, 100.0f, 0.0f), 1e-2));
+
+    // Inside a solver the still box stays calm while wind is pushed through it
+    TSharedPtr<IWindSolverBackend> Solver = WindSolverBackend::Create(EWindSolverBackend::StableFluids);
+    FWindSolverConfig Config;
+    Config.GridSize = 16;
+    Config.CellSize = 100.0f;
+    Solver->Initialize(Config);
+    FWindZoneMask StillOnly;
+    StillOnly.Initialize(FVector::ZeroVector, Solver->GetDimensions(), Solver->GetCellSpacing());
+    StillOnly.AddZone(FTransform(FVector(800.0f)), FVector(250.0f), Still);
+    StillOnly.Finalize();
+    Solver->SetZoneMask(MakeShared<FWindZoneMask>(StillOnly));
+    for (int32 i = 0; i < 10; ++i)
+    {
+        Solver->AddVelocity(FVector(300.0f, 800.0f, 800.0f), FVector(500.0f, 0.0f, 0.0f));
+        Solver->Step(1.0f / 60.0f);
+    }
+    TArray<FVector> Exported;
+    Solver->ExportVelocity(Exported);
+    TestTrue("The solver holds the zone at rest", Exported[StillOnly.GetIndex(8, 8, 8)].IsNearlyZero(1e-3));
+    TestFalse("Wind still flows outside the zone", Exported[StillOnly.GetIndex(3, 8, 8)].IsNearlyZero(1e-3));
+    return true;
+}
+
+bool FWindFrozenZoneTest::RunTest(const FString& Parameters)
+{
+    FWindZoneModifier Freeze;
+    Freeze.VelocityMap = FMatrix(ForceInit);
+    Freeze.bBlocksFlow = true;
+    Freeze.bFreeze = true;
+
+    // The upper half of every backend's domain is frozen while wind is driven through the lower
+    // half, where a frozen pillar covers part of each row it crosses. Sponge layers pulling toward
+    // an ambient wind must not reach into the frozen cells.
+    const EWindSolverBackend Backends[] = { EWindSolverBackend::StableFluids, EWindSolverBackend::LatticeBoltzmann, EWindSolverBackend::Layered };
+    for (EWindSolverBackend Backend : Backends)
+    {
+        TSharedPtr<IWindSolverBackend> Solver = WindSolverBackend::Create(Backend);
+        FWindSolverConfig Config;
+        Config.GridSize = 16;
+        Config.CellSize = 100.0f;
+        Config.NumBands = 4;
+        Config.BandHeight = 100.0f;
+        Config.TileSize = FIntVector(8, 8, 4);
+        Config.SpongeWidth = 3;
+        Solver->Initialize(Config);
+        Solver->SetAmbientWind(FVector(200.0f, 0.0f, 0.0f));
+        const FString Name = Solver->GetName();
+
+        const FIntVector Dimensions = Solver->GetDimensions();
+        const FVector Spacing = Solver->GetCellSpacing();
+        const FVector Extent = FVector(Dimensions) * Spacing;
+        const FVector FrozenCentre(Extent.X * 0.5f, Extent.Y * 0.5f, Extent.Z * 0.75f);
+
+        TSharedPtr<FWindZoneMask> Mask = MakeShared<FWindZoneMask>();
+        Mask->Initialize(FVector::ZeroVector, Dimensions, Spacing);
+        Mask->AddZone(FTransform(FrozenCentre), FVector(Extent.X, Extent.Y, Extent.Z * 0.25f), Freeze);
+        const FVector PillarCentre(Extent.X * 0.25f, Extent.Y * 0.5f, Extent.Z * 0.25f);
+        Mask->AddZone(FTransform(PillarCentre), FVector(Spacing.X * 2.0f, Extent.Y, Extent.Z * 0.25f), Freeze);
+        Mask->Finalize();
+        TestTrue(FString::Printf(TEXT("%s: the mask freezes cells"), *Name), Mask->HasFrozen());
+        TestTrue(FString::Printf(TEXT("%s: the upper half is frozen as a region"), *Name), Mask->IsRegionFrozen(FIntVector(0, 0, Dimensions.Z / 2), Dimensions));
+        TestFalse(FString::Printf(TEXT("%s: the lower half is not"), *Name), Mask->IsRegionFrozen(FIntVector::ZeroValue, FIntVector(Dimensions.X, Dimensions.Y, Dimensions.Z / 2)));
+        const int32 PillarRow = Dimensions.Y / 2;
+        TestTrue(FString::Printf(TEXT("%s: the pillar freezes cells of a row"), *Name), Mask->IsCellFrozen(Mask->GetIndex(Dimensions.X / 4, PillarRow, 0)));
+        TestFalse(FString::Printf(TEXT("%s: but not the whole row"), *Name), Mask->IsRegionFrozen(FIntVector(0, PillarRow, 0), FIntVector(Dimensions.X, PillarRow + 1, 1)));
+        Solver->SetZoneMask(Mask);
+
+        const FVector Source(Extent.X * 0.5f, Extent.Y * 0.5f, Spacing.Z);
+        for (int32 i = 0; i < 10; ++i)
+        {
+            Solver->AddVelocity(Source, FVector(300.0f, 100.0f, 200.0f));
+            Solver->Step(1.0f / 60.0f);
+        }
+
+        TArray<FVector> Exported;
+        Solver->ExportVelocity(Exported);
+        double MaxFrozen = 0.0;
+        double MaxLive = 0.0;
+        double MaxLiveInPillarRow = 0.0;
+        for (int32 Z = 0; Z < Dimensions.Z; Z++)
+        {
+            for (int32 Y = 0; Y < Dimensions.Y; Y++)
+            {
+                for (int32 X = 0; X < Dimensions.X; X++)
+                {
+                    const int32 Cell = Mask->GetIndex(X, Y, Z);
+                    const double Speed = Exported[Cell].Size();
+                    double& Max = Mask->IsCellFrozen(Cell) ? MaxFrozen : MaxLive;
+                    Max = FMath::Max(Max, Speed);
+                    if (Y == PillarRow && Z < Dimensions.Z / 2 && !Mask->IsCellFrozen(Cell))
+                    {
+                        MaxLiveInPillarRow = FMath::Max(MaxLiveInPillarRow, Speed);
+                    }
+                }
+            }
+        }
+        TestTrue(FString::Printf(TEXT("%s: frozen cells stay at rest"), *Name), MaxFrozen < 1e-3);
+        TestTrue(FString::Printf(TEXT("%s: the rest keeps simulating"), *Name), MaxLive > 1e-3);
+        TestTrue(FString::Printf(TEXT("%s: cells beside the pillar keep simulating"), *Name), MaxLiveInPillarRow > 1e-3);
+    }
+    return true;
+}
+
+bool FWindMipPyramidTest::RunTest(const FString& Parameters)
+{
+    // A linear field survives box filtering exactly at the filtered node positions, so every level
+    // must reproduce it inside the grid
+    const double Spacing = 100.0;
+    FWindSnapshot Snapshot;
+    Snapshot.Origin = FVector(1000.0, -500.0, 0.0);
+    Snapshot.Dimensions = FIntVector(8, 8, 4);
+    Snapshot.CellSpacing = FVector(Spacing);
+    Snapshot.Velocity.SetNumUninitialized(8 * 8 * 4);
+    FVector Mean = FVector::ZeroVector;
+    for (int32 Z = 0; Z < 4; Z++)
+    {
+        for (int32 Y = 0; Y < 8; Y++)
+        {
+            for (int32 X = 0; X < 8; X++)
+            {
+                Snapshot.Velocity[Snapshot.GetIndex(X, Y, Z)] = FVector(X, 2.0 * Y, 0.0);
+                Mean += FVector(X, 2.0 * Y, 0.0) / Snapshot.Velocity.Num();
+            }
+        }
+    }
+    Snapshot.BuildMipLevels();
+
+    TestEqual("8x8x4 has four levels down to one node", Snapshot.GetNumMipLevels(), 4);
+    TestTrue("Level 1 halves every axis", Snapshot.MipLevels[0].Dimensions == FIntVector(4, 4, 2));
+    TestEqual("Level 1 doubles the spacing", Snapshot.MipLevels[0].CellSpacing.X, 2.0 * Spacing);
+    TestEqual("Level 1 nodes sit between the nodes they average", Snapshot.MipLevels[0].Offset.X, 0.5 * Spacing);
+    TestTrue("The top level is a single node", Snapshot.MipLevels.Last().Dimensions == FIntVector(1, 1, 1));
+    TestTrue("The top level is the mean of the field", Snapshot.MipLevels.Last().Velocity[0].Equals(Mean, 1e-6));
+
+    const FVector Position = Snapshot.Origin + FVector(3.2, 2.7, 1.0) * Spacing;
+    const FVector Expected(3.2, 5.4, 0.0);
+    const float Lods[] = { 0.0f, 1.0f, 1.5f, 2.0f };
+    for (float Lod : Lods)
+    {
+        TestTrue(FString::Printf(TEXT("Lod %.1f reproduces a linear field"), Lod), Snapshot.SampleBlendedVelocityLod(Position, Lod, 1.0f).Equals(Expected, 1e-4));
+    }
+    TestTrue("Lod 0 matches the full-resolution query", Snapshot.SampleBlendedVelocityLod(Position, 0.0f, 1.0f).Equals(Snapshot.SampleBlendedVelocity(Position, 1.0f), 1e-6));
+    TestTrue("Lods past the pyramid read the top level", Snapshot.SampleBlendedVelocityLod(Position, 10.0f, 1.0f).Equals(Mean, 1e-6));
+
+    TestEqual("Footprints up to one cell read level 0", Snapshot.GetLodForFootprint(100.0f), 0.0f);
+    TestEqual("Each doubling of the footprint is one level", Snapshot.GetLodForFootprint(400.0f), 2.0f, 1e-4f);
+    TestEqual("Huge footprints clamp to the top level", Snapshot.GetLodForFootprint(1e9f), 3.0f);
+
+    // Batched and single queries agree
+    TArray<FVector> Positions = { Position, Snapshot.Origin, Snapshot.Origin + FVector(7.0, 7.0, 3.0) * Spacing };
+    TArray<FVector> Velocities;
+    Velocities.SetNumUninitialized(Positions.Num());
+    Snapshot.SampleBlendedVelocitiesLod(Positions, Velocities, 1.3f, 1.0f);
+    for (int32 Index = 0; Index < Positions.Num(); Index++)
+    {
+        TestTrue("Batched lod query matches the single query", Velocities[Index].Equals(Snapshot.SampleBlendedVelocityLod(Positions[Index], 1.3f, 1.0f), 1e-9));
+    }
+
+    return true;
+}
+
+bool FWindBoxAverageTest::RunTest(const FString& Parameters)
+{
+    // Odd, unequal dimensions so every axis of the prefix sum is exercised on its own
+    const double Spacing = 50.0;
+    FWindSnapshot Snapshot;
+    Snapshot.Origin = FVector(-300.0, 200.0, 100.0);
+    Snapshot.Dimensions = FIntVector(7, 5, 6);
+    Snapshot.CellSpacing = FVector(Spacing);
+    FRandomStream Random(47);
+    Snapshot.Velocity.SetNumUninitialized(7 * 5 * 6);
+    for (FVector& Velocity : Snapshot.Velocity)
+    {
+        Velocity = FVector(Random.FRandRange(-100.0f, 100.0f), Random.FRandRange(-100.0f, 100.0f), Random.FRandRange(-100.0f, 100.0f));
+    }
+    Snapshot.BuildVelocitySums();
+    TestTrue("The table is one larger than the grid on each axis", Snapshot.HasVelocitySums());
+
+    auto BruteForce = [&Snapshot](const FIntVector& Begin, const FIntVector& End)
+    {
+        FVector Sum = FVector::ZeroVector;
+        for (int32 Z = Begin.Z; Z < End.Z; Z++)
+        {
+            for (int32 Y = Begin.Y; Y < End.Y; Y++)
+            {
+                for (int32 X = Begin.X; X < End.X; X++)
+                {
+                    Sum += Snapshot.Velocity[Snapshot.GetIndex(X, Y, Z)];
+                }
+            }
+        }
+        return Sum / ((End.X - Begin.X) * (End.Y - Begin.Y) * (End.Z - Begin.Z));
+    };
+    // World box over the cells Begin to End, pulled slightly inside so it has to be rounded
+    auto CellBox = [&Snapshot, Spacing](const FIntVector& Begin, const FIntVector& End)
+    {
+        return FBox(Snapshot.Origin + (FVector(Begin) - 0.4) * Spacing, Snapshot.Origin + (FVector(End) - 0.6) * Spacing);
+    };
+
+    const FIntVector Ranges[][2] = {
+        { FIntVector(0, 0, 0), FIntVector(7, 5, 6) },
+        { FIntVector(1, 0, 2), FIntVector(5, 3, 6) },
+        { FIntVector(6, 4, 5), FIntVector(7, 5, 6) },
+        { FIntVector(2, 1, 0), FIntVector(3, 4, 1) },
+    };
+    for (const FIntVector* Range : Ranges)
+    {
+        TestTrue(FString::Printf(TEXT("Box over %s to %s matches the brute-force mean"), *Range[0].ToString(), *Range[1].ToString()),
+            Snapshot.GetBlendedAverageVelocity(CellBox(Range[0], Range[1]), 1.0f).Equals(BruteForce(Range[0], Range[1]), 1e-6));
+    }
+
+    const FVector Node = Snapshot.Origin + FVector(3.0, 2.0, 4.0) * Spacing;
+    TestTrue("A box inside one cell reads that node", Snapshot.GetBlendedAverageVelocity(FBox(Node - 5.0, Node + 5.0), 1.0f).Equals(Snapshot.Velocity[Snapshot.GetIndex(3, 2, 4)], 1e-6));
+    TestTrue("Boxes are clamped to the grid", Snapshot.GetBlendedAverageVelocity(FBox(Snapshot.Origin - 1e5, Snapshot.Origin + 1e5), 1.0f).Equals(BruteForce(FIntVector(0, 0, 0), FIntVector(7, 5, 6)), 1e-6));
+    TestTrue("Invalid boxes return zero", Snapshot.GetBlendedAverageVelocity(FBox(ForceInit), 1.0f).IsZero());
+
+    return true;
+}
+
+bool FWindDerivativeQueryTest::RunTest(const FString& Parameters)
+{
+    // Trilinear interpolation reproduces an affine field exactly, so the stencil derivatives must
+    // return its matrix everywhere, including past the edge of the grid
+    const double Spacing = 100.0;
+    FWindSnapshot Snapshot;
+    Snapshot.Origin = FVector(500.0, 0.0, -200.0);
+    Snapshot.Dimensions = FIntVector(6, 5, 4);
+    Snapshot.CellSpacing = FVector(Spacing, Spacing, 2.0 * Spacing);
+
+    const FMatrix Gradient(
+        FPlane(0.10, 0.20, 0.00, 0.0),
+        FPlane(-0.30, 0.00, 0.05, 0.0),
+        FPlane(0.00, 0.40, -0.10, 0.0),
+        FPlane(0.0, 0.0, 0.0, 1.0));
+    const FVector Offset(300.0, -50.0, 10.0);
+    auto Field = [&Gradient, &Offset](const FVector& Local)
+    {
+        return Offset + FVector(
+            Gradient.M[0][0] * Local.X + Gradient.M[0][1] * Local.Y + Gradient.M[0][2] * Local.Z,
+            Gradient.M[1][0] * Local.X + Gradient.M[1][1] * Local.Y + Gradient.M[1][2] * Local.Z,
+            Gradient.M[2][0] * Local.X + Gradient.M[2][1] * Local.Y + Gradient.M[2][2] * Local.Z);
+    };
+
+    Snapshot.Velocity.SetNumUninitialized(6 * 5 * 4);
+    for (int32 Z = 0; Z < 4; Z++)
+    {
+        for (int32 Y = 0; Y < 5; Y++)
+        {
+            for (int32 X = 0; X < 6; X++)
+            {
+                Snapshot.Velocity[Snapshot.GetIndex(X, Y, Z)] = Field(FVector(X, Y, Z) * Snapshot.CellSpacing);
+            }
+        }
+    }
+
+    const FVector Positions[] = {
+        Snapshot.Origin + FVector(230.0, 170.0, 310.0),
+        Snapshot.Origin + FVector(500.0, 400.0, 600.0),
+        Snapshot.Origin + FVector(0.0, 0.0, 0.0),
+    };
+    for (const FVector& Position : Positions)
+    {
+        const FWindVelocityDerivatives Derivatives = Snapshot.SampleBlendedDerivatives(Position, 1.0f);
+        TestTrue("Velocity matches the plain query", Derivatives.Velocity.Equals(Snapshot.SampleBlendedVelocity(Position, 1.0f), 1e-6));
+        TestTrue("Velocity matches the field", Derivatives.Velocity.Equals(Field(Position - Snapshot.Origin), 1e-6));
+        bool bJacobianMatches = true;
+        for (int32 Row = 0; Row < 3; Row++)
+        {
+            for (int32 Column = 0; Column < 3; Column++)
+            {
+                bJacobianMatches &= FMath::IsNearlyEqual(Derivatives.Jacobian.M[Row][Column], Gradient.M[Row][Column], 1e-9);
+            }
+        }
+        TestTrue("The Jacobian is the field's gradient", bJacobianMatches);
+        TestTrue("Curl comes from the Jacobian", Derivatives.Curl.Equals(FVector(0.40 - 0.05, 0.00 - 0.00, -0.30 - 0.20), 1e-9));
+        TestEqual("Divergence is the Jacobian's trace", Derivatives.Divergence, 0.0f, 1e-6f);
+    }
+
+    // A point outside the grid still differentiates the nearest edge cell
+    const FWindVelocityDerivatives Outside = Snapshot.SampleBlendedDerivatives(Snapshot.Origin + FVector(-1000.0, 9000.0, 50.0), 1.0f);
+    TestTrue("Derivatives outside the grid come from the edge cell", FMath::IsNearlyEqual(Outside.Jacobian.M[2][1], Gradient.M[2][1], 1e-9));
+
+    // Uniform wind has no shear, so no turbulence intensity
+    FWindSnapshot Uniform;
+    Uniform.Dimensions = FIntVector(4, 4, 4);
+    Uniform.CellSpacing = FVector(Spacing);
+    Uniform.Velocity.Init(FVector(500.0, 0.0, 0.0), 64);
+    const FWindVelocityDerivatives Calm = Uniform.SampleBlendedDerivatives(FVector(150.0), 1.0f);
+    TestEqual("Uniform wind has zero turbulence intensity", Calm.TurbulenceIntensity, 0.0f);
+    TestTrue("Uniform wind has zero curl", Calm.Curl.IsNearlyZero());
+
+    // Batched and single queries agree
+    TArray<FVector> Batch(Positions, UE_ARRAY_COUNT(Positions));
+    TArray<FWindVelocityDerivatives> BatchResults;
+    BatchResults.SetNum(Batch.Num());
+    Snapshot.SampleBlendedDerivatives(Batch, BatchResults, 1.0f);
+    for (int32 Index = 0; Index < Batch.Num(); Index++)
+    {
+        const FWindVelocityDerivatives Single = Snapshot.SampleBlendedDerivatives(Batch[Index], 1.0f);
+        TestTrue("Batched derivatives match single queries", BatchResults[Index].Velocity.Equals(Single.Velocity, 1e-9) && BatchResults[Index].Curl.Equals(Single.Curl, 1e-9)
+            && BatchResults[Index].TurbulenceIntensity == Single.TurbulenceIntensity);
+    }
+
+    return true;
+}
+
+bool FWindStreamlineTest::RunTest(const FString& Parameters)
+{
+    // Solid-body rotation about Z: every seed should come back to where it started after one
+    // revolution, and RK4 should land far closer than RK2
+    const double AngularSpeed = 2.0 * PI / 10.0;
+    auto Rotation = [AngularSpeed](TConstArrayView<FVector> Positions, TArrayView<FVector> OutVelocities)
+    {
+        for (int32 Index = 0; Index < Positions.Num(); Index++)
+        {
+            OutVelocities[Index] = FVector(-Positions[Index].Y, Positions[Index].X, 0.0) * AngularSpeed;
+        }
+    };
+
+    FWindTraceSettings Settings;
+    Settings.NumSteps = 40;
+    Settings.StepTime = 0.25f;
+    const int32 NumPoints = Settings.GetNumPoints();
+    TestEqual("One point per step plus the seed", NumPoints, 41);
+
+    TArray<FVector> Seeds = { FVector(1000.0, 0.0, 0.0), FVector(0.0, -500.0, 200.0) };
+    TArray<FVector> Points;
+    Points.SetNumUninitialized(Seeds.Num() * NumPoints);
+
+    double Errors[2];
+    const EWindTraceIntegrator Integrators[] = { EWindTraceIntegrator::RK2, EWindTraceIntegrator::RK4 };
+    for (int32 Method = 0; Method < 2; Method++)
+    {
+        Settings.Integrator = Integrators[Method];
+        FWindStreamlineTracer::Trace(Seeds, Settings, Rotation, Points);
+        TestTrue("Polylines start at their seeds", Points[0] == Seeds[0] && Points[NumPoints] == Seeds[1]);
+        TestEqual("Rotation keeps the height", Points[2 * NumPoints - 1].Z, 200.0, 1e-9);
+
+        Errors[Method] = FVector::Dist(Points[NumPoints - 1], Seeds[0]);
+        TestTrue("The seed returns close to its start after one revolution", Errors[Method] < 50.0);
+    }
+    TestTrue("RK4 is more accurate than RK2", Errors[1] < Errors[0] * 0.1);
+
+    // A uniform snapshot carries every seed in a straight line
+    FWindSnapshot Uniform;
+    Uniform.Dimensions = FIntVector(4, 4, 4);
+    Uniform.CellSpacing = FVector(1000.0);
+    Uniform.Velocity.Init(FVector(100.0, 50.0, 0.0), 64);
+    auto SampleUniform = [&Uniform](TConstArrayView<FVector> Positions, TArrayView<FVector> OutVelocities)
+    {
+        Uniform.SampleBlendedVelocities(Positions, OutVelocities, 1.0f);
+    };
+    Settings.Integrator = EWindTraceIntegrator::RK2;
+    FWindStreamlineTracer::Trace(Seeds, Settings, SampleUniform, Points);
+    TestTrue("Uniform wind drifts seeds in a straight line", Points[NumPoints - 1].Equals(Seeds[0] + FVector(100.0, 50.0, 0.0) * Settings.NumSteps * Settings.StepTime, 1e-6));
+
+    // Enough seeds to run in parallel chunks, each matching the same seed traced alone
+    TArray<FVector> ManySeeds;
+    for (int32 Index = 0; Index < 1000; Index++)
+    {
+        ManySeeds.Add(FVector(100.0 + Index, 0.5 * Index, 0.0));
+    }
+    Settings.Integrator = EWindTraceIntegrator::RK4;
+    TArray<FVector> ManyPoints;
+    ManyPoints.SetNumUninitialized(ManySeeds.Num() * NumPoints);
+    FWindStreamlineTracer::Trace(ManySeeds, Settings, Rotation, ManyPoints);
+
+    TArray<FVector> SinglePoints;
+    SinglePoints.SetNumUninitialized(NumPoints);
+    const int32 Probes[] = { 0, 255, 256, 999 };
+    for (int32 Probe : Probes)
+    {
+        FWindStreamlineTracer::Trace(MakeArrayView(&ManySeeds[Probe], 1), Settings, Rotation, SinglePoints);
+        TestTrue(FString::Printf(TEXT("Seed %d traced in a batch matches it traced alone"), Probe), ManyPoints[Probe * NumPoints + NumPoints - 1].Equals(SinglePoints.Last(), 1e-9));
+    }
+
+    TArray<FWindTracePolyline> Polylines;
+    FWindStreamlineTracer::ToPolylines(ManyPoints, NumPoints, Polylines);
+    TestTrue("One polyline per seed", Polylines.Num() == ManySeeds.Num() && Polylines[999].Points.Num() == NumPoints && Polylines[999].Points[0] == ManySeeds[999]);
+
+    return true;
+}
+
+bool FWindQueryViewTest::RunTest(const FString& Parameters)
+{
+    const FVector Wind(100.0, 0.0, 0.0);
+    TestTrue("An empty view returns no wind", FWindQueryView().GetWindVelocityAtLocation(FVector(100.0)).IsZero());
+
+    // Uniform wind over nodes 0-7, still air over node 1 and a redirection turning +X into +Y
+    // around node 3 inside the grid, and the same redirection around 2000 well outside it
+    FWindZoneModifier Still;
+    Still.VelocityMap = FMatrix(ForceInit);
+    Still.bBlocksFlow = true;
+    FWindZoneModifier Turn;
+    Turn.VelocityMap = FRotationMatrix(FRotator(0.0f, 90.0f, 0.0f));
+
+    TRefCountPtr<FWindSnapshot> Snapshot = new FWindSnapshot();
+    Snapshot->Dimensions = FIntVector(8);
+    Snapshot->CellSpacing = FVector(100.0);
+    Snapshot->Velocity.Init(Wind, 512);
+
+    TSharedPtr<FWindZoneMask> Zones = MakeShared<FWindZoneMask>();
+    Zones->Initialize(Snapshot->Origin, Snapshot->Dimensions, Snapshot->CellSpacing);
+    Zones->AddZone(FTransform(FVector(100.0)), FVector(50.0), Still);
+    Zones->AddZone(FTransform(FVector(300.0)), FVector(50.0), Turn);
+    Zones->AddZone(FTransform(FVector(2000.0, 0.0, 0.0)), FVector(200.0), Turn);
+    Zones->Finalize();
+    TestEqual("The mask keeps zones that miss the grid", Zones->GetNumZones(), 3);
+    Snapshot->ZoneMask = Zones;
+
+    FWindQueryView View(Snapshot, FWindQueryTurbulence(), EWindTemporalSampling::Latest);
+    View.SetOuterZones(Zones);
+    Snapshot.SafeRelease();
+    TestTrue("The view keeps the snapshot alive", View.IsValid() && View.GetSnapshot()->IsValid());
+
+    TestTrue("Zones inside the grid apply through the snapshot's mask", View.GetWindVelocityAtLocation(FVector(300.0)).Equals(FVector(0.0, 100.0, 0.0), 1e-3));
+    TestTrue("Still air inside the grid is left to the solver", View.GetWindVelocityAtLocation(FVector(100.0)).Equals(Wind, 1e-3));
+    TestTrue("Zones outside the grid apply exactly", View.GetWindVelocityAtLocation(FVector(2000.0, 0.0, 0.0)).Equals(FVector(0.0, 100.0, 0.0), 1e-3));
+    TestTrue("Wind clear of every zone is unchanged", View.GetWindVelocityAtLocation(FVector(600.0)).Equals(Wind, 1e-3));
+    TestTrue("Positions beside an outer zone are unchanged", View.GetWindVelocityAtLocation(FVector(2500.0, 0.0, 0.0)).Equals(Wind, 1e-3));
+
+    // Derivative and streamline queries agree with velocity queries off the grid too
+    const FVector OuterLocation(2000.0, 0.0, 0.0);
+    TestTrue("Derivative queries apply zones outside the grid", View.GetWindDerivativesAtLocation(OuterLocation).Velocity.Equals(FVector(0.0, 100.0, 0.0), 1e-3));
+    FWindTraceSettings TraceSettings;
+    TraceSettings.Integrator = EWindTraceIntegrator::RK2;
+    TraceSettings.NumSteps = 1;
+    TraceSettings.StepTime = 1.0f;
+    FVector TracePoints[2];
+    View.TraceWindStreamlines(MakeArrayView(&OuterLocation, 1), TraceSettings, MakeArrayView(TracePoints, 2));
+    TestTrue("Streamlines apply zones outside the grid", TracePoints[1].Equals(FVector(2000.0, 100.0, 0.0), 1e-3));
+
+    // Worker threads query copies of the view while the game thread holds the original
+    TArray<FVector> Locations;
+    for (int32 Index = 0; Index < 5000; Index++)
+    {
+        Locations.Add(FVector(-500.0 + Index, 0.3 * Index, 0.1 * Index));
+    }
+    TArray<FVector> Expected;
+    Expected.SetNumUninitialized(Locations.Num());
+    for (int32 Index = 0; Index < Locations.Num(); Index++)
+    {
+        Expected[Index] = View.GetWindVelocityAtLocation(Locations[Index]);
+    }
+
+    const int32 NumWorkers = 8;
+    TArray<TArray<FVector>> WorkerResults;
+    WorkerResults.SetNum(NumWorkers);
+    TArray<UE::Tasks::FTask> Tasks;
+    for (int32 Worker = 0; Worker < NumWorkers; Worker++)
+    {
+        Tasks.Add(UE::Tasks::Launch(UE_SOURCE_LOCATION, [View, &Locations, &Result = WorkerResults[Worker]]()
+        {
+            Result.SetNumUninitialized(Locations.Num());
+            View.GetWindVelocitiesAtLocations(Locations, Result);
+        }));
+    }
+    UE::Tasks::Wait(Tasks);
+
+    bool bWorkersMatch = true;
+    for (const TArray<FVector>& Result : WorkerResults)
+    {
+        for (int32 Index = 0; Index < Locations.Num(); Index++)
+        {
+            bWorkersMatch &= Result[Index].Equals(Expected[Index], 1e-6);
+        }
+    }
+    TestTrue("Batched queries on worker threads match the game thread", bWorkersMatch);
+    return true;
+}
+
+bool FWindSnapshotChannelTest::RunTest(const FString& Parameters)
+{
+    auto MakeUniformSnapshot = [](FWindSnapshotChannel& Channel, const FVector& Velocity)
+    {
+        TRefCountPtr<FWindSnapshot> Snapshot = Channel.BeginWrite();
+        Snapshot->Dimensions = FIntVector(4, 4, 4);
+        Snapshot->CellSpacing = FVector(100.0f);
+        Snapshot->Velocity.Init(Velocity, 64);
+        return Snapshot;
+    };
+
+    FWindSnapshotChannel Channel;
+    TestFalse("Nothing is published initially", Channel.Acquire().IsValid());
+
+    Channel.Publish(MakeUniformSnapshot(Channel, FVector(1.0f, 0.0f, 0.0f)));
+
+    // A reader keeps its snapshot unchanged while newer ones are published
+    TRefCountPtr<FWindSnapshot> Pinned = Channel.Acquire();
+    TRefCountPtr<FWindSnapshot> Second = MakeUniformSnapshot(Channel, FVector(2.0f, 0.0f, 0.0f));
+    FWindSnapshot* SecondBuffer = Second.GetReference();
+    Channel.Publish(MoveTemp(Second));
+    TestEqual("Pinned snapshot is immutable", Pinned->SampleVelocity(FVector(150.0f)).X, 1.0);
+    TestEqual("Readers see the latest snapshot", Channel.Acquire()->SampleVelocity(FVector(150.0f)).X, 2.0);
+    TestEqual("Positions outside the grid read the nearest edge", Channel.Acquire()->SampleVelocity(FVector(-1000.0f)).X, 2.0);
+    Pinned.SafeRelease();
+
+    // A snapshot nobody holds when it is replaced is reused for the next write instead of allocating
+    Channel.Publish(MakeUniformSnapshot(Channel, FVector(3.0f, 0.0f, 0.0f)));
+    TRefCountPtr<FWindSnapshot> Recycled = Channel.BeginWrite();
+    TestTrue("Retired snapshots are recycled", Recycled.GetReference() == SecondBuffer);
+
+    // Snapshots that blend against the one before share it instead of copying it, and the
+    // rotation still settles on three buffers rather than keeping every step alive
+    FWindSnapshotChannel History;
+    TSet<const FWindSnapshot*> Buffers;
+    for (int32 Step = 0; Step < 10; Step++)
+    {
+        const TRefCountPtr<FWindSnapshot> Latest = History.Acquire();
+        TRefCountPtr<FWindSnapshot> Snapshot = MakeUniformSnapshot(History, FVector(Step, 0.0, 0.0));
+        Snapshot->SetPrevious(Latest);
+        Buffers.Add(Snapshot.GetReference());
+        History.Publish(MoveTemp(Snapshot));
+    }
+    TestTrue("Blending against the previous step rotates three buffers", Buffers.Num() <= 3);
+
+    const TRefCountPtr<FWindSnapshot> Newest = History.Acquire();
+    const TRefCountPtr<FWindSnapshot> Spare = History.BeginWrite();
+    TestTrue("The newest snapshot blends against the step before it", Newest->HasPrevious() && Newest->GetPrevious()->Velocity[0].X == 8.0);
+    TestTrue("Older steps are not chained on once nobody reads them", Newest->GetPrevious()->GetPrevious() == nullptr);
+
+    return true;
+}
+
+bool FWindTimeSlicedStepTest::RunTest(const FString& Parameters)
+{
+    // A sliced step must land on the same state as a full step
+    FWindSolverConfig Config;
+    Config.GridSize = 16;
+    Config.CellSize = 100.0f;
+
+    TSharedPtr<IWindSolverBackend> FullSolver = WindSolverBackend::Create(EWindSolverBackend::StableFluids);
+    TSharedPtr<IWindSolverBackend> SlicedSolver = WindSolverBackend::Create(EWindSolverBackend::StableFluids);
+    FullSolver->Initialize(Config);
+    SlicedSolver->Initialize(Config);
+    for (const TSharedPtr<IWindSolverBackend>& Solver : { FullSolver, SlicedSolver })
+    {
+        Solver->AddVelocity(FVector(800.0f, 800.0f, 800.0f), FVector(200.0f, 50.0f, 0.0f));
+        Solver->AddVelocity(FVector(400.0f, 900.0f, 600.0f), FVector(0.0f, -100.0f, 80.0f));
+    }
+
+    FullSolver->Step(1.0f / 60.0f);
+
+    SlicedSolver->BeginStep(1.0f / 60.0f);
+    TestEqual("Progress starts at zero", SlicedSolver->GetStepProgress(), 0.0f);
+    int32 NumSlices = 0;
+    float LastProgress = 0.0f;
+    bool bProgressMonotonic = true;
+    while (!SlicedSolver->StepSlice() && NumSlices < 1000)
+    {
+        NumSlices++;
+        bProgressMonotonic &= SlicedSolver->GetStepProgress() > LastProgress;
+        LastProgress = SlicedSolver->GetStepProgress();
+    }
+    TestTrue("The step is split into several slices", NumSlices > 4);
+    TestTrue("Progress increases with every slice", bProgressMonotonic);
+    TestEqual("Progress is complete after the last slice", SlicedSolver->GetStepProgress(), 1.0f);
+
+    TArray<FVector> FullVelocity;
+    TArray<FVector> SlicedVelocity;
+    FullSolver->ExportVelocity(FullVelocity);
+    SlicedSolver->ExportVelocity(SlicedVelocity);
+
+    // The pressure relaxation runs its slabs in parallel in place, so results are only equal up to
+    // scheduling noise
+    double MaxDifference = 0.0;
+    double MaxSpeed = 0.0;
+    for (int32 i = 0; i < FullVelocity.Num(); i++)
+    {
+        MaxDifference = FMath::Max(MaxDifference, (FullVelocity[i] - SlicedVelocity[i]).Size());
+        MaxSpeed = FMath::Max(MaxSpeed, FullVelocity[i].Size());
+    }
+    TestTrue("Sliced and full steps agree", MaxDifference <= 0.01 * MaxSpeed + KINDA_SMALL_NUMBER);
+
+    // The scheduler spreads a step over the configured number of frames even with no budget
+    const int32 SlicesPerStep = 8;
+    int32 NumBegun = 0;
+    int32 SlicesRun = 0;
+    FWindSimulationScheduler Scheduler;
+    Scheduler.Configure(EWindSchedulerMode::TimeSliced, 1.0f / 15.0f, [](float) {});
+
+    FWindSlicedStepFunctions SlicedStep;
+    SlicedStep.BeginStep = [&](float) { NumBegun++; SlicesRun = 0; };
+    SlicedStep.StepSlice = [&]() { return ++SlicesRun >= SlicesPerStep; };
+    SlicedStep.GetProgress = [&]() { return static_cast<float>(SlicesRun) / SlicesPerStep; };
+    Scheduler.ConfigureTimeSlicing(MoveTemp(SlicedStep), 0.0f, 4);
+
+    Scheduler.Advance(1.0f / 15.0f, false);
+    TestEqual("A due step begins", NumBegun, 1);
+    TestEqual("The first frame runs its share of slices", SlicesRun, 2);
+    TestTrue("Progress is exposed mid-step", FMath::IsNearlyEqual(Scheduler.GetStepProgress(), 0.25f));
+    for (int32 Frame = 0; Frame < 3; Frame++)
+    {
+        Scheduler.Advance(1.0f / 60.0f, false);
+    }
+    TestEqual("The step completes on the last frame", Scheduler.GetStats().NumSteps, 1);
+    TestEqual("No step is in progress after completion", Scheduler.GetStepProgress(), 1.0f);
+
+    return true;
+}
+
+bool FWindTemporalSamplingTest::RunTest(const FString& Parameters)
+{
+    // Two uniform states a tenth of a second apart, the latest published at t = 10 s
+    FWindSnapshot Snapshot;
+    Snapshot.Dimensions = FIntVector(4, 4, 4);
+    Snapshot.CellSpacing = FVector(100.0f);
+    Snapshot.Velocity.Init(FVector(10.0f, 0.0f, 0.0f), 64);
+    Snapshot.SimulationTime = 1.1f;
+    Snapshot.PublishTime = 10.0;
+    Snapshot.PublishInterval = 0.1;
+
+    TestEqual("Without a previous state queries use the latest", Snapshot.GetTemporalAlpha(EWindTemporalSampling::Interpolate, 10.05), 1.0f);
+
+    TRefCountPtr<FWindSnapshot> Previous = new FWindSnapshot();
+    Previous->Dimensions = Snapshot.Dimensions;
+    Previous->CellSpacing = Snapshot.CellSpacing;
+    Previous->Velocity.Init(FVector::ZeroVector, 64);
+    Previous->SimulationTime = 1.0f;
+    Snapshot.SetPrevious(Previous);
+
+    const FVector Probe(150.0f, 150.0f, 150.0f);
+    TestEqual("Latest ignores the previous state", Snapshot.GetTemporalAlpha(EWindTemporalSampling::Latest, 10.05), 1.0f);
+
+    const float Halfway = Snapshot.GetTemporalAlpha(EWindTemporalSampling::Interpolate, 10.05);
+    TestTrue("Interpolation is halfway half a step after publishing", FMath::IsNearlyEqual(Halfway, 0.5f, 0.001f));
+    TestTrue("Interpolated velocity blends the two states", FMath::IsNearlyEqual(Snapshot.SampleBlendedVelocity(Probe, Halfway).X, 5.0, 0.01));
+    TestTrue("Interpolated time blends the two states", FMath::IsNearlyEqual(Snapshot.GetBlendedSimulationTime(Halfway), 1.05f, 0.001f));
+    TestEqual("Interpolation holds the latest state once a step is overdue", Snapshot.GetTemporalAlpha(EWindTemporalSampling::Interpolate, 11.0), 1.0f);
+
+    const float Ahead = Snapshot.GetTemporalAlpha(EWindTemporalSampling::Extrapolate, 10.05);
+    TestTrue("Extrapolation continues the trend", FMath::IsNearlyEqual(Snapshot.SampleBlendedVelocity(Probe, Ahead).X, 15.0, 0.01));
+    TestEqual("Extrapolation stops one step ahead", Snapshot.GetTemporalAlpha(EWindTemporalSampling::Extrapolate, 11.0), 2.0f);
+
+    // Each state is sampled at its own origin, so a recentred grid does not smear the blend
+    Snapshot.Velocity.Init(FVector::ZeroVector, 64);
+    Snapshot.Velocity[Snapshot.GetIndex(1, 1, 1)] = FVector(10.0f, 0.0f, 0.0f);
+    Previous->Velocity = Snapshot.Velocity;
+    Snapshot.Origin = FVector(100.0f, 0.0f, 0.0f);
+    Previous->Origin = FVector::ZeroVector;
+    TestTrue("Previous state is sampled at its own origin", FMath::IsNearlyEqual(Snapshot.SampleBlendedVelocity(FVector(100.0f), 0.0f).X, 10.0, 0.01));
+    TestTrue("Current state is sampled at its own origin", FMath::IsNearlyEqual(Snapshot.SampleBlendedVelocity(FVector(200.0f, 100.0f, 100.0f), 1.0f).X, 10.0, 0.01));
+
+    return true;
+}
+
+bool FWindTileGraphTest::RunTest(const FString& Parameters)
+{
+    // Every cell of a region is visited exactly once, and a stage only starts after the previous one
+    const FIntVector RegionBegin(1, 2, 0);
+    const FIntVector RegionEnd(21, 13, 9);
+    const FIntVector Extent = RegionEnd - RegionBegin;
+    TArray<int32> Visits;
+    TArray<int32> Doubled;
+    Visits.SetNumZeroed(Extent.X * Extent.Y * Extent.Z);
+    Doubled.SetNumZeroed(Visits.Num());
+    auto GetIndex = [&](int32 I, int32 J, int32 K) { return (I - RegionBegin.X) + (J - RegionBegin.Y) * Extent.X + (K - RegionBegin.Z) * Extent.X * Extent.Y; };
+
+    std::atomic<int32> NumTiles(0);
+    bool bSerialSawAllVisits = false;
+    FWindTileGraph Graph(FIntVector(8, 4, 3), 4);
+    Graph.AddTiledStage(RegionBegin, RegionEnd, [&](const FWindTile& Tile)
+    {
+        NumTiles++;
+        for (int32 K = Tile.Begin.Z; K < Tile.End.Z; K++)
+        {
+            for (int32 J = Tile.Begin.Y; J < Tile.End.Y; J++)
+            {
+                for (int32 I = Tile.Begin.X; I < Tile.End.X; I++)
+                {
+                    Visits[GetIndex(I, J, K)]++;
+                }
+            }
+        }
+    });
+    Graph.AddSerialStage([&]()
+    {
+        bSerialSawAllVisits = !Visits.Contains(0);
+    });
+    Graph.AddTiledStage(RegionBegin, RegionEnd, [&](const FWindTile& Tile)
+    {
+        for (int32 K = Tile.Begin.Z; K < Tile.End.Z; K++)
+        {
+            for (int32 J = Tile.Begin.Y; J < Tile.End.Y; J++)
+            {
+                for (int32 I = Tile.Begin.X; I < Tile.End.X; I++)
+                {
+                    Doubled[GetIndex(I, J, K)] = Visits[GetIndex(I, J, K)] * 2;
+                }
+            }
+        }
+    });
+    Graph.AddTiledStage(FIntVector(4), FIntVector(4), [](const FWindTile&) {});
+    TestEqual("Empty regions add no stage", Graph.GetNumStages(), 3);
+    Graph.Execute();
+
+    TestEqual("The region is split into the configured tiles", NumTiles.load(), 3 * 3 * 3);
+    TestTrue("Every cell is visited exactly once", !Visits.ContainsByPredicate([](int32 Count) { return Count != 1; }));
+    TestTrue("A serial stage waits for the stage before it", bSerialSawAllVisits);
+    TestTrue("A tiled stage waits for the stage before it", !Doubled.ContainsByPredicate([](int32 Value) { return Value != 2; }));
+    TestEqual("Executing empties the graph", Graph.GetNumStages(), 0);
+
+    // Tile shape and worker count do not change the solution: the red-black pressure solve never
+    // reads a cell another tile of the same half-sweep writes
+    FWindSolverConfig Config;
+    Config.GridSize = 24;
+    Config.CellSize = 100.0f;
+    Config.TileSize = FIntVector::ZeroValue;
+    Config.MaxTileWorkers = 1;
+
+    TSharedPtr<IWindSolverBackend> SerialSolver = WindSolverBackend::Create(EWindSolverBackend::StableFluids);
+    TSharedPtr<IWindSolverBackend> TiledSolver = WindSolverBackend::Create(EWindSolverBackend::StableFluids);
+    SerialSolver->Initialize(Config);
+    Config.TileSize = FIntVector(8, 8, 8);
+    Config.MaxTileWorkers = 0;
+    TiledSolver->Initialize(Config);
+    for (const TSharedPtr<IWindSolverBackend>& Solver : { SerialSolver, TiledSolver })
+    {
+        Solver->AddVelocity(FVector(1200.0f, 1200.0f, 1200.0f), FVector(300.0f, 0.0f, 50.0f));
+        Solver->AddVelocity(FVector(500.0f, 1700.0f, 900.0f), FVector(0.0f, -150.0f, 0.0f));
+        for (int32 Step = 0; Step < 3; Step++)
+        {
+            Solver->Step(1.0f / 60.0f);
+        }
+    }
+
+    TArray<FVector> SerialVelocity;
+    TArray<FVector> TiledVelocity;
+    SerialSolver->ExportVelocity(SerialVelocity);
+    TiledSolver->ExportVelocity(TiledVelocity);
+
+    double MaxDifference = 0.0;
+    for (int32 i = 0; i < SerialVelocity.Num(); i++)
+    {
+        MaxDifference = FMath::Max(MaxDifference, (SerialVelocity[i] - TiledVelocity[i]).Size());
+    }
+    TestEqual("Tiled and single-tile steps agree exactly", MaxDifference, 0.0);
+
+    return true;
+}
+
+bool FWindInjectionQueueTest::RunTest(const FString& Parameters)
+{
+    // Producers push concurrently with the consumer draining; nothing is lost or reordered
+    // within a producer. X carries the producer and Y its sequence number. Odd producers hand
+    // their injections over in batches.
+    const int32 NumProducers = 8;
+    const int32 PushesPerProducer = 2000;
+    FWindInjectionQueue Queue;
+    TestTrue("A new queue is empty", Queue.IsEmpty());
+
+    TArray<UE::Tasks::FTask> Producers;
+    for (int32 Producer = 0; Producer < NumProducers; Producer++)
+    {
+        Producers.Add(UE::Tasks::Launch(UE_SOURCE_LOCATION, [&Queue, Producer, PushesPerProducer]()
+        {
+            const int32 BatchSize = 100;
+            TArray<FWindInjection> Batch;
+            for (int32 Sequence = 0; Sequence < PushesPerProducer; Sequence++)
+            {
+                if (Producer % 2 == 0)
+                {
+                    Queue.Push(FVector(Producer, Sequence, 0.0f), FVector::OneVector);
+                    continue;
+                }
+
+                Batch.Add({ FVector(Producer, Sequence, 0.0f), FVector::OneVector });
+                if (Batch.Num() == BatchSize)
+                {
+                    Queue.PushBatch(MoveTemp(Batch));
+                    Batch.Reset();
+                }
+            }
+            Queue.PushBatch(MoveTemp(Batch));
+        }));
+    }
+
+    TArray<FWindInjection> Drained;
+    TArray<TSharedPtr<const FWindForcingGrid>> DrainedFields;
+    while (Producers.ContainsByPredicate([](const UE::Tasks::FTask& Task) { return !Task.IsCompleted(); }))
+    {
+        Queue.Drain(Drained, DrainedFields);
+    }
+    UE::Tasks::Wait(Producers);
+    Queue.Drain(Drained, DrainedFields);
+
+    TestEqual("Every push is drained exactly once", Drained.Num(), NumProducers * PushesPerProducer);
+    TestTrue("The queue is empty after draining", Queue.IsEmpty());
+
+    TArray<int32> NextSequence;
+    NextSequence.SetNumZeroed(NumProducers);
+    bool bInOrder = true;
+    for (const FWindInjection& Injection : Drained)
+    {
+        const int32 Producer = static_cast<int32>(Injection.Location.X);
+        bInOrder &= static_cast<int32>(Injection.Location.Y) == NextSequence[Producer]++;
+    }
+    TestTrue("Each producer's pushes come out in order", bInOrder);
+
+    // Injections in the same cell reach the solver as one merged splat at the next step
+    UWorld* TestWorld = CreateTestWorld();
+    UWindSimulationComponent* WindComponent = SetupWindSimulation(TestWorld);
+    if (!TestNotNull("WindComponent is valid", WindComponent))
+    {
+        DestroyTestWorld(TestWorld);
+        return false;
+    }
+
+    const IWindSolverBackend* Solver = WindComponent->GetSolver();
+    const FVector Location(650.0f, 650.0f, 650.0f);
+    const int32 Cell = Solver->GetCellIndex(Location - WindComponent->GetSnapshot()->Origin);
+    TestTrue("The test location is inside the domain", Cell != INDEX_NONE);
+    TestEqual("Positions in the same cell share an index", Solver->GetCellIndex(Location + FVector(20.0f) - WindComponent->GetSnapshot()->Origin), Cell);
+    TestEqual("Positions outside the domain have no cell", Solver->GetCellIndex(FVector(-1000000.0f)), INDEX_NONE);
+
+    const FVector Before = WindComponent->GetWindVelocityAtLocation(Location);
+    WindComponent->AddWindAtLocation(Location, FVector(300.0f, 0.0f, 0.0f));
+    WindComponent->AddWindAtLocation(Location + FVector(20.0f), FVector(300.0f, 0.0f, 0.0f));
+    WindComponent->AddWindAtLocation(FVector(-1000000.0f), FVector(300.0f, 0.0f, 0.0f));
+    TestEqual("Queued wind is not visible before the step", WindComponent->GetWindVelocityAtLocation(Location), Before);
+
+    WindComponent->SimulationStep(WindTestConstants::DEFAULT_SIMULATION_DELTA_TIME);
+    TestTrue("Queued wind is applied by the next step", WindComponent->GetWindVelocityAtLocation(Location).X > Before.X + 1.0f);
+
+    TestWorld->DestroyActor(WindComponent->GetOwner());
+    DestroyTestWorld(TestWorld);
+    return true;
+}
+
 #endif //WITH_DEV_AUTOMATION_TESTS
\ No newline at end of file
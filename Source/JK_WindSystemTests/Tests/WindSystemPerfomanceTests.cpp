@@ -1,11 +1,30 @@
 #include "WindSystemTestCommon.h"
 #include "Misc/Timespan.h"
 #include "HAL/PlatformTime.h"
+#include "WindSolverBackend.h"
+#include "WindZoneMask.h"
+#include "WindSimulationScheduler.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Tasks/Task.h"
+#include "WindQueryView.h"
 
 #if WITH_DEV_AUTOMATION_TESTS
 CSV_DEFINE_CATEGORY(WindSystem, true);
 IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWindSystemLargeScalePerformanceTest, "JK_WindSystem.Performance.1KmCubeUnder2ms", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter | EAutomationTestFlags::HighPriority)
 IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWindSystemStressTest, "JK_WindSystem.Performance.StressTest", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter | EAutomationTestFlags::LowPriority)
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWindSystemSolverBackendComparisonTest, "JK_WindSystem.Performance.SolverBackendComparison", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter | EAutomationTestFlags::LowPriority)
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWindSystemSchedulerJitterTest, "JK_WindSystem.Performance.SchedulerJitter", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter | EAutomationTestFlags::LowPriority)
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWindSystemQueryLatencyTest, "JK_WindSystem.Performance.QueryLatencyUnderLoad", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter | EAutomationTestFlags::LowPriority)
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWindSystemTimeSlicedFrameCostTest, "JK_WindSystem.Performance.TimeSlicedFrameCost", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter | EAutomationTestFlags::LowPriority)
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWindSystemTileShapeTest, "JK_WindSystem.Performance.TileShapes", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter | EAutomationTestFlags::LowPriority)
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWindSystemBatchedQueryTest, "JK_WindSystem.Performance.BatchedQueries", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter | EAutomationTestFlags::LowPriority)
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWindSystemLodQueryTest, "JK_WindSystem.Performance.LodQueries", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter | EAutomationTestFlags::LowPriority)
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWindSystemBoxAverageTest, "JK_WindSystem.Performance.BoxAverage", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter | EAutomationTestFlags::LowPriority)
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWindSystemDerivativeQueryTest, "JK_WindSystem.Performance.DerivativeQueries", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter | EAutomationTestFlags::LowPriority)
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWindSystemStreamlineTest, "JK_WindSystem.Performance.Streamlines", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter | EAutomationTestFlags::LowPriority)
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWindSystemQueryViewTest, "JK_WindSystem.Performance.WorkerThreadQueries", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter | EAutomationTestFlags::LowPriority)
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWindSystemFrozenZoneCostTest, "JK_WindSystem.Performance.FrozenZoneCost", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter | EAutomationTestFlags::LowPriority)
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWindSystemGeneratorScalingTest, "JK_WindSystem.Performance.GeneratorScaling", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter | EAutomationTestFlags::LowPriority)
 struct FTestConfiguration
 {
     int32 GridSize;
@@ -261,4 +280,748 @@ bool FWindSystemLargeScalePerformanceTest::RunTest(const FString& Parameters)
     return true;
 }
 
+bool FWindSystemSolverBackendComparisonTest::RunTest(const FString& Parameters)
+{
+    CSV_SCOPED_TIMING_STAT_EXCLUSIVE(WindSystemSolverBackendComparison);
+
+    // Backends are driven directly, without a world, so only solver cost is measured.
+    // Run with -corelimit=N to compare scaling across core counts.
+    UE_LOG(LogTemp, Log, TEXT("Solver backend comparison on %d task graph workers"), FTaskGraphInterface::Get().GetNumWorkerThreads());
+
+    const EWindSolverBackend Backends[] = { EWindSolverBackend::StableFluids, EWindSolverBackend::LatticeBoltzmann, EWindSolverBackend::Layered };
+    const int32 GridSizes[] = { 32, 64, 128 };
+    const int32 NumIterations = 30;
+
+    for (int32 GridSize : GridSizes)
+    {
+        for (EWindSolverBackend Backend : Backends)
+        {
+            FWindSolverConfig Config;
+            Config.GridSize = GridSize;
+            Config.CellSize = 100.0f;
+
+            TSharedPtr<IWindSolverBackend> Solver = WindSolverBackend::Create(Backend);
+            Solver->Initialize(Config);
+
+            const FIntVector Dimensions = Solver->GetDimensions();
+            const FVector Extent = FVector(Dimensions) * Solver->GetCellSpacing();
+            for (int32 i = 0; i < 100; ++i)
+            {
+                Solver->AddVelocity(FVector(FMath::FRandRange(0.0f, Extent.X), FMath::FRandRange(0.0f, Extent.Y), FMath::FRandRange(0.0f, Extent.Z)), FMath::VRand() * 200.0f);
+            }
+
+            // Warm-up
+            for (int32 i = 0; i < 5; ++i)
+            {
+                Solver->Step(1.0f / 60.0f);
+            }
+
+            double StartTime = FPlatformTime::Seconds();
+            for (int32 i = 0; i < NumIterations; ++i)
+            {
+                Solver->Step(1.0f / 60.0f);
+            }
+            double AverageTime = (FPlatformTime::Seconds() - StartTime) * 1000.0 / NumIterations;
+
+            const FVector Probe = Solver->SampleVelocity(Extent * 0.5f);
+            TestFalse(FString::Printf(TEXT("Backend %s at %d stays finite"), Solver->GetName(), GridSize), Probe.ContainsNaN());
+
+            const int32 NumCells = Dimensions.X * Dimensions.Y * Dimensions.Z;
+            UE_LOG(LogTemp, Log, TEXT("Backend: %s, Grid: %d, Cells: %d, Average Step: %.4f ms, Cells per second: %.2f million"),
+                Solver->GetName(), GridSize, NumCells, AverageTime,
+                NumCells / (AverageTime / 1000.0) / 1000000.0);
+        }
+    }
+
+    return true;
+}
+
+bool FWindSystemSchedulerJitterTest::RunTest(const FString& Parameters)
+{
+    CSV_SCOPED_TIMING_STAT_EXCLUSIVE(WindSystemSchedulerJitter);
+
+    // Each mode steps a small solver at 60 Hz for two seconds of wall time while a fake game thread
+    // runs frames of varying length, so the reported jitter includes frame pacing where it applies
+    const float FixedStep = 1.0f / 60.0f;
+    const double Duration = 2.0;
+    const EWindSchedulerMode Modes[] = { EWindSchedulerMode::GameThread, EWindSchedulerMode::DedicatedThread, EWindSchedulerMode::TaskGraph, EWindSchedulerMode::Pipelined };
+    const TCHAR* ModeNames[] = { TEXT("GameThread"), TEXT("DedicatedThread"), TEXT("TaskGraph"), TEXT("Pipelined") };
+
+    for (int32 ModeIndex = 0; ModeIndex < UE_ARRAY_COUNT(Modes); ModeIndex++)
+    {
+        FWindSolverConfig Config;
+        Config.GridSize = 32;
+        TSharedPtr<IWindSolverBackend> Solver = WindSolverBackend::Create(EWindSolverBackend::StableFluids);
+        Solver->Initialize(Config);
+
+        FWindSimulationScheduler Scheduler;
+        Scheduler.Configure(Modes[ModeIndex], FixedStep, [Solver](float StepTime)
+        {
+            Solver->Step(StepTime);
+        });
+        Scheduler.Start();
+
+        const double StartTime = FPlatformTime::Seconds();
+        double LastFrameTime = StartTime;
+        int32 Frame = 0;
+        while (FPlatformTime::Seconds() - StartTime < Duration)
+        {
+            // Alternate between 8 ms and 24 ms frames
+            FPlatformProcess::Sleep((Frame++ % 2 == 0) ? 0.008f : 0.024f);
+            const double Now = FPlatformTime::Seconds();
+            Scheduler.Advance(static_cast<float>(Now - LastFrameTime), false);
+            LastFrameTime = Now;
+        }
+        Scheduler.Shutdown();
+
+        const FWindSchedulerStats Stats = Scheduler.GetStats();
+        TestTrue(FString::Printf(TEXT("%s mode steps the simulation"), ModeNames[ModeIndex]), Stats.NumSteps > 0);
+        UE_LOG(LogTemp, Log, TEXT("Scheduler: %s, Steps: %d (expected %d), Dropped: %d, Average Step: %.3f ms, Average Interval: %.3f ms, Jitter: %.3f ms, Max Jitter: %.3f ms, Max Game Thread: %.3f ms"),
+            ModeNames[ModeIndex], Stats.NumSteps, FMath::RoundToInt(Duration / FixedStep), Stats.NumDroppedSteps,
+            Stats.AverageStepMs, Stats.AverageIntervalMs, Stats.JitterMs, Stats.MaxJitterMs, Stats.MaxAdvanceMs);
+    }
+
+    return true;
+}
+
+bool FWindSystemQueryLatencyTest::RunTest(const FString& Parameters)
+{
+    CSV_SCOPED_TIMING_STAT_EXCLUSIVE(WindSystemQueryLatency);
+
+    UWorld* TestWorld = CreateTestWorld();
+    UWindSimulationComponent* WindComponent = SetupWindSimulation(TestWorld);
+    const FVector Extent = FVector(WindComponent->GetGridSize() * WindComponent->GetCellSize());
+
+    const int32 NumQueries = 20000;
+    TArray<FVector> QueryLocations;
+    QueryLocations.SetNumUninitialized(NumQueries);
+    for (FVector& Location : QueryLocations)
+    {
+        Location = FVector(FMath::FRandRange(0.0f, Extent.X), FMath::FRandRange(0.0f, Extent.Y), FMath::FRandRange(0.0f, Extent.Z));
+    }
+
+    // Per-query latency in microseconds, sorted, so percentiles can be read off directly
+    auto MeasureQueries = [&]()
+    {
+        TArray<double> Latencies;
+        Latencies.SetNumUninitialized(NumQueries);
+        for (int32 i = 0; i < NumQueries; ++i)
+        {
+            const double StartTime = FPlatformTime::Seconds();
+            WindComponent->GetWindVelocityAtLocation(QueryLocations[i]);
+            Latencies[i] = (FPlatformTime::Seconds() - StartTime) * 1000000.0;
+        }
+        Latencies.Sort();
+        return Latencies;
+    };
+    auto Percentile = [](const TArray<double>& Sorted, double Fraction)
+    {
+        return Sorted[FMath::Min(FMath::FloorToInt32(Sorted.Num() * Fraction), Sorted.Num() - 1)];
+    };
+
+    const TArray<double> IdleLatencies = MeasureQueries();
+
+    // Step the simulation back to back on a worker while the queries run
+    std::atomic<bool> bStopSimulation(false);
+    std::atomic<int32> NumSteps(0);
+    std::atomic<double> TotalStepTime(0.0);
+    UE::Tasks::FTask SimulationTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [&]()
+    {
+        while (!bStopSimulation)
+        {
+            const double StartTime = FPlatformTime::Seconds();
+            WindComponent->SimulationStep(1.0f / 60.0f);
+            TotalStepTime = TotalStepTime + (FPlatformTime::Seconds() - StartTime) * 1000.0;
+            NumSteps++;
+        }
+    });
+
+    const TArray<double> LoadedLatencies = MeasureQueries();
+    bStopSimulation = true;
+    SimulationTask.Wait();
+
+    const double AverageStepMs = NumSteps > 0 ? TotalStepTime / NumSteps : 0.0;
+    UE_LOG(LogTemp, Log, TEXT("Query latency idle: p50 %.3f us, p99 %.3f us, max %.3f us"),
+        Percentile(IdleLatencies, 0.5), Percentile(IdleLatencies, 0.99), IdleLatencies.Last());
+    UE_LOG(LogTemp, Log, TEXT("Query latency under load: p50 %.3f us, p99 %.3f us, max %.3f us over %d steps of %.3f ms"),
+        Percentile(LoadedLatencies, 0.5), Percentile(LoadedLatencies, 0.99), LoadedLatencies.Last(), NumSteps.load(), AverageStepMs);
+
+    // A query that waited on a step would take as long as the step itself
+    if (NumSteps > 0)
+    {
+        TestTrue("p99 query latency is independent of solver cost", Percentile(LoadedLatencies, 0.99) < AverageStepMs * 1000.0 * 0.1);
+    }
+
+    TestWorld->DestroyActor(WindComponent->GetOwner());
+    DestroyTestWorld(TestWorld);
+
+    return true;
+}
+
+bool FWindSystemTimeSlicedFrameCostTest::RunTest(const FString& Parameters)
+{
+    CSV_SCOPED_TIMING_STAT_EXCLUSIVE(WindSystemTimeSlicedFrameCost);
+
+    // Worst game thread frame cost of a 15 Hz simulation at 60 fps, stepped whole versus sliced
+    // over four frames under a 2 ms budget
+    const int32 GridSizes[] = { 32, 64 };
+    const int32 NumFrames = 240;
+    const float FrameTime = 1.0f / 60.0f;
+
+    for (int32 GridSize : GridSizes)
+    {
+        for (EWindSchedulerMode Mode : { EWindSchedulerMode::GameThread, EWindSchedulerMode::TimeSliced })
+        {
+            FWindSolverConfig Config;
+            Config.GridSize = GridSize;
+            TSharedPtr<IWindSolverBackend> Solver = WindSolverBackend::Create(EWindSolverBackend::StableFluids);
+            Solver->Initialize(Config);
+
+            FWindSimulationScheduler Scheduler;
+            Scheduler.Configure(Mode, FrameTime * 4.0f, [Solver](float StepTime)
+            {
+                Solver->Step(StepTime);
+            });
+
+            FWindSlicedStepFunctions SlicedStep;
+            SlicedStep.BeginStep = [Solver](float StepTime) { Solver->BeginStep(StepTime); };
+            SlicedStep.StepSlice = [Solver]() { return Solver->StepSlice(); };
+            SlicedStep.GetProgress = [Solver]() { return Solver->GetStepProgress(); };
+            Scheduler.ConfigureTimeSlicing(MoveTemp(SlicedStep), 2.0f, 4);
+
+            for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+            {
+                Scheduler.Advance(FrameTime, false);
+            }
+
+            const FWindSchedulerStats Stats = Scheduler.GetStats();
+            TestTrue(FString::Printf(TEXT("Grid %d keeps stepping"), GridSize), Stats.NumSteps >= NumFrames / 4 - 1);
+            UE_LOG(LogTemp, Log, TEXT("Grid: %d, %s, Steps: %d, Average Step: %.3f ms, Worst Frame: %.3f ms"),
+                GridSize, Mode == EWindSchedulerMode::TimeSliced ? TEXT("Time sliced") : TEXT("Whole steps"),
+                Stats.NumSteps, Stats.AverageStepMs, Stats.MaxAdvanceMs);
+        }
+    }
+
+    return true;
+}
+
+bool FWindSystemTileShapeTest::RunTest(const FString& Parameters)
+{
+    CSV_SCOPED_TIMING_STAT_EXCLUSIVE(WindSystemTileShapes);
+
+    // A zero tile size spans the domain, so the first shape is a single task per pass and
+    // the rest show what splitting the passes into tiles buys on this machine
+    const FIntVector TileSizes[] = { FIntVector::ZeroValue, FIntVector(0, 0, 1), FIntVector(16, 16, 4), FIntVector(8, 8, 8), FIntVector(32, 8, 4) };
+    const int32 GridSizes[] = { 64, 128 };
+    const int32 NumIterations = 20;
+
+    UE_LOG(LogTemp, Log, TEXT("Tile shape comparison on %d task graph workers"), FTaskGraphInterface::Get().GetNumWorkerThreads());
+
+    for (int32 GridSize : GridSizes)
+    {
+        for (const FIntVector& TileSize : TileSizes)
+        {
+            FWindSolverConfig Config;
+            Config.GridSize = GridSize;
+            Config.CellSize = 100.0f;
+            Config.TileSize = TileSize;
+
+            TSharedPtr<IWindSolverBackend> Solver = WindSolverBackend::Create(EWindSolverBackend::StableFluids);
+            Solver->Initialize(Config);
+
+            const FVector Extent = FVector(Solver->GetDimensions()) * Solver->GetCellSpacing();
+            for (int32 i = 0; i < 100; ++i)
+            {
+                Solver->AddVelocity(FVector(FMath::FRandRange(0.0f, Extent.X), FMath::FRandRange(0.0f, Extent.Y), FMath::FRandRange(0.0f, Extent.Z)), FMath::VRand() * 200.0f);
+            }
+
+            // Warm-up
+            for (int32 i = 0; i < 3; ++i)
+            {
+                Solver->Step(1.0f / 60.0f);
+            }
+
+            double StartTime = FPlatformTime::Seconds();
+            for (int32 i = 0; i < NumIterations; ++i)
+            {
+                Solver->Step(1.0f / 60.0f);
+            }
+            double AverageTime = (FPlatformTime::Seconds() - StartTime) * 1000.0 / NumIterations;
+
+            TestFalse(FString::Printf(TEXT("Tile %s at %d stays finite"), *TileSize.ToString(), GridSize), Solver->SampleVelocity(Extent * 0.5f).ContainsNaN());
+            UE_LOG(LogTemp, Log, TEXT("Grid: %d, Tile: %s, Average Step: %.4f ms"), GridSize, *TileSize.ToString(), AverageTime);
+        }
+    }
+
+    return true;
+}
+
+bool FWindSystemBatchedQueryTest::RunTest(const FString& Parameters)
+{
+    CSV_SCOPED_TIMING_STAT_EXCLUSIVE(WindSystemBatchedQueries);
+
+    UWorld* TestWorld = CreateTestWorld();
+    UWindSimulationComponent* WindComponent = SetupWindSimulation(TestWorld);
+    const FVector Extent = FVector(WindComponent->GetGridSize() * WindComponent->GetCellSize());
+    for (int32 i = 0; i < 100; ++i)
+    {
+        WindComponent->AddWindAtLocation(FVector(FMath::FRandRange(0.0f, Extent.X), FMath::FRandRange(0.0f, Extent.Y), FMath::FRandRange(0.0f, Extent.Z)), FMath::VRand() * 200.0f);
+    }
+    WindComponent->SimulationStep(1.0f / 60.0f);
+
+    // Projectiles, debris and the like: 10k points queried every frame
+    const int32 NumPoints = 10000;
+    const int32 NumIterations = 50;
+    TArray<FVector> Locations;
+    Locations.SetNumUninitialized(NumPoints);
+    for (FVector& Location : Locations)
+    {
+        Location = FVector(FMath::FRandRange(0.0f, Extent.X), FMath::FRandRange(0.0f, Extent.Y), FMath::FRandRange(0.0f, Extent.Z));
+    }
+    TArray<FVector> Velocities;
+    Velocities.SetNumUninitialized(NumPoints);
+
+    double StartTime = FPlatformTime::Seconds();
+    for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+    {
+        for (int32 i = 0; i < NumPoints; ++i)
+        {
+            Velocities[i] = WindComponent->GetWindVelocityAtLocation(Locations[i]);
+        }
+    }
+    const double SingleTime = (FPlatformTime::Seconds() - StartTime) * 1000.0 / NumIterations;
+
+    StartTime = FPlatformTime::Seconds();
+    for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+    {
+        WindComponent->GetWindVelocitiesAtLocations(Locations, Velocities);
+    }
+    const double BatchedTime = (FPlatformTime::Seconds() - StartTime) * 1000.0 / NumIterations;
+
+    const double Speedup = BatchedTime > 0.0 ? SingleTime / BatchedTime : 0.0;
+    UE_LOG(LogTemp, Log, TEXT("%d queries: single %.4f ms, batched %.4f ms (%.1fx, target 10x)"), NumPoints, SingleTime, BatchedTime, Speedup);
+    TestTrue("Batched queries are faster than single queries", BatchedTime < SingleTime);
+
+    TestWorld->DestroyActor(WindComponent->GetOwner());
+    DestroyTestWorld(TestWorld);
+    return true;
+}
+
+bool FWindSystemLodQueryTest::RunTest(const FString& Parameters)
+{
+    CSV_SCOPED_TIMING_STAT_EXCLUSIVE(WindSystemLodQueries);
+
+    UWorld* TestWorld = CreateTestWorld();
+    UWindSimulationComponent* WindComponent = SetupWindSimulation(TestWorld);
+    const FVector Extent = FVector(WindComponent->GetGridSize() * WindComponent->GetCellSize());
+    for (int32 i = 0; i < 100; ++i)
+    {
+        WindComponent->AddWindAtLocation(FVector(FMath::FRandRange(0.0f, Extent.X), FMath::FRandRange(0.0f, Extent.Y), FMath::FRandRange(0.0f, Extent.Z)), FMath::VRand() * 200.0f);
+    }
+    WindComponent->SimulationStep(1.0f / 60.0f);
+
+    // Far foliage and weather effects: 10k points spread over the whole grid, at full resolution
+    // and at footprints of 4 and 16 cells
+    const int32 NumPoints = 10000;
+    const int32 NumIterations = 50;
+    TArray<FVector> Locations;
+    Locations.SetNumUninitialized(NumPoints);
+    for (FVector& Location : Locations)
+    {
+        Location = FVector(FMath::FRandRange(0.0f, Extent.X), FMath::FRandRange(0.0f, Extent.Y), FMath::FRandRange(0.0f, Extent.Z));
+    }
+    TArray<FVector> Velocities;
+    Velocities.SetNumUninitialized(NumPoints);
+
+    const float CellFootprints[] = { 0.0f, 4.0f, 16.0f };
+    double BaselineTime = 0.0;
+    for (float CellFootprint : CellFootprints)
+    {
+        const float Footprint = CellFootprint * WindComponent->GetCellSize();
+        const double StartTime = FPlatformTime::Seconds();
+        for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+        {
+            WindComponent->GetWindVelocitiesAtLocationsLod(Locations, Footprint, Velocities);
+        }
+        const double QueryTime = (FPlatformTime::Seconds() - StartTime) * 1000.0 / NumIterations;
+        if (CellFootprint == 0.0f)
+        {
+            BaselineTime = QueryTime;
+        }
+
+        UE_LOG(LogTemp, Log, TEXT("%d queries at a %.0f cell footprint: %.4f ms (%.2fx full resolution)"), NumPoints, CellFootprint, QueryTime, BaselineTime > 0.0 ? QueryTime / BaselineTime : 0.0);
+    }
+
+    TestWorld->DestroyActor(WindComponent->GetOwner());
+    DestroyTestWorld(TestWorld);
+    return true;
+}
+
+bool FWindSystemBoxAverageTest::RunTest(const FString& Parameters)
+{
+    CSV_SCOPED_TIMING_STAT_EXCLUSIVE(WindSystemBoxAverage);
+
+    UWorld* TestWorld = CreateTestWorld();
+    UWindSimulationComponent* WindComponent = SetupWindSimulation(TestWorld);
+    const FVector Extent = FVector(WindComponent->GetGridSize() * WindComponent->GetCellSize());
+    for (int32 i = 0; i < 100; ++i)
+    {
+        WindComponent->AddWindAtLocation(FVector(FMath::FRandRange(0.0f, Extent.X), FMath::FRandRange(0.0f, Extent.Y), FMath::FRandRange(0.0f, Extent.Z)), FMath::VRand() * 200.0f);
+    }
+    WindComponent->SimulationStep(1.0f / 60.0f);
+
+    // Sails and vehicles: the mean over an 8-cell box, from the summed-volume table against the
+    // 4x4x4 point samples it replaces
+    const int32 NumBoxes = 1000;
+    const FVector BoxSize = FVector(8.0f * WindComponent->GetCellSize());
+    TArray<FBox> Boxes;
+    for (int32 i = 0; i < NumBoxes; ++i)
+    {
+        const FVector Min(FMath::FRandRange(0.0f, Extent.X - BoxSize.X), FMath::FRandRange(0.0f, Extent.Y - BoxSize.Y), FMath::FRandRange(0.0f, Extent.Z - BoxSize.Z));
+        Boxes.Add(FBox(Min, Min + BoxSize));
+    }
+
+    FVector Checksum = FVector::ZeroVector;
+    double StartTime = FPlatformTime::Seconds();
+    for (const FBox& Box : Boxes)
+    {
+        for (int32 Sample = 0; Sample < 64; ++Sample)
+        {
+            const FVector Fraction((Sample % 4 + 0.5f) / 4.0f, (Sample / 4 % 4 + 0.5f) / 4.0f, (Sample / 16 + 0.5f) / 4.0f);
+            Checksum += WindComponent->GetWindVelocityAtLocation(Box.Min + Fraction * BoxSize) / 64.0f;
+        }
+    }
+    const double SampledTime = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+    StartTime = FPlatformTime::Seconds();
+    for (const FBox& Box : Boxes)
+    {
+        Checksum += WindComponent->GetAverageWindInBox(Box);
+    }
+    const double SummedTime = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+    UE_LOG(LogTemp, Log, TEXT("%d box averages: 64 point samples %.4f ms, summed-volume table %.4f ms (checksum %s)"), NumBoxes, SampledTime, SummedTime, *Checksum.ToString());
+    TestTrue("The summed-volume table is faster than point sampling", SummedTime < SampledTime);
+
+    TestWorld->DestroyActor(WindComponent->GetOwner());
+    DestroyTestWorld(TestWorld);
+    return true;
+}
+
+bool FWindSystemDerivativeQueryTest::RunTest(const FString& Parameters)
+{
+    CSV_SCOPED_TIMING_STAT_EXCLUSIVE(WindSystemDerivativeQueries);
+
+    UWorld* TestWorld = CreateTestWorld();
+    UWindSimulationComponent* WindComponent = SetupWindSimulation(TestWorld);
+    const FVector Extent = FVector(WindComponent->GetGridSize() * WindComponent->GetCellSize());
+    for (int32 i = 0; i < 100; ++i)
+    {
+        WindComponent->AddWindAtLocation(FVector(FMath::FRandRange(0.0f, Extent.X), FMath::FRandRange(0.0f, Extent.Y), FMath::FRandRange(0.0f, Extent.Z)), FMath::VRand() * 200.0f);
+    }
+    WindComponent->SimulationStep(1.0f / 60.0f);
+
+    // Shear and vorticity for 10k points: central differences over six extra point queries
+    // against the single stencil query
+    const int32 NumPoints = 10000;
+    TArray<FVector> Locations;
+    Locations.SetNumUninitialized(NumPoints);
+    for (FVector& Location : Locations)
+    {
+        Location = FVector(FMath::FRandRange(0.0f, Extent.X), FMath::FRandRange(0.0f, Extent.Y), FMath::FRandRange(0.0f, Extent.Z));
+    }
+
+    const float Step = 0.5f * WindComponent->GetCellSize();
+    FVector Checksum = FVector::ZeroVector;
+    double StartTime = FPlatformTime::Seconds();
+    for (const FVector& Location : Locations)
+    {
+        Checksum += WindComponent->GetWindVelocityAtLocation(Location);
+        for (int32 Axis = 0; Axis < 3; Axis++)
+        {
+            FVector Delta = FVector::ZeroVector;
+            Delta[Axis] = Step;
+            Checksum += (WindComponent->GetWindVelocityAtLocation(Location + Delta) - WindComponent->GetWindVelocityAtLocation(Location - Delta)) / (2.0f * Step);
+        }
+    }
+    const double DifferencedTime = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+    TArray<FWindVelocityDerivatives> Derivatives;
+    Derivatives.SetNum(NumPoints);
+    StartTime = FPlatformTime::Seconds();
+    WindComponent->GetWindDerivativesAtLocations(Locations, Derivatives);
+    const double StencilTime = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+    UE_LOG(LogTemp, Log, TEXT("%d derivative queries: finite differences %.4f ms, stencil %.4f ms (checksum %s)"), NumPoints, DifferencedTime, StencilTime, *Checksum.ToString());
+    TestTrue("Stencil derivatives are faster than finite differences", StencilTime < DifferencedTime);
+
+    TestWorld->DestroyActor(WindComponent->GetOwner());
+    DestroyTestWorld(TestWorld);
+    return true;
+}
+
+bool FWindSystemStreamlineTest::RunTest(const FString& Parameters)
+{
+    CSV_SCOPED_TIMING_STAT_EXCLUSIVE(WindSystemStreamlines);
+
+    UWorld* TestWorld = CreateTestWorld();
+    UWindSimulationComponent* WindComponent = SetupWindSimulation(TestWorld);
+    const FVector Extent = FVector(WindComponent->GetGridSize() * WindComponent->GetCellSize());
+    for (int32 i = 0; i < 100; ++i)
+    {
+        WindComponent->AddWindAtLocation(FVector(FMath::FRandRange(0.0f, Extent.X), FMath::FRandRange(0.0f, Extent.Y), FMath::FRandRange(0.0f, Extent.Z)), FMath::VRand() * 200.0f);
+    }
+    WindComponent->SimulationStep(1.0f / 60.0f);
+
+    // Debris prediction: 1000 seeds over 3 seconds with RK4, stepped from game code one query at
+    // a time against the batched tracer
+    const int32 NumSeeds = 1000;
+    FWindTraceSettings Settings;
+    Settings.Integrator = EWindTraceIntegrator::RK4;
+    Settings.NumSteps = 30;
+    Settings.StepTime = 0.1f;
+    TArray<FVector> Seeds;
+    for (int32 i = 0; i < NumSeeds; ++i)
+    {
+        Seeds.Add(FVector(FMath::FRandRange(0.0f, Extent.X), FMath::FRandRange(0.0f, Extent.Y), FMath::FRandRange(0.0f, Extent.Z)));
+    }
+
+    FVector Checksum = FVector::ZeroVector;
+    const float Dt = Settings.StepTime;
+    double StartTime = FPlatformTime::Seconds();
+    for (const FVector& Seed : Seeds)
+    {
+        FVector Position = Seed;
+        for (int32 Step = 0; Step < Settings.NumSteps; ++Step)
+        {
+            const FVector K1 = WindComponent->GetWindVelocityAtLocation(Position);
+            const FVector K2 = WindComponent->GetWindVelocityAtLocation(Position + K1 * 0.5f * Dt);
+            const FVector K3 = WindComponent->GetWindVelocityAtLocation(Position + K2 * 0.5f * Dt);
+            const FVector K4 = WindComponent->GetWindVelocityAtLocation(Position + K3 * Dt);
+            Position += (K1 + 2.0f * K2 + 2.0f * K3 + K4) * Dt / 6.0f;
+        }
+        Checksum += Position;
+    }
+    const double QueryTime = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+    TArray<FVector> Points;
+    Points.SetNumUninitialized(NumSeeds * Settings.GetNumPoints());
+    StartTime = FPlatformTime::Seconds();
+    WindComponent->TraceWindStreamlines(Seeds, Settings, Points);
+    const double TracedTime = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+    UE_LOG(LogTemp, Log, TEXT("%d RK4 trajectories of %d steps: point queries %.4f ms, batched tracer %.4f ms (checksum %s)"), NumSeeds, Settings.NumSteps, QueryTime, TracedTime, *Checksum.ToString());
+    TestTrue("The batched tracer is faster than stepping with point queries", TracedTime < QueryTime);
+
+    TestWorld->DestroyActor(WindComponent->GetOwner());
+    DestroyTestWorld(TestWorld);
+    return true;
+}
+
+bool FWindSystemQueryViewTest::RunTest(const FString& Parameters)
+{
+    CSV_SCOPED_TIMING_STAT_EXCLUSIVE(WindSystemWorkerThreadQueries);
+
+    UWorld* TestWorld = CreateTestWorld();
+    UWindSimulationComponent* WindComponent = SetupWindSimulation(TestWorld);
+    const FVector Extent = FVector(WindComponent->GetGridSize() * WindComponent->GetCellSize());
+    for (int32 i = 0; i < 100; ++i)
+    {
+        WindComponent->AddWindAtLocation(FVector(FMath::FRandRange(0.0f, Extent.X), FMath::FRandRange(0.0f, Extent.Y), FMath::FRandRange(0.0f, Extent.Z)), FMath::VRand() * 200.0f);
+    }
+    WindComponent->SimulationStep(1.0f / 60.0f);
+
+    // Physics, animation and audio style consumers: worker tasks issuing single queries on one
+    // view while the game thread keeps stepping the simulation under its lock
+    const int32 NumWorkers = 8;
+    const int32 QueriesPerWorker = 10000;
+    TArray<FVector> Locations;
+    for (int32 i = 0; i < QueriesPerWorker; ++i)
+    {
+        Locations.Add(FVector(FMath::FRandRange(0.0f, Extent.X), FMath::FRandRange(0.0f, Extent.Y), FMath::FRandRange(0.0f, Extent.Z)));
+    }
+
+    const FWindQueryView View = WindComponent->MakeQueryView();
+    TArray<double> WorkerTimes;
+    WorkerTimes.SetNumZeroed(NumWorkers);
+    std::atomic<bool> bAllFinite{ true };
+    TArray<UE::Tasks::FTask> Workers;
+    for (int32 Worker = 0; Worker < NumWorkers; ++Worker)
+    {
+        Workers.Add(UE::Tasks::Launch(UE_SOURCE_LOCATION, [View, &Locations, &WorkerTime = WorkerTimes[Worker], &bAllFinite]()
+        {
+            const double Start = FPlatformTime::Seconds();
+            for (const FVector& Location : Locations)
+            {
+                if (View.GetWindVelocityAtLocation(Location).ContainsNaN())
+                {
+                    bAllFinite = false;
+                }
+            }
+            WorkerTime = (FPlatformTime::Seconds() - Start) * 1000.0;
+        }));
+    }
+
+    int32 NumSteps = 0;
+    while (Workers.ContainsByPredicate([](const UE::Tasks::FTask& Task) { return !Task.IsCompleted(); }))
+    {
+        WindComponent->SimulationStep(1.0f / 60.0f);
+        NumSteps++;
+    }
+    UE::Tasks::Wait(Workers);
+
+    double SlowestWorker = 0.0;
+    for (double WorkerTime : WorkerTimes)
+    {
+        SlowestWorker = FMath::Max(SlowestWorker, WorkerTime);
+    }
+    UE_LOG(LogTemp, Log, TEXT("%d workers x %d view queries alongside %d simulation steps: slowest worker %.4f ms (%.4f us per query)"),
+        NumWorkers, QueriesPerWorker, NumSteps, SlowestWorker, SlowestWorker * 1000.0 / QueriesPerWorker);
+    TestTrue("Worker thread queries return finite wind", bAllFinite.load());
+
+    TestWorld->DestroyActor(WindComponent->GetOwner());
+    DestroyTestWorld(TestWorld);
+    return true;
+}
+
+bool FWindSystemFrozenZoneCostTest::RunTest(const FString& Parameters)
+{
+    CSV_SCOPED_TIMING_STAT_EXCLUSIVE(WindSystemFrozenZoneCost);
+
+    // Step cost with nothing, half and three quarters of the domain frozen, as for large
+    // underground or indoor regions. Cost should fall roughly with the frozen fraction.
+    const EWindSolverBackend Backends[] = { EWindSolverBackend::StableFluids, EWindSolverBackend::LatticeBoltzmann, EWindSolverBackend::Layered };
+    const float FrozenFractions[] = { 0.0f, 0.5f, 0.75f };
+    const int32 NumIterations = 20;
+
+    FWindZoneModifier Freeze;
+    Freeze.VelocityMap = FMatrix(ForceInit);
+    Freeze.bBlocksFlow = true;
+    Freeze.bFreeze = true;
+
+    for (EWindSolverBackend Backend : Backends)
+    {
+        double BaselineTime = 0.0;
+        for (float FrozenFraction : FrozenFractions)
+        {
+            FWindSolverConfig Config;
+            Config.GridSize = 64;
+            Config.CellSize = 100.0f;
+
+            TSharedPtr<IWindSolverBackend> Solver = WindSolverBackend::Create(Backend);
+            Solver->Initialize(Config);
+
+            const FIntVector Dimensions = Solver->GetDimensions();
+            const FVector Spacing = Solver->GetCellSpacing();
+            const FVector Extent = FVector(Dimensions) * Spacing;
+            if (FrozenFraction > 0.0f)
+            {
+                // Frozen from the top down, on whole cells
+                const float FrozenHeight = FMath::RoundToFloat(Dimensions.Z * FrozenFraction) * Spacing.Z;
+                TSharedPtr<FWindZoneMask> Mask = MakeShared<FWindZoneMask>();
+                Mask->Initialize(FVector::ZeroVector, Dimensions, Spacing);
+                Mask->AddZone(FTransform(FVector(Extent.X * 0.5f, Extent.Y * 0.5f, Extent.Z - FrozenHeight * 0.5f)), FVector(Extent.X, Extent.Y, FrozenHeight * 0.5f), Freeze);
+                Mask->Finalize();
+                Solver->SetZoneMask(Mask);
+            }
+
+            for (int32 i = 0; i < 100; ++i)
+            {
+                Solver->AddVelocity(FVector(FMath::FRandRange(0.0f, Extent.X), FMath::FRandRange(0.0f, Extent.Y), FMath::FRandRange(0.0f, Extent.Z)), FMath::VRand() * 200.0f);
+            }
+            for (int32 i = 0; i < 3; ++i)
+            {
+                Solver->Step(1.0f / 60.0f);
+            }
+
+            const double StartTime = FPlatformTime::Seconds();
+            for (int32 i = 0; i < NumIterations; ++i)
+            {
+                Solver->Step(1.0f / 60.0f);
+            }
+            const double AverageTime = (FPlatformTime::Seconds() - StartTime) * 1000.0 / NumIterations;
+            if (FrozenFraction == 0.0f)
+            {
+                BaselineTime = AverageTime;
+            }
+
+            UE_LOG(LogTemp, Log, TEXT("Backend: %s, Frozen: %.0f%%, Average Step: %.4f ms (%.2fx of unfrozen)"),
+                Solver->GetName(), FrozenFraction * 100.0f, AverageTime, BaselineTime > 0.0 ? AverageTime / BaselineTime : 1.0);
+        }
+    }
+
+    return true;
+}
+
+bool FWindSystemGeneratorScalingTest::RunTest(const FString& Parameters)
+{
+    CSV_SCOPED_TIMING_STAT_EXCLUSIVE(WindSystemGeneratorScaling);
+    UWindSystemSettings* WindSettings = GetMutableDefault<UWindSystemSettings>();
+    const int32 OriginalWorkers = WindSettings->GeneratorWorkers;
+
+    // The same 200 sources, all due every tick, evaluated on one worker and then on all of them.
+    // Only the tick time changes; the forcing is reduced in a fixed order either way.
+    const int32 NumWindSources = 200;
+    const int32 NumIterations = 30;
+    const int32 WorkerCounts[] = { 1, 0 };
+    const FVector ProbeLocation(1600.0f, 1600.0f, 1600.0f);
+
+    double AverageTimes[UE_ARRAY_COUNT(WorkerCounts)] = {};
+    FVector ProbeVelocities[UE_ARRAY_COUNT(WorkerCounts)];
+
+    for (int32 Run = 0; Run < UE_ARRAY_COUNT(WorkerCounts); Run++)
+    {
+        WindSettings->GeneratorWorkers = WorkerCounts[Run];
+
+        UWorld* TestWorld = CreateTestWorld();
+        UWindSimulationSubsystem* WindSubsystem = TestWorld->GetSubsystem<UWindSimulationSubsystem>();
+        if (!TestNotNull("Wind Subsystem exists", WindSubsystem))
+        {
+            DestroyTestWorld(TestWorld);
+            break;
+        }
+
+        FRandomStream Random(1234);
+        TArray<UWindGeneratorComponent*> WindSources;
+        for (int32 i = 0; i < NumWindSources; ++i)
+        {
+            const FVector Location(Random.FRandRange(0.0f, 3200.0f), Random.FRandRange(0.0f, 3200.0f), Random.FRandRange(0.0f, 3200.0f));
+            UPointWindGeneratorComponent* WindSource = CreatePointWindGenerator(TestWorld, Location, 50.0f, 400.0f);
+            WindSource->UpdateFrequency = 0.0f;
+            WindSubsystem->RegisterWindGenerator(WindSource);
+            WindSources.Add(WindSource);
+        }
+
+        // Warm-up, which also publishes the first snapshot the generators rasterize against
+        for (int32 i = 0; i < 3; ++i)
+        {
+            WindSubsystem->Tick(1.0f / 60.0f);
+        }
+
+        const double StartTime = FPlatformTime::Seconds();
+        for (int32 i = 0; i < NumIterations; ++i)
+        {
+            WindSubsystem->Tick(1.0f / 60.0f);
+        }
+        AverageTimes[Run] = (FPlatformTime::Seconds() - StartTime) * 1000.0 / NumIterations;
+        ProbeVelocities[Run] = WindSubsystem->GetWindVelocityAtLocation(ProbeLocation);
+
+        for (UWindGeneratorComponent* WindSource : WindSources)
+        {
+            WindSubsystem->UnregisterWindGenerator(WindSource);
+            TestWorld->DestroyActor(WindSource->GetOwner());
+        }
+        DestroyTestWorld(TestWorld);
+    }
+
+    WindSettings->GeneratorWorkers = OriginalWorkers;
+
+    TestTrue("Parallel evaluation gives the same wind as serial", ProbeVelocities[1].Equals(ProbeVelocities[0], 0.01f));
+    UE_LOG(LogTemp, Log, TEXT("%d generators on %d task graph workers: serial %.4f ms, parallel %.4f ms per tick (%.2fx)"),
+        NumWindSources, FTaskGraphInterface::Get().GetNumWorkerThreads(), AverageTimes[0], AverageTimes[1],
+        AverageTimes[1] > 0.0 ? AverageTimes[0] / AverageTimes[1] : 0.0);
+
+    return true;
+}
+
 #endif //WITH_DEV_AUTOMATION_TESTS
\ No newline at end of file